@@ -6,7 +6,8 @@
 ##   configure script to copy appropriate Makefile.$osname                     ##
 ##                                                                             ##
 ##   Usage: configure.sh [-h] [-v] [-l] [-prefix dir] [-debug] [-check]        ##
-##                       [-nompi] [-noerror] [-Dmacro[=value] ...]             ##
+##                       [-nompi] [-openmp] [-pthread] [-zlib] [-noerror]      ##
+##                       [-Dmacro[=value] ...]                                 ##
 ##                                                                             ##
 ## (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file ##
 ## authors, and contributors see AUTHORS file                                  ##
@@ -15,9 +16,12 @@
 ## Contact: https://github.com/PIK-LPJmL/LPJmL                                 ##
 #################################################################################
 
-USAGE="Usage: $0 [-h] [-v] [-l] [-prefix dir] [-debug] [-nompi] [-check] [-noerror] [-Dmacro[=value] ...]"
+USAGE="Usage: $0 [-h] [-v] [-l] [-prefix dir] [-debug] [-nompi] [-openmp] [-pthread] [-zlib] [-check] [-noerror] [-Dmacro[=value] ...]"
 debug=0
 nompi=0
+openmp=""
+pthread=""
+zlib=0
 prefix=$PWD
 macro=""
 warning="-Werror"
@@ -37,6 +41,9 @@ while(( "$#" )); do
       echo "-check          set debug flags, enable pointer checking and disable optimization"
       echo "-noerror        do not stop compilation on warnings"
       echo "-nompi          do not build MPI version"
+      echo "-openmp         enable OpenMP threads for the cell loops"
+      echo "-pthread        enable prefetch of climate data in separate thread"
+      echo "-zlib           enable compression of raw and clm output with zlib"
       echo "-Dmacro[=value] define macro for compilation"
       echo
       echo After successfull completion of $0 LPJmL can be compiled by make all
@@ -79,6 +86,19 @@ while(( "$#" )); do
       nompi=1
       shift 1
       ;;
+    -openmp)
+      openmp="-fopenmp -DUSE_OPENMP"
+      shift 1
+      ;;
+    -pthread)
+      pthread="-pthread -DUSE_PTHREAD"
+      shift 1
+      ;;
+    -zlib)
+      zlib=1
+      macro="$macro -DUSE_ZLIB"
+      shift 1
+      ;;
     -D*)
       macro="$macro $1"
       shift 1
@@ -224,15 +244,19 @@ else
 fi
 if [ "$debug" = "1" ]
 then
-  echo "CFLAGS	= \$(WFLAG) \$(LPJFLAGS) $macro $warning \$(DEBUGFLAGS)" >>Makefile.inc
-  echo "LNOPTS	= \$(WFLAG) \$(DEBUGFLAGS) -o " >>Makefile.inc
+  echo "CFLAGS	= \$(WFLAG) \$(LPJFLAGS) $openmp $pthread $macro $warning \$(DEBUGFLAGS)" >>Makefile.inc
+  echo "LNOPTS	= \$(WFLAG) $openmp $pthread \$(DEBUGFLAGS) -o " >>Makefile.inc
 elif [ "$debug" = "2" ]
 then
-  echo "CFLAGS	= \$(WFLAG) \$(LPJFLAGS) $macro $warning \$(CHECKFLAGS)" >>Makefile.inc
-  echo "LNOPTS	= \$(WFLAG) \$(CHECKFLAGS) -o " >>Makefile.inc
+  echo "CFLAGS	= \$(WFLAG) \$(LPJFLAGS) $openmp $pthread $macro $warning \$(CHECKFLAGS)" >>Makefile.inc
+  echo "LNOPTS	= \$(WFLAG) $openmp $pthread \$(CHECKFLAGS) -o " >>Makefile.inc
 else
-  echo "CFLAGS	= \$(WFLAG) \$(LPJFLAGS) $macro $warning \$(OPTFLAGS)" >>Makefile.inc
-  echo "LNOPTS	= \$(WFLAG) \$(OPTFLAGS) -o " >>Makefile.inc
+  echo "CFLAGS	= \$(WFLAG) \$(LPJFLAGS) $openmp $pthread $macro $warning \$(OPTFLAGS)" >>Makefile.inc
+  echo "LNOPTS	= \$(WFLAG) $openmp $pthread \$(OPTFLAGS) -o " >>Makefile.inc
+fi
+if [ "$zlib" = "1" ]
+then
+  echo "LIBS	+= -lz" >>Makefile.inc
 fi
 echo LPJROOT	= $prefix >>Makefile.inc
 cat >bin/lpj_paths.sh <<EOF
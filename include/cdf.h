@@ -82,6 +82,8 @@ typedef struct
   Bool ready;       /**< data was already averaged */
   Bool swap;        /**< byte order has to be changed (TRUE/FALSE) */
   FILE *file;       /**< file pointer */
+  void *map;        /**< file mapped into memory or NULL */
+  size_t map_len;   /**< length of mapped file in bytes */
   int fmt;          /**< file format (RAW/CLM/CDF) */
   int id;           /**< id for sockets */
   int version;      /**< file version number */
@@ -96,6 +98,10 @@ typedef struct
 #if defined(USE_NETCDF) || defined(USE_NETCDF4)
   int ncid;         /**< id of NetCDF file to read */
   int varid;        /**< NetCDF id of variable to read */
+  Bool isdistributed; /**< each task reads its part of the data (TRUE/FALSE) */
+  size_t *index;    /**< index of cells in data read or NULL */
+  size_t slab_offsets[2]; /**< lat/lon offsets of data read */
+  size_t slab_counts[2];  /**< lat/lon size of data read */
   Bool isleap;      /**< leap days in file (TRUE/FALSE) */
   Bool is360;       /**< lon coordinates are in [0,360] (TRUE/FALSE) */
   size_t nlon,nlat; /**< dimensions of longitude/latitude */
@@ -157,12 +163,13 @@ extern Bool openfile_netcdf(Climatefile *,const Filename *,
                             const char *,const Config *);
 extern Bool opendata_netcdf(Climatefile *,const Filename *,
                      const char *,const Config *);
-extern Bool readdata_netcdf(const Climatefile *,Real *,const Cell *,
+extern Bool readdata_netcdf(Climatefile *,Real *,const Cell *,
                             int,const Config *);
-extern Bool readintdata_netcdf(const Climatefile *,int *,const Cell *,
+extern Bool readintdata_netcdf(Climatefile *,int *,const Cell *,
                                int,const Config *);
-extern Bool readshortdata_netcdf(const Climatefile *,short *,const Cell *,
+extern Bool readshortdata_netcdf(Climatefile *,short *,const Cell *,
                                  int,const Config *);
+extern Bool initindex_netcdf(Climatefile *,const Cell *,const Config *);
 extern Coord_netcdf opencoord_netcdf(const char *,const char *,Bool);
 extern const double *getlon_netcdf(Coord_netcdf,int *);
 extern const double *getlat_netcdf(Coord_netcdf,int *);
@@ -125,6 +125,11 @@ Received 19 November 1997; accepted 15 January 1999*/
   const Real *landcover;    /**< prescribed landcover or NULL */
   Balance balance;          /**< balance checks */
   Seed seed;                /**< seed for random generator */
+  double cost;              /**< wall clock time spent in cell (sec) */
+  Bool isconverged;         /**< cell converged in spinup and is not simulated (TRUE/FALSE) */
+  Real arunoff;             /**< annual sum of daily runoff, routed if cell is converged in spinup (mm) */
+  int mask;                 /**< region in aggregation mask or -1 */
+  Stocks *spinup_stocks;    /**< carbon and nitrogen stocks of last years of spinup */
 #if defined IMAGE && defined COUPLED
   Real npp_nat;             /**< NPP natural stand */
   Real npp_wp;              /**< NPP woodplantation */
@@ -149,6 +154,8 @@ extern void update_annual(Cell *,int,int,
 extern void update_monthly(Cell *,Real,Real,int,const Config *);
 extern void init_annual(Cell *,int,const Config *);
 extern int fwritecell(FILE *,long long [],const Cell [],int,int,int,Bool,const Config *);
+extern char *serializecells(size_t *,long long [],const Cell [],int,int,int,Bool,
+                            const Config *);
 extern void fprintcell(FILE *,const Cell [],int,int,int,const Config *);
 extern Bool freadcell(FILE *,Cell *,int,int,const Soilpar *,
                       const Standtype [],int,Bool,Config *);
@@ -170,6 +177,9 @@ extern void drain(Cell [],int,const Config *);
 extern Real nep_sum(const Cell [],const Config *);
 extern Real cflux_sum(const Cell [],const Config *);
 extern Real flux_sum(Flux *,Cell [],const Config *);
+extern Bool initconvergence(Cell [],const Config *);
+extern int checkconvergence(Cell [],int,const Config *);
+extern void freeconvergence(Cell [],double,const Config *);
 extern Bool getwateruse(Wateruse, Cell [],int,const Config *);
 extern Wateruse initwateruse(const Filename *,const Config *);
 #ifdef IMAGE
@@ -180,6 +190,9 @@ extern void killstand(Cell *,int,Bool,Bool,int,int,const Config *);
 extern Bool initsoiltemp(Climate *, Cell*,const Config *);
 extern Celldata opencelldata(Config *);
 extern Bool seekcelldata(Celldata,int);
+#ifdef USE_MPI
+extern Bool readslicecelldata(Celldata,const Config *,MPI_Comm);
+#endif
 extern Bool readcelldata(Celldata,Cell *,unsigned int *,int,Config *);
 extern void closecelldata(Celldata,const Config *);
 extern Real albedo(Cell *, Real , Real );
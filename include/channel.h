@@ -38,6 +38,12 @@ typedef struct
   Bool swap;      /* Byte order has to be changed */
 } Socket; 
 
+typedef struct
+{
+  const void *data; /* pointer to data */
+  int size;         /* size of data (bytes) */
+} Sockbuffer;
+
 /* Declarations of functions */
 
 extern Socket *open_socket(int,int);
@@ -45,6 +51,7 @@ extern Socket *opentdt_socket(int,int);
 extern Socket *connect_socket(const char *,int,int);
 extern Socket *connecttdt_socket(const char *,int);
 extern Bool write_socket(Socket *,const void *,int);
+extern Bool writevec_socket(Socket *,const Sockbuffer [],int);
 extern Bool read_socket(Socket *,void *,int);
 extern Bool readdouble_socket(Socket *,double *,int);
 extern Bool readfloat_socket(Socket *,float *,int);
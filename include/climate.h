@@ -41,6 +41,21 @@ typedef struct
   Real *nh4deposition; /**< dry and wet N deposition (gN m-2) */
 } Climatedata;
 
+typedef struct
+{
+  Type datatype;  /**< datatype of stored values (LPJ_SHORT/LPJ_FLOAT/LPJ_DOUBLE) */
+  Real slope;     /**< slope to convert stored values */
+  Real intercept; /**< intercept to convert stored values */
+  long long n;    /**< number of values for each year */
+  void *data;     /**< stored values of all years or NULL */
+} Climstore;
+
+typedef struct
+{
+  Climstore temp,prec,sun,wet,wind,tamp,tmax,humid,tmin;
+  Climstore lwnet,swdown,burntarea;
+} Climatestore; /**< climate data stored for spin-up */
+
 typedef struct Dailyclimate
 {
   Real temp;       /**< temperature (deg C) */
@@ -83,6 +98,21 @@ typedef struct
   Climatedata data; /**< climate data arrays */
 } Climate;
 
+typedef struct
+{
+  Bool isenabled;   /**< prefetch of climate data enabled */
+  Bool isrunning;   /**< read of next year is in progress */
+  Bool rc;          /**< return code of read */
+  int year;         /**< year of climate data prefetched */
+  Climate *climate; /**< pointer to climate data */
+  const Cell *grid; /**< LPJ grid */
+  Climatedata data; /**< buffers for prefetched climate data */
+  Config config;    /**< copy of LPJ configuration with own communicator */
+#ifdef USE_PTHREAD
+  pthread_t thread; /**< thread reading climate data */
+#endif
+} Prefetch;
+
 /* Definitions of macros */
 
 #define getcelltemp(climate,cell) climate->data.temp+(cell)*NMONTH
@@ -107,14 +137,21 @@ typedef struct
 
 extern Climate *initclimate(const Cell *,Config *);
 extern Bool getclimate(Climate *,const Cell *,int,const Config *);
+extern Bool getclimatedata(Climate *,Climatedata *,const Cell *,int,
+                           const Config *);
+extern Bool initprefetch(Prefetch *,Climate *,const Config *);
+extern Bool prefetchclimate(Prefetch *,const Cell *,int);
+extern Bool waitprefetch(Prefetch *);
+extern void freeprefetch(Prefetch *);
 extern Bool getco2(const Climate *,Real *,int,const Config *);
 extern Bool getdeposition(Climate *,const Cell *,int,Config *);
 extern void freeclimate(Climate *,Bool);
-extern Bool storeclimate(Climatedata *,Climate *,const Cell *,int,int,
+extern Bool storeclimate(Climatestore *,Climate *,const Cell *,int,int,
                          const Config *);
+extern void freeclimatestore(Climatestore *);
 extern void freeclimatedata(Climatedata *);
-extern void restoreclimate(Climate *,const Climatedata *,int);
-extern void moveclimate(Climate *,const Climatedata *,int);
+extern void restoreclimate(Climate *,const Climatestore *,int);
+extern void moveclimate(Climate *,const Climatestore *,int);
 extern void prdaily(Real [],int,Real,Real,Seed);
 extern void dailyclimate(Dailyclimate *,const Climate *,Climbuf *,
                          int,int,int,int);
@@ -29,6 +29,12 @@
 #define NO_FIXED_SDATE 0
 #define FIXED_SDATE 1
 #define PRESCRIBED_SDATE 2
+#define EQUAL_PARTITION 0
+#define COST_PARTITION 1
+#define BASIN_PARTITION 2
+#define NO_CHECK 0
+#define CHECK_ONCE 1
+#define CHECK_ALWAYS 2
 #define NO_FIXED_SOILPAR 0
 #define FIXED_SOILPAR 1
 #define PRESCRIBED_SOILPAR 2
@@ -48,6 +54,9 @@
 #define NO_TILLAGE 0
 #define TILLAGE 1
 #define READ_TILLAGE 2
+#define NO_AGGREGATION 0
+#define COUNTRY_AGGREGATION 1
+#define MASK_AGGREGATION 2
 #define NO_RESIDUE_REMOVE 0
 #define FIXED_RESIDUE_REMOVE 1
 #define READ_RESIDUE_DATA 2
@@ -22,6 +22,7 @@ typedef struct
   Filename filename; /**< Filename of output file */
   int id;
   Bool oneyear;
+  int aggregate;     /**< output aggregated over regions (NO_AGGREGATION, COUNTRY_AGGREGATION, MASK_AGGREGATION) */
 } Outputvar;
 
 typedef struct
@@ -70,6 +71,7 @@ struct config
   Filename soilph_filename;
   Filename river_filename;
   Filename countrycode_filename;
+  Filename aggregate_mask_filename; /**< region mask for aggregated output or NULL */
   Filename landuse_filename;
   Filename fertilizer_nr_filename;
   Filename no3deposition_filename;
@@ -86,6 +88,7 @@ struct config
   Filename crop_phu_filename;
   Filename burntarea_filename;
   Filename landcover_filename;
+  Filename cellcost_filename;
 #ifdef IMAGE
   Filename aquifer_filename;
   Filename wateruse_wd_filename;
@@ -123,6 +126,7 @@ struct config
   int nsoil;              /**< number of soil types */
   Soilpar *soilpar;       /**< Soil parameter array */
   int ncountries;         /**< number of countries */
+  int nmask;              /**< number of regions in aggregation mask */
   Countrypar *countrypar; /**< country parameter array */
   Outputvar *outputvars;
   char *compress_cmd;    /**< command for compressing output files */
@@ -133,6 +137,10 @@ struct config
   Real laimax;        /**< maximum LAI for benchmark */
   Bool withdailyoutput; /**< with daily output (TRUE/FALSE) */
   Bool flush_output;   /**< flush output after every simulation year (TRUE/FALSE) */
+  Bool parallel_output; /**< RAW/CLM output written in parallel by all tasks using MPI-IO (TRUE/FALSE) */
+  Bool async_output;   /**< RAW/CLM output written in separate thread (TRUE/FALSE) */
+  int compress_binary; /**< compression level of RAW/CLM output (0: no compression) */
+  Bool shuffle_binary; /**< byte shuffle of compressed RAW/CLM output (TRUE/FALSE) */
   Bool nofill;          /**< do not fille NetCDF files at creation (TRUE/FALSE) */
   int fdi;
   char *pft_index;
@@ -160,6 +168,9 @@ struct config
   Bool grassonly;               /**< set all cropland including others to zero but keep managed grasslands */
   Bool luc_timber;              /***< land-use change timber */
   Bool storeclimate;           /**< store climate data in spin-up phase */
+  Bool distribute_netcdf_input; /**< each task reads its part of NetCDF climate data */
+  Bool prefetch_climate;       /**< read climate data of next year in separate thread */
+  int check_netcdf_input;       /**< check NetCDF input for missing values (NO_CHECK, CHECK_ONCE, CHECK_ALWAYS) */
   Bool shuffle_spinup_climate;  /**< shuffle spinup climate */
   Bool fix_climate;             /**< fix climate after specified year */
   int fix_climate_year;         /**< year at which climate is fixed */
@@ -202,9 +213,13 @@ struct config
   int ntypes;    /**< number of PFT classes */
   int ngridcell; /**< number of grid cells */
   int startgrid; /**< index of first local grid cell */
+  int *cellcounts; /**< number of grid cells of each task */
+  int *celloffsets; /**< index of first grid cell of each task relative to firstgrid */
   int firstgrid; /**< index of first grid cell */
   int nspinup;   /**< number of spinup years */
   int nspinyear; /**< cycle length during spinup (yr) */
+  Real spinup_tolerance; /**< relative change of stocks for convergence in spinup, 0: disabled */
+  int spinup_window; /**< length of window for convergence check in spinup (yr) */
   int lastyear;  /**< last simulation year (AD) */
   int firstyear; /**< first simulation year (AD) */
   int outputyear; /**< first year for output (AD) */
@@ -216,6 +231,11 @@ struct config
   int nall;      /**< total number of grid cells */
   int rank;      /**< my rank */
   int ntask;     /**< number of parallel tasks */
+  int nthreads;  /**< number of threads per task */
+  int partition; /**< distribution of cells on tasks (EQUAL_PARTITION, COST_PARTITION, BASIN_PARTITION) */
+  char *write_cellcost_filename; /**< filename of cell cost file written or NULL */
+  char *timing_filename; /**< filename of JSON file for phase timers or NULL */
+  Bool print_timing;     /**< print phase timers of each year */
   int count;     /**< number of grid cells with valid soilcode */
   int fire;      /**< fire disturbance enabled */
   int seed_start;      /**< initial seed for random number generator */
@@ -239,6 +259,11 @@ struct config
   int crop_phu_option;    /**< crop phu option (old LPJmL4, semistatic internally computed, prescribed  */
   Bool initsoiltemp;
   Pnet *route;         /**< river routing network */
+  Pnet *route_sub;     /**< river routing network for outflows of all sub-steps */
+  struct routeorder *routeorder; /**< order of cells for river routing or NULL */
+  Bool ordered_routing; /**< cells are routed from upstream to downstream */
+  Real *tfunct;        /**< transfer functions of all cells padded to multiple of QUEUE_BLOCK */
+  Real *queuedata;     /**< delay queues of all cells */
   Pnet *irrig_neighbour; /**< irrigation neighbour network */
   Pnet *irrig_back;      /**< back irrigation network */
   Pnet *irrig_res;
@@ -285,9 +310,14 @@ struct config
   int coupler_port;       /**< port number for in- and outgoing data */
   int coupler_out;        /**< number of outgoing data streams */
   int coupler_in;         /**< number of ingoing data streams */
+  int coupler_version;    /**< protocol version used with coupled model */
+  int shm_size;           /**< size of shared memory for coupler (MB), 0: disabled */
+  struct shmcoupler *shm; /**< shared memory for coupler or NULL */
+  Bool coupler_batch;     /**< send outputs of one time step in one frame (TRUE/FALSE) */
   int totalsize;          /**< size of shared output storage */
   int outputmap[NOUT];    /**< index into output storage */
   int outputsize[NOUT];   /**< number of bands for each output */
+  Bool outputused[NOUT];  /**< output is written or sent (TRUE/FALSE) */
 }; /* LPJ configuration */
 
 typedef struct
@@ -303,6 +333,7 @@ extern char *grazing_type[];
 
 #ifdef USE_MPI
 extern void initmpiconfig(Config *,MPI_Comm);
+extern LPJfile *bcastconfig(LPJfile *,const Config *);
 #endif
 extern void initconfig(Config *);
 extern FILE* openconfig(Config *,int *,char***,const char*);
@@ -325,6 +356,7 @@ extern void fprintfiles(FILE *,Bool,Bool,const Config *);
 extern Bool getextension(Extension *,const Config *);
 extern void fprintincludes(FILE *,const char *,int,char **);
 extern size_t getsize(int,const Config *);
+extern int outputncell(int,const Config *);
 extern int *fscanlandcovermap(LPJfile *,int *,const char *,int,const Config *);
 extern void createconfig(const Config *);
 extern void closeconfig(LPJfile *);
@@ -37,6 +37,9 @@ typedef struct coordfile *Coordfile;
 /* Declaration of functions */
 
 extern Coordfile opencoord(const Filename *,Bool);
+#ifdef USE_MPI
+extern Bool readslicecoord(Coordfile,int,MPI_Comm);
+#endif
 extern Bool readintcoord(FILE *,Intcoord *,Bool);
 extern int seekcoord(Coordfile,int);
 extern Bool readcoord(Coordfile,Coord *,const Coord *);
@@ -19,9 +19,14 @@
 
 /* Definition of constants */
 
-#define COUPLER_VERSION 3                /* Protocol version */
+#define COUPLER_VERSION 5                /* Maximum protocol version */
+#define COUPLER_VERSION_MIN 3            /* Minimum protocol version, default without shared memory and batch */
+#define COUPLER_VERSION_SHM 5            /* Protocol version for PUT_SHM and PUT_DATA_BATCH */
+#define LPJCOUPLERVERSION "LPJCOUPLERVERSION" /* Protocol version sent to coupled model */
 #define LPJCOUPLEDHOST "LPJCOUPLEDHOST"  /* Environment variable for coupled host */
 #define LPJWAIT "LPJWAIT"                /* Time to wait for connection */
+#define LPJCOUPLERSHM "LPJCOUPLERSHM"    /* Size of shared memory for coupler (MB) */
+#define LPJCOUPLERBATCH "LPJCOUPLERBATCH" /* Send outputs of one time step in one frame */
 #define DEFAULT_COUPLED_HOST "localhost" /* Default host for coupled model */
 #define DEFAULT_COUPLER_PORT 2224        /* Default port for in and outgoing connection */
 #define DEFAULT_WAIT 0                   /* Default time to wait for connection */
@@ -40,16 +45,65 @@ typedef enum
   END_DATA,      /* Ending communication */
   GET_STATUS,    /* Check status of coupled model */
   FAIL_DATA,     /* Ending communication on error */
-  PUT_INIT_DATA  /* Send init data to coupled model */
+  PUT_INIT_DATA, /* Send init data to coupled model */
+  PUT_SHM,       /* Send name of shared memory segment to coupled model */
+  PUT_DATA_BATCH /* Sending data of several outputs to coupled model */
 } Token;
 
+/*
+ * LPJmL sends its protocol version at connection. Without environment
+ * variable LPJCOUPLERVERSION version COUPLER_VERSION_MIN is sent, or
+ * COUPLER_VERSION_SHM if shared memory or batched output is enabled.
+ * Coupled models of version 4 and later confirm the version sent, version 3
+ * models do not reply. Version 4 adds the step to PUT_DATA, the status
+ * replies to GET_DATA, the number of cells to GET_DATA_SIZE and
+ * PUT_DATA_SIZE, the error code after FAIL_DATA and the PUT_INIT_DATA
+ * token. PUT_SHM and PUT_DATA_BATCH are only sent for version
+ * COUPLER_VERSION_SHM and later.
+ *
+ * If batched output is enabled, all float outputs written for the same
+ * time step are sent in one frame after the PUT_DATA_BATCH token with the
+ * number of outputs n as index:
+ *
+ *   int year
+ *   int step
+ *   int id[n]          index of output streams
+ *   int size[n]        number of float values of each output
+ *   float data[]       data of all outputs, each ordered by band and cell
+ */
+
+/*
+ * If shared memory is enabled, the coupled model writes the data requested
+ * by GET_DATA into the data area of the shared memory segment and sends the
+ * offset in bytes of the data instead of the data itself. LPJmL sets tail
+ * to the end of the data after all tasks have read their part.
+ */
+
+typedef struct
+{
+  int version;       /**< coupler version */
+  int size;          /**< size of data area (bytes) */
+  volatile int tail; /**< end of data read by LPJmL (bytes) */
+} Shmheader;
+
+#define SHM_HEADER_SIZE 64 /* size of header, data area starts after header */
+
+typedef struct shmcoupler
+{
+  char name[32];      /**< name of shared memory object */
+  Shmheader *header;  /**< pointer to mapped segment */
+  char *data;         /**< data area of segment */
+  size_t size;        /**< size of segment (bytes) */
+  int tail;           /**< end of data received last (bytes) */
+} Shmcoupler;
+
 
 extern char *token_names[];
 
 /* Declaration of functions */
 
 extern Bool open_coupler(Config *);
-extern Socket *connect_coupler(int,int);
+extern Socket *connect_coupler(int,int,int *);
 extern int check_coupler(Config *);
 extern void close_coupler(Bool,const Config *);
 extern Bool receive_coupler(int,void *,Type,int,int,const Config *);
@@ -59,10 +113,14 @@ extern Bool send_scalar_coupler(int,const void *,Type,int,int,const Config *);
 extern Bool receive_real_scalar_coupler(int,Real *,int,int,const Config *);
 extern Bool send_real_scalar_coupler(int,const Real *,int,Real,int,const Config *);
 extern Bool send_token_coupler(Token,int,const Config *);
-extern Bool receive_token_coupler(Socket *,Token *,int *);
+extern Bool receive_token_coupler(Socket *,Token *,int *,int);
 extern Bool openinput_coupler(int,Type,int,int *,const Config *);
 extern Bool openoutput_coupler(int,int,int,int,Type,const Config *);
 extern void send_output_coupler(int,int,int,const Config *);
+extern Bool openshm_coupler(Config *);
+extern const void *receiveshm_coupler(int,Type,int,int,const Config *);
+extern void releaseshm_coupler(const Config *);
+extern void closeshm_coupler(const Config *);
 
 /* Definitions of macros */
 
@@ -71,6 +71,18 @@ typedef struct
   int next;               /**< index to outflow cell */
 } Discharge;
 
+typedef struct routeorder
+{
+  int nround;     /**< number of rounds separated by data exchange */
+  int ngroup;     /**< number of groups of independent cells */
+  int *roundstart; /**< index of first group of each round */
+  int *start;     /**< index of first cell of each group in order */
+  int *order;     /**< local cells sorted from upstream to downstream */
+  int *instart;   /**< index of first inflow of each cell in inindex */
+  int *inindex;   /**< index of inflow in input buffer or -(cell+1) for cell of own task */
+  Real *fout;     /**< outflow of local cells for each sub-step */
+} Routeorder;
+
 typedef struct wateruse *Wateruse;
 typedef struct extflow *Extflow;
 
@@ -84,5 +96,7 @@ extern Extflow initextflow(const Config *);
 extern Bool getextflow(Extflow,Cell *,int,int);
 extern void freeextflow(Extflow);
 extern Bool getroute(FILE *,Routing *,Bool);
+extern Bool initrouteorder(const Cell *,Config *);
+extern void freerouteorder(Routeorder *);
 
 #endif
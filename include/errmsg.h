@@ -65,6 +65,7 @@
 #define INIT_OUTPUT_ERR 45
 #define INVALID_CROP_PHU_OPTION_ERR 46
 #define INVALID_FIRE_INDEX_ERR 47
+#define PREFETCH_CLIMATE_ERR 48
 
 /* Definition of macros */
 
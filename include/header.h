@@ -58,6 +58,8 @@
 #define LPJ_FERTILIZZER_VERSION 3
 #define LPJ_SOILPH_HEADER "LPJ_SPH"
 #define LPJ_SOILPH_VERSION 3
+#define LPJ_CELLCOST_HEADER "LPJCOST"
+#define LPJ_CELLCOST_VERSION 3
 #define LPJ_TILLAGE_HEADER "LPJTILL"
 #define LPJ_TILLAGE_VERSION 2
 #define LPJ_CROPPHU_HEADER "LPJ_PHU"
@@ -44,6 +44,12 @@
 #ifdef USE_MPI
 #include <mpi.h> /* Include MPI header for parallel program */
 #endif
+#ifdef USE_OPENMP
+#include <omp.h> /* Include OpenMP header for threaded cell loops */
+#endif
+#ifdef USE_PTHREAD
+#include <pthread.h> /* Include POSIX thread header for prefetch of climate data */
+#endif
 
 /* Definition of datatypes */
 
@@ -95,6 +101,7 @@ typedef struct config Config; /* forward declaration of stand */
 #include "landuse.h"
 #include "woodplantation.h"
 #include "biomes.h"
+#include "timer.h"
 
 /* Definition of constants */
 
@@ -124,16 +131,24 @@ extern char *lpj_usage;
 /* Declaration of functions */
 
 extern Cell *newgrid(Config *,const Standtype [],int,int,int);
+extern Bool initaggregate(Cell *,Config *);
 extern Bool fwriterestart(const Cell[],int,int,int,const char *,Bool,const Config *);
-extern FILE *openrestart(const char *,Config *,int,Bool *);
+extern FILE *openrestart(const char *,Config *,int,Bool *,char **);
 extern void copyright(const char *);
 extern void printlicense(void);
 extern void help(const char *);
 extern void fprintflux(FILE *file,Flux,Real,int,const Config *);
 extern void fprintcsvflux(FILE *file,Flux,Real,Real,int,const Config *);
 extern void failonerror(const Config *,int,int,const char *);
+extern Bool divide_cost(int *,int *,const Filename *,const Config *);
+extern Bool divide_basin(int *,int *,const Filename *,const Config *);
+extern Bool initcellcounts(Config *);
+extern void getcellcounts(int [],int [],int,const Config *);
+extern Bool fwritecellcost(const char *,const Cell [],int,const Config *);
 #ifdef USE_MPI
 extern Bool iserror(int,const Config *);
+extern FILE *freadslice(FILE *,size_t,MPI_Comm);
+extern Bool readsliceinput(Infile *,int,MPI_Comm);
 #else
 #define iserror(rc,config) rc
 #endif
@@ -17,8 +17,12 @@
 #ifndef OUTFILE_H
 #define OUTFILE_H
 
+#define MAXWRITERSIZE (256*1024*1024) /* maximum size of data queued for asynchronous output (bytes) */
+
 /* Definition of datatypes */
 
+typedef struct writer Writer; /* asynchronous output writer, defined in outputwriter.c */
+
 typedef struct
 {
   Bool isopen;       /**< file is open for output (TRUE/FALSE) */
@@ -27,12 +31,18 @@ typedef struct
   int id;            /**< id for socket communication */
   Bool oneyear;      /**< separate output files for each year (TRUE/FALSE) */
   Bool compress;     /**< compress file after write (TRUE/FALSE) */
+  int aggregate;     /**< output aggregated over regions (NO_AGGREGATION, COUNTRY_AGGREGATION, MASK_AGGREGATION) */
   const char *filename;
   union
   { 
     FILE *file;        /**< file pointer */
     Netcdf cdf;
   } fp;
+#ifdef USE_MPI
+  Bool isparallel;   /**< file is written in parallel by all tasks using MPI-IO */
+  MPI_File fh;       /**< MPI file handle for parallel output */
+  MPI_Offset offset; /**< actual position in file for parallel output */
+#endif
 } File;
 
 typedef struct
@@ -43,8 +53,18 @@ typedef struct
 #endif
   File *files;
   int n;          /**< size of File array */
+  Writer *writer; /**< asynchronous writer for binary output or NULL */
+  int *batch_index; /**< outputs in frame sent to coupled model or NULL if batched output is disabled */
+  int *batch_size;  /**< number of bands of each output in frame */
+  float *batch;     /**< local data of outputs in frame */
+  int nbatch;       /**< number of outputs in frame */
+  int nband;        /**< number of bands in frame */
+  int maxband;      /**< number of bands allocated for frame */
   Coord_array *index;
   Coord_array *index_all;
+  int *countrycode; /**< country code of cells for aggregated output or NULL */
+  int *mask;        /**< region in mask of cells for aggregated output or NULL */
+  Real *area;       /**< cell area (m2) for aggregated output or NULL */
 } Outputfile;
 
 extern int findfile(const Outputvar *,int,int);
@@ -56,4 +76,8 @@ extern Coord_array *createcoord(Outputfile *,const Cell *,const Config *);
 extern Coord_array *createcoord_all(const Cell *,const Config *);
 extern Coord_array *createindex(const Coord *,int,Coord,Bool,Bool);
 extern void outputnames(Outputfile *,const Config *);
+extern Writer *initwriter(size_t);
+extern Bool putwriter(Writer *,FILE *,const void *,size_t);
+extern void flushwriter(Writer *);
+extern void freewriter(Writer *);
 #endif
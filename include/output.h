@@ -133,10 +133,14 @@ extern int mpi_write(FILE *,void *,MPI_Datatype,int,int *,
                      int *,int,MPI_Comm);
 extern int mpi_write_txt(FILE *,void *,MPI_Datatype,int,int *,
                          int *,int,char,MPI_Comm);
+extern int mpi_write_at(MPI_File,MPI_Offset *,void *,MPI_Datatype,int,int *,
+                        int *,int);
 #endif
 
 /* Definition of macros */
 
 #define isopen(output,index) (output->files[index].isopen || output->files[index].issocket)
+/* diagnostics of outputs not used can be skipped, they are accumulated into trash */
+#define isoutput(index,config) (config)->outputused[index]
 
 #endif
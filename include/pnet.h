@@ -25,7 +25,7 @@
 
 /* Definition of constants */
 
-#define PNET_VERSION "1.0.4"
+#define PNET_VERSION "1.1.0"
 
 /* Return codes for Pnet functions */
 
@@ -33,6 +33,7 @@
 #define PNET_TO_INDEX_ERR 2   /* invalid to index */
 #define PNET_FROM_INDEX_ERR 3 /* invalid from index */
 #define PNET_NULL_PTR_ERR 4   /* NULL pointer error */
+#define PNET_BOUNDS_ERR 5     /* invalid bounds of subarray */
 #define PNET_OK 0             /* code for successful operation */
 
 /* Definition of datatypes */
@@ -58,13 +59,22 @@ typedef struct
   void *outbuffer;   /* output buffer */
   void *inbuffer;    /* input buffer */
   int *outindex;     /* output index vector */
+  int *tasklo;       /* lower bounds of subarrays of all tasks */
+  int *taskhi;       /* upper bounds of subarrays of all tasks */
   Intlist *connect;  /* connection lists */
+#ifdef USE_MPI
+  MPI_Comm graph;    /* communicator of neighbouring tasks */
+  int *srclen;       /* array sizes for input from neighbouring tasks */
+  int *srcdisp;      /* displacement vector for input from neighbouring tasks */
+  int *destlen;      /* array sizes for output to neighbouring tasks */
+  int *destdisp;     /* displacement vector for output to neighbouring tasks */
+#endif
 } Pnet;
 
 /* Declaration of functions */
 
 #ifdef USE_MPI
-extern Pnet *pnet_init(MPI_Comm,MPI_Datatype,int);
+extern Pnet *pnet_init(MPI_Comm,MPI_Datatype,int,int,int);
 #else
 extern Pnet *pnet_init(int,int);
 #endif
@@ -78,7 +88,12 @@ extern char *pnet_strerror(int);
 /* Definitions of macros */
 
 #ifdef USE_MPI
+#if MPI_VERSION>=3
+/* data are only exchanged with tasks connected by the network */
+#define pnet_exchg(pnet) MPI_Neighbor_alltoallv(pnet->outbuffer,pnet->destlen,pnet->destdisp,pnet->type,pnet->inbuffer,pnet->srclen,pnet->srcdisp,pnet->type,pnet->graph)
+#else
 #define pnet_exchg(pnet) MPI_Alltoallv(pnet->outbuffer,pnet->outlen,pnet->outdisp,pnet->type,pnet->inbuffer,pnet->inlen,pnet->indisp,pnet->type,pnet->comm)
+#endif
 #else
 #define pnet_exchg(pnet) memcpy(pnet->inbuffer,pnet->outbuffer,pnet->size*pnet->inlen[0])
 #endif
@@ -19,6 +19,8 @@
 
 typedef struct queue *Queue;
 
+#define QUEUE_BLOCK 4 /* length of queues is padded to multiple of QUEUE_BLOCK */
+
 /* Declarations of functions */
 
 extern Queue newqueue(int);
@@ -26,6 +28,8 @@ extern void freequeue(Queue);
 extern Real getqueue(const Queue,int);
 extern void putqueue(Queue,Real);
 extern Real sumqueue(const Queue);
+extern Real convqueue(const Queue,const Real []);
+extern Real *packqueues(Queue [],int);
 extern Bool fwritequeue(FILE *,const Queue);
 extern Queue freadqueue(FILE *,Bool);
 extern void freequeue(Queue);
@@ -34,4 +38,6 @@ extern int queuesize(const Queue);
 
 /* Definition of macros */
 
+#define padqueuesize(n) (((n)+QUEUE_BLOCK-1)/QUEUE_BLOCK*QUEUE_BLOCK)
+
 #endif
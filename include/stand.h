@@ -50,6 +50,15 @@ struct stand
   void *data;                 /**< stand-specific extensions */
 };
 
+typedef struct
+{
+  Real *wet;      /**< wet fraction of PFTs in stand */
+  Real *gp_pft;   /**< pot. canopy conductance for PFTs & CFTs (mm/s) */
+  Real *fpc_inc;  /**< FPC increment of PFTs in stand */
+  Real *fpc_type; /**< FPC of PFT types */
+  int *pvec;      /**< permutation vector of PFTs in stand */
+} Scratch;        /**< scratch buffers for stand daily functions */
+
 typedef List *Standlist;
 typedef struct landcover *Landcover;
 
@@ -93,6 +102,9 @@ extern Landcover initlandcover(int,const Config *);
 extern Bool readlandcover(Landcover,const Cell *,int,const Config *);
 extern Real *getlandcover(Landcover,int);
 extern void freelandcover(Landcover,Bool);
+extern Bool initscratch(int,int,const Config *);
+extern Scratch *getscratch(void);
+extern void freescratch(void);
 
 /* Definition of macros */
 
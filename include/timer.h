@@ -0,0 +1,57 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                       t  i  m  e  r  .  h                                      \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Declaration of phase timers of the main time loop. Timers are              \n**/
+/**     hierarchical, time of a phase includes time of its subphases.              \n**/
+/**     Timers of daily_stand() are summed over all OpenMP threads and are         \n**/
+/**     CPU time, which can exceed the wall clock time of iterateyear().           \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#ifndef TIMER_H /* Already included? */
+#define TIMER_H
+
+/* Definition of datatypes */
+
+typedef enum
+{
+  TIMER_YEAR,          /**< one simulation year in iterate() */
+  TIMER_CLIMATE,       /**< reading of climate data */
+  TIMER_LANDUSE,       /**< reading of land-use data */
+  TIMER_ITERATEYEAR,   /**< iterateyear() */
+  TIMER_DAILY_STAND,   /**< daily_stand() of first land-use type, one timer for each type, summed over OpenMP threads */
+  TIMER_DRAIN=TIMER_DAILY_STAND+KILL, /**< river routing by drain() */
+  TIMER_WATERUSE,      /**< wateruse() */
+  TIMER_UPDATE_ANNUAL, /**< update_annual() of all cells */
+  TIMER_FWRITEOUTPUT,  /**< fwriteoutput() */
+  TIMER_RESTART,       /**< writing of restart and checkpoint files */
+  NTIMER               /**< number of timers */
+} Timer;
+
+extern double timer[NTIMER];       /**< time spent in phases in current year (sec) */
+extern double timer_total[NTIMER]; /**< time spent in phases in previous years (sec) */
+extern double timer_start[NTIMER]; /**< start time of phases (sec) */
+
+/* Declaration of functions */
+
+extern void inittimers(void);
+extern void sumtimers(void);
+extern void fprinttimers(FILE *,int,const Config *);
+extern Bool fwritetimers(const char *,int,const Config *);
+
+/* Definition of macros */
+
+#define istiming(config) ((config)->timing_filename!=NULL || (config)->print_timing)
+#define starttimer(t,config) do { if(istiming(config)) timer_start[t]=mrun(); } while(0)
+#define stoptimer(t,config) do { if(istiming(config)) timer[t]+=mrun()-timer_start[t]; } while(0)
+
+#endif
@@ -162,6 +162,12 @@ extern void fprinttime(FILE *,int);
 extern Bool readrealvec(FILE *,Real *,Real,Real,size_t,Bool,Type);
 extern Bool readfloatvec(FILE *,float *,float,size_t,Bool,Type);
 extern Bool readintvec(FILE *,int *,size_t,Bool,Type);
+extern void *mapfile(FILE *,size_t *);
+extern void unmapfile(void *,size_t);
+extern FILE *createzfile(const char *,size_t,size_t,int,int);
+extern FILE *openzfile(const char *);
+extern Bool readrealmap(const void *,size_t,long long,Real *,Real,Real,size_t,Bool,Type);
+extern Bool readintmap(const void *,size_t,long long,int *,size_t,Bool,Type);
 extern Bool readuintvec(FILE *,unsigned int *,size_t,Bool,Type);
 extern Bool readfilename(LPJfile *,Filename *,const char *,const char *,Bool,Bool,Bool,Verbosity);
 extern void freefilename(Filename *);
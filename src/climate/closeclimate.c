@@ -26,6 +26,8 @@ void closeclimatefile(Climatefile *file, /**< pointer to climate data file */
       closeclimate_netcdf(file,isroot);
     else
     {
+      unmapfile(file->map,file->map_len);
+      file->map=NULL;
       fclose(file->file);
       file->isopen=FALSE;
     }
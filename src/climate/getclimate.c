@@ -57,6 +57,9 @@ Bool readclimate(Climatefile *file,   /**< climate data file */
     }
     if(file->fmt==CDF)
       rc=readclimate_netcdf(file,data,grid,index,config);
+    else if(file->map!=NULL)
+      rc=readrealmap(file->map,file->map_len,index*file->size+file->offset,
+                     data,intercept,slope,file->n,file->swap,file->datatype);
     else
     {
       if(fseek(file->file,index*file->size+file->offset,SEEK_SET))
@@ -69,17 +72,18 @@ Bool readclimate(Climatefile *file,   /**< climate data file */
   return iserror(rc,config);
 } /* of'readclimate' */
 
-Bool getclimate(Climate *climate,    /**< pointer to climate data */
-                const Cell grid[],   /**< LPJ grid */
-                int year,            /**< year of climate data to be read */
-                const Config *config /**< LPJ configuration */
-               )                     /** \return TRUE on error */
+Bool getclimatedata(Climate *climate,    /**< pointer to climate data */
+                    Climatedata *data,   /**< climate data arrays to be filled */
+                    const Cell grid[],   /**< LPJ grid */
+                    int year,            /**< year of climate data to be read */
+                    const Config *config /**< LPJ configuration */
+                   )                     /** \return TRUE on error */
 {
   char *name;
   Real *wet;
   int i,index;
   Bool rc;
-  if(readclimate(&climate->file_temp,climate->data.temp,0,climate->file_temp.scalar,grid,year,config))
+  if(readclimate(&climate->file_temp,data->temp,0,climate->file_temp.scalar,grid,year,config))
   {
     if(isroot(*config))
     {
@@ -90,7 +94,7 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
     }
     return TRUE;
   }
-  if(readclimate(&climate->file_prec,climate->data.prec,0,climate->file_prec.scalar,grid,year,config))
+  if(readclimate(&climate->file_prec,data->prec,0,climate->file_prec.scalar,grid,year,config))
   {
     if(isroot(*config))
     {
@@ -101,9 +105,9 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
     }
     return TRUE;
   }
-  if(climate->data.tmax!=NULL)
+  if(data->tmax!=NULL)
   {
-    if(readclimate(&climate->file_tmax,climate->data.tmax,0,climate->file_tmax.scalar,grid,year,config))
+    if(readclimate(&climate->file_tmax,data->tmax,0,climate->file_tmax.scalar,grid,year,config))
     {
       if(isroot(*config))
       {
@@ -115,9 +119,9 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
       return TRUE;
     }
   }
-  if(climate->data.tmin!=NULL)
+  if(data->tmin!=NULL)
   {
-    if(readclimate(&climate->file_tmin,climate->data.tmin,0,climate->file_tmin.scalar,grid,year,config))
+    if(readclimate(&climate->file_tmin,data->tmin,0,climate->file_tmin.scalar,grid,year,config))
     {
       if(isroot(*config))
       {
@@ -129,9 +133,9 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
       return TRUE;
     }
   }
-  if(climate->data.sun!=NULL)
+  if(data->sun!=NULL)
   {
-    if(readclimate(&climate->file_cloud,climate->data.sun,100,-climate->file_cloud.scalar,grid,year,config))
+    if(readclimate(&climate->file_cloud,data->sun,100,-climate->file_cloud.scalar,grid,year,config))
     {
       if(isroot(*config))
       {
@@ -144,11 +148,11 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
     }
     if(config->cloud_filename.fmt==CDF)
       for(i=0;i<climate->file_cloud.n;i++)
-        climate->data.sun[i]=100-climate->data.sun[i];
+        data->sun[i]=100-data->sun[i];
   }
-  if(climate->data.lwnet!=NULL)
+  if(data->lwnet!=NULL)
   {
-    if(readclimate(&climate->file_lwnet,climate->data.lwnet,0,climate->file_lwnet.scalar,grid,year,config))
+    if(readclimate(&climate->file_lwnet,data->lwnet,0,climate->file_lwnet.scalar,grid,year,config))
     {
       if(isroot(*config))
       {
@@ -160,9 +164,9 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
       return TRUE;
     }
   }
-  if(climate->data.swdown!=NULL)
+  if(data->swdown!=NULL)
   {
-    if(readclimate(&climate->file_swdown,climate->data.swdown,0,climate->file_swdown.scalar,grid,year,config))
+    if(readclimate(&climate->file_swdown,data->swdown,0,climate->file_swdown.scalar,grid,year,config))
     {
       if(isroot(*config))
       {
@@ -174,9 +178,9 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
       return TRUE;
     }
   }
-  if(climate->data.humid!=NULL)
+  if(data->humid!=NULL)
   {
-    if(readclimate(&climate->file_humid,climate->data.humid,0,climate->file_humid.scalar,grid,year,config))
+    if(readclimate(&climate->file_humid,data->humid,0,climate->file_humid.scalar,grid,year,config))
     {
       if(isroot(*config))
       {
@@ -188,9 +192,9 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
       return TRUE;
     }
   }
-  if(climate->data.wind!=NULL)
+  if(data->wind!=NULL)
   {
-    if(readclimate(&climate->file_wind,climate->data.wind,0,climate->file_wind.scalar,grid,year,config))
+    if(readclimate(&climate->file_wind,data->wind,0,climate->file_wind.scalar,grid,year,config))
     {
       if(isroot(*config))
       {
@@ -202,9 +206,9 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
       return TRUE;
     }
   }
-  if(climate->data.tamp!=NULL)
+  if(data->tamp!=NULL)
   {
-    if(readclimate(&climate->file_tamp,climate->data.tamp,0,climate->file_tamp.scalar,grid,year,config))
+    if(readclimate(&climate->file_tamp,data->tamp,0,climate->file_tamp.scalar,grid,year,config))
     {
       if(isroot(*config))
       {
@@ -216,9 +220,9 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
       return TRUE;
     }
   }
-  if(climate->data.burntarea!=NULL)
+  if(data->burntarea!=NULL)
   {
-    if(readclimate(&climate->file_burntarea,climate->data.burntarea,0,climate->file_burntarea.scalar,grid,year,config))
+    if(readclimate(&climate->file_burntarea,data->burntarea,0,climate->file_burntarea.scalar,grid,year,config))
     {
       if(isroot(*config))
       {
@@ -230,7 +234,7 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
       return TRUE;
     }
   }
-  if(climate->data.wet!=NULL)
+  if(data->wet!=NULL)
   {
     index=year-climate->file_wet.firstyear;
     if(index<0)
@@ -242,7 +246,7 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
     }
     if(index<climate->file_wet.nyear)
     {
-      if(readclimate(&climate->file_wet,climate->data.wet,0,climate->file_wet.scalar,grid,year,config))
+      if(readclimate(&climate->file_wet,data->wet,0,climate->file_wet.scalar,grid,year,config))
       {
         if(isroot(*config))
         {
@@ -269,7 +273,7 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
       if(iserror(rc,config))
         return TRUE;
       for(i=0;i<climate->file_wet.n;i++)
-        climate->data.wet[i]=0;
+        data->wet[i]=0;
       /**
       * Average number of wet days from 1960 to 1989
       **/
@@ -287,12 +291,21 @@ Bool getclimate(Climate *climate,    /**< pointer to climate data */
           return TRUE;
         }
         for(i=0;i<climate->file_wet.n;i++)
-          climate->data.wet[i]+=wet[i];
+          data->wet[i]+=wet[i];
       }
       for(i=0;i<climate->file_wet.n;i++)
-        climate->data.wet[i]/=30;
+        data->wet[i]/=30;
       free(wet);
     }
   }
   return FALSE;
+} /* of 'getclimatedata' */
+
+Bool getclimate(Climate *climate,    /**< pointer to climate data */
+                const Cell grid[],   /**< LPJ grid */
+                int year,            /**< year of climate data to be read */
+                const Config *config /**< LPJ configuration */
+               )                     /** \return TRUE on error */
+{
+  return getclimatedata(climate,&climate->data,grid,year,config);
 } /* of 'getclimate' */
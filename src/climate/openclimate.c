@@ -30,6 +30,7 @@ Bool openclimate(Climatefile *file,        /**< pointer to climate file */
   char *s;
   size_t offset,filesize;
   file->fmt=filename->fmt;
+  file->map=NULL;
   if(filename->fmt==FMS)
   {
     file->time_step=DAY;
@@ -68,6 +69,8 @@ Bool openclimate(Climatefile *file,        /**< pointer to climate file */
   file->oneyear=FALSE;
   if(filename->fmt==CDF) /** file is in NetCDF format? */
   {
+    file->isdistributed=FALSE;
+    file->index=NULL;
     s=strchr(filename->name,'[');
     if(s!=NULL && sscanf(s,"[%d-%d]",&file->firstyear,&last)==2)
     {
@@ -109,6 +112,7 @@ Bool openclimate(Climatefile *file,        /**< pointer to climate file */
         return TRUE;
       }
       file->oneyear=TRUE;
+      file->isdistributed=config->distribute_netcdf_input;
       file->units=units;
       file->nyear=last-file->firstyear+1;
       if(file->filename==NULL)
@@ -120,6 +124,7 @@ Bool openclimate(Climatefile *file,        /**< pointer to climate file */
     }
     else
     {
+      file->isdistributed=config->distribute_netcdf_input;
       if(mpi_openclimate_netcdf(file,filename,units,config))
         return TRUE;
       if(file->time_step==MISSING_TIME)
@@ -224,6 +229,8 @@ Bool openclimate(Climatefile *file,        /**< pointer to climate file */
   file->time_step=(header.nbands==NDAYYEAR) ? DAY : MONTH;
   file->size=header.ncell*header.nbands*typesizes[file->datatype];
   file->n=header.nbands*config->ngridcell;
+  /* file is mapped into memory, data are read by readrealmap() */
+  file->map=mapfile(file->file,&file->map_len);
   file->isopen=TRUE;
   return FALSE;
 } /* of 'openclimate' */
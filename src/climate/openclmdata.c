@@ -30,6 +30,7 @@ Bool openclmdata(Climatefile *file,        /**< pointer to file */
   String headername;
   int version;
   size_t offset,filesize;
+  file->map=NULL;
   if((file->file=openinputfile(&header,&file->swap,
                                filename,headername,unit,datatype,
                                &version,&offset,TRUE,config))==NULL)
@@ -78,5 +79,7 @@ Bool openclmdata(Climatefile *file,        /**< pointer to file */
     closeclimatefile(file,isroot(*config));
     return TRUE;
   }
+  /* file is mapped into memory, data are read by readrealmap() or readintmap() */
+  file->map=mapfile(file->file,&file->map_len);
   return FALSE;
 } /* of 'openclmdata' */
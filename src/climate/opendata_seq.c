@@ -30,6 +30,7 @@ Bool opendata_seq(Climatefile *file,        /**< pointer to file */
   file->fmt=filename->fmt;
   if(file->fmt==CDF)
   {
+    file->isdistributed=FALSE;
     if(openclimate_netcdf(file,filename->name,filename->time,filename->var,filename->unit,unit,config))
       return TRUE;
     file->oneyear=FALSE;
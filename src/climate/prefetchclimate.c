@@ -0,0 +1,200 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**               p  r  e  f  e  t  c  h  c  l  i  m  a  t  e  .  c                \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Functions read climate data of the next simulation year in a               \n**/
+/**     separate thread while the current year is simulated. Data are              \n**/
+/**     read into a second set of buffers which are swapped with the               \n**/
+/**     climate data arrays by waitprefetch().                                     \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+static Bool isnetcdf(const Climatefile *file,const Real *data)
+{
+  return data!=NULL && file->fmt==CDF;
+} /* of 'isnetcdf' */
+
+static Bool issocket(const Climatefile *file,const Real *data)
+{
+  return data!=NULL && file->fmt==SOCK;
+} /* of 'issocket' */
+
+#define newbuffer(name,file) if(climate->data.name!=NULL)\
+  {\
+    prefetch->data.name=newvec(Real,climate->file.n);\
+    if(prefetch->data.name==NULL)\
+    {\
+      printallocerr(#name);\
+      rc=TRUE;\
+    }\
+  }\
+  else\
+    prefetch->data.name=NULL;
+
+#define swapbuffer(name) ptr=climate->data.name; climate->data.name=prefetch->data.name; prefetch->data.name=ptr;
+
+Bool initprefetch(Prefetch *prefetch, /**< pointer to prefetch data */
+                  Climate *climate,   /**< pointer to climate data */
+                  const Config *config /**< LPJ configuration */
+                 )                    /** \return TRUE on error */
+{
+  Bool rc,isinput,isoutput;
+  int i;
+  prefetch->isenabled=prefetch->isrunning=FALSE;
+  prefetch->climate=climate;
+  prefetch->data.temp=prefetch->data.prec=prefetch->data.sun=NULL;
+  prefetch->data.wet=prefetch->data.wind=prefetch->data.tamp=NULL;
+  prefetch->data.tmax=prefetch->data.humid=prefetch->data.tmin=NULL;
+  prefetch->data.lwnet=prefetch->data.swdown=prefetch->data.burntarea=NULL;
+  prefetch->data.lightning=prefetch->data.no3deposition=prefetch->data.nh4deposition=NULL;
+  if(!config->prefetch_climate)
+    return FALSE;
+  if(issocket(&climate->file_temp,climate->data.temp) || issocket(&climate->file_prec,climate->data.prec) ||
+     issocket(&climate->file_cloud,climate->data.sun) || issocket(&climate->file_wet,climate->data.wet) ||
+     issocket(&climate->file_wind,climate->data.wind) || issocket(&climate->file_tamp,climate->data.tamp) ||
+     issocket(&climate->file_tmax,climate->data.tmax) || issocket(&climate->file_humid,climate->data.humid) ||
+     issocket(&climate->file_tmin,climate->data.tmin) || issocket(&climate->file_lwnet,climate->data.lwnet) ||
+     issocket(&climate->file_swdown,climate->data.swdown) || issocket(&climate->file_burntarea,climate->data.burntarea))
+  {
+    if(isroot(*config))
+      fputs("WARNING042: Climate data received from socket, prefetch of climate data disabled.\n",stderr);
+    return FALSE;
+  }
+  /* NetCDF library is not thread-safe, reading and writing NetCDF files
+     at the same time is not possible */
+  isinput=isnetcdf(&climate->file_temp,climate->data.temp) || isnetcdf(&climate->file_prec,climate->data.prec) ||
+          isnetcdf(&climate->file_cloud,climate->data.sun) || isnetcdf(&climate->file_wet,climate->data.wet) ||
+          isnetcdf(&climate->file_wind,climate->data.wind) || isnetcdf(&climate->file_tamp,climate->data.tamp) ||
+          isnetcdf(&climate->file_tmax,climate->data.tmax) || isnetcdf(&climate->file_humid,climate->data.humid) ||
+          isnetcdf(&climate->file_tmin,climate->data.tmin) || isnetcdf(&climate->file_lwnet,climate->data.lwnet) ||
+          isnetcdf(&climate->file_swdown,climate->data.swdown) || isnetcdf(&climate->file_burntarea,climate->data.burntarea);
+  isoutput=FALSE;
+  for(i=0;i<config->n_out;i++)
+    if(config->outputvars[i].filename.fmt==CDF)
+    {
+      isoutput=TRUE;
+      break;
+    }
+  if(isinput && isoutput)
+  {
+    if(isroot(*config))
+      fputs("WARNING042: NetCDF climate input and NetCDF output not supported, prefetch of climate data disabled.\n",stderr);
+    return FALSE;
+  }
+  rc=FALSE;
+  newbuffer(temp,file_temp);
+  newbuffer(prec,file_prec);
+  newbuffer(sun,file_cloud);
+  newbuffer(wet,file_wet);
+  newbuffer(wind,file_wind);
+  newbuffer(tamp,file_tamp);
+  newbuffer(tmax,file_tmax);
+  newbuffer(humid,file_humid);
+  newbuffer(tmin,file_tmin);
+  newbuffer(lwnet,file_lwnet);
+  newbuffer(swdown,file_swdown);
+  newbuffer(burntarea,file_burntarea);
+  if(iserror(rc,config))
+  {
+    freeclimatedata(&prefetch->data);
+    return TRUE;
+  }
+  /* copy of configuration with own communicator for the reading thread */
+  prefetch->config=*config;
+#ifdef USE_MPI
+  MPI_Comm_dup(config->comm,&prefetch->config.comm);
+#endif
+  prefetch->isenabled=TRUE;
+  return FALSE;
+} /* of 'initprefetch' */
+
+#ifdef USE_PTHREAD
+static void *readthread(void *arg)
+{
+  Prefetch *prefetch;
+  prefetch=arg;
+  prefetch->rc=getclimatedata(prefetch->climate,&prefetch->data,prefetch->grid,
+                              prefetch->year,&prefetch->config);
+  return NULL;
+} /* of 'readthread' */
+#endif
+
+Bool prefetchclimate(Prefetch *prefetch, /**< pointer to prefetch data */
+                     const Cell grid[],  /**< LPJ grid */
+                     int year            /**< year of climate data to be read (AD) */
+                    )                    /** \return TRUE on error */
+{
+  if(!prefetch->isenabled)
+    return FALSE;
+  prefetch->grid=grid;
+  prefetch->year=year;
+  /* averaged wet days are not read again and have to be kept in buffer */
+  if(prefetch->data.wet!=NULL)
+    memcpy(prefetch->data.wet,prefetch->climate->data.wet,sizeof(Real)*prefetch->climate->file_wet.n);
+#ifdef USE_PTHREAD
+  if(pthread_create(&prefetch->thread,NULL,readthread,prefetch)==0)
+  {
+    prefetch->isrunning=TRUE;
+    return FALSE;
+  }
+#endif
+  /* thread cannot be created, read data synchronously */
+  prefetch->rc=getclimatedata(prefetch->climate,&prefetch->data,grid,year,&prefetch->config);
+  prefetch->isrunning=TRUE;
+  return prefetch->rc;
+} /* of 'prefetchclimate' */
+
+Bool waitprefetch(Prefetch *prefetch /**< pointer to prefetch data */
+                 )                   /** \return TRUE on error */
+{
+  Climate *climate;
+  Real *ptr;
+  if(!prefetch->isrunning)
+    return TRUE;
+#ifdef USE_PTHREAD
+  pthread_join(prefetch->thread,NULL);
+#endif
+  prefetch->isrunning=FALSE;
+  if(prefetch->rc)
+    return TRUE;
+  climate=prefetch->climate;
+  swapbuffer(temp);
+  swapbuffer(prec);
+  swapbuffer(sun);
+  swapbuffer(wet);
+  swapbuffer(wind);
+  swapbuffer(tamp);
+  swapbuffer(tmax);
+  swapbuffer(humid);
+  swapbuffer(tmin);
+  swapbuffer(lwnet);
+  swapbuffer(swdown);
+  swapbuffer(burntarea);
+  return FALSE;
+} /* of 'waitprefetch' */
+
+void freeprefetch(Prefetch *prefetch /**< pointer to prefetch data */
+                 )
+{
+  if(!prefetch->isenabled)
+    return;
+#ifdef USE_PTHREAD
+  if(prefetch->isrunning)
+    pthread_join(prefetch->thread,NULL);
+#endif
+  prefetch->isrunning=prefetch->isenabled=FALSE;
+  freeclimatedata(&prefetch->data);
+#ifdef USE_MPI
+  MPI_Comm_free(&prefetch->config.comm);
+#endif
+} /* of 'freeprefetch' */
@@ -69,6 +69,19 @@ Real *readdata(Climatefile *file,   /**< Pointer to data file */
       return NULL;
     }
   }
+  else if(file->map!=NULL)
+  {
+    if(readrealmap(file->map,file->map_len,(long long)year*file->size+file->offset,
+                   data,0,file->scalar,file->n,file->swap,file->datatype))
+    {
+      fprintf(stderr,"ERROR149: Cannot read %s of year %d in readdata().\n",
+              name,year+file->firstyear);
+      fflush(stderr);
+      if(isalloc)
+        free(data);
+      return NULL;
+    }
+  }
   else
   {
     if(fseek(file->file,(long long)year*file->size+file->offset,SEEK_SET))
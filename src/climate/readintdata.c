@@ -58,6 +58,18 @@ int *readintdata(Climatefile *file,   /**< Pointer to data file */
       return NULL;
     }
   }
+  else if(file->map!=NULL)
+  {
+    if(readintmap(file->map,file->map_len,(long long)year*file->size+file->offset,
+                  data,file->n,file->swap,file->datatype))
+    {
+      fprintf(stderr,"ERROR149: Cannot read %s of year %d in readintdata().\n",
+              name,year+file->firstyear);
+      fflush(stderr);
+      free(data);
+      return NULL;
+    }
+  }
   else
   {
     if(fseek(file->file,(long long)year*file->size+file->offset,SEEK_SET))
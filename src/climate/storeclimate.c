@@ -4,6 +4,11 @@
 /**                                                                                \n**/
 /**     C implementation of LPJmL                                                  \n**/
 /**                                                                                \n**/
+/**     Functions store climate data of the spin-up years in memory. Data          \n**/
+/**     are kept in the datatype of the input (short or float) together            \n**/
+/**     with slope and intercept and decoded for each year. A variable is          \n**/
+/**     converted to a wider datatype if values cannot be restored exactly.        \n**/
+/**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
 /** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
@@ -15,8 +20,171 @@
 #include "lpj.h"
 
 #define checkptr(ptr) if(ptr==NULL) {printallocerr(#ptr); return TRUE; }
+#define initvar(var,file) if(initstore(&store->var,&climate->file,nyear)) {printallocerr(#var); return TRUE; }
+
+static Bool initstore(Climstore *var,          /**< stored climate variable */
+                      const Climatefile *file, /**< climate file */
+                      int nyear                /**< number of years stored */
+                     )                         /** \return TRUE on error */
+{
+  var->n=file->n;
+  if(file->issocket)
+    var->datatype=LPJ_DOUBLE;
+  else
+    switch(file->datatype)
+    {
+      case LPJ_BYTE: case LPJ_SHORT:
+        var->datatype=LPJ_SHORT;
+        break;
+      case LPJ_INT: case LPJ_FLOAT:
+        var->datatype=LPJ_FLOAT;
+        break;
+      default:
+        var->datatype=LPJ_DOUBLE;
+    }
+#if defined(USE_NETCDF) || defined(USE_NETCDF4)
+  if(file->fmt==CDF)
+  {
+    var->slope=file->slope;
+    var->intercept=file->intercept;
+  }
+  else
+#endif
+  {
+    var->slope=file->scalar;
+    var->intercept=0;
+  }
+  if(var->slope==0)
+    var->datatype=LPJ_DOUBLE;
+  var->data=malloc(typesizes[var->datatype]*var->n*nyear);
+  return var->data==NULL;
+} /* of 'initstore' */
+
+static void decodestore(Real data[],          /**< decoded climate data */
+                        const Climstore *var, /**< stored climate variable */
+                        int year              /**< year index */
+                       )
+{
+  long long i,index;
+  index=var->n*year;
+  switch(var->datatype)
+  {
+    case LPJ_SHORT:
+      for(i=0;i<var->n;i++)
+        data[i]=var->intercept+((short *)var->data)[index+i]*var->slope;
+      break;
+    case LPJ_FLOAT:
+      for(i=0;i<var->n;i++)
+        data[i]=var->intercept+((float *)var->data)[index+i]*var->slope;
+      break;
+    default:
+      for(i=0;i<var->n;i++)
+        data[i]=((double *)var->data)[index+i];
+  }
+} /* of 'decodestore' */
+
+static Bool widenstore(Climstore *var, /**< stored climate variable */
+                       int nyear,      /**< number of years stored */
+                       int year        /**< number of years already stored */
+                      )                /** \return TRUE on error */
+{
+  /* convert stored data into next wider datatype, conversion is exact */
+  Real *data;
+  void *wide;
+  long long i,index;
+  int y;
+  data=newvec(Real,var->n);
+  checkptr(data);
+  wide=malloc(typesizes[(var->datatype==LPJ_SHORT) ? LPJ_FLOAT : LPJ_DOUBLE]*var->n*nyear);
+  if(wide==NULL)
+  {
+    free(data);
+    printallocerr("wide");
+    return TRUE;
+  }
+  for(y=0;y<year;y++)
+  {
+    decodestore(data,var,y);
+    index=var->n*y;
+    if(var->datatype==LPJ_SHORT)
+      for(i=0;i<var->n;i++)
+        ((float *)wide)[index+i]=((short *)var->data)[index+i];
+    else
+      for(i=0;i<var->n;i++)
+        ((double *)wide)[index+i]=data[i];
+  }
+  free(data);
+  free(var->data);
+  var->data=wide;
+  var->datatype=(var->datatype==LPJ_SHORT) ? LPJ_FLOAT : LPJ_DOUBLE;
+  return FALSE;
+} /* of 'widenstore' */
+
+static Bool encodestore(Climstore *var,      /**< stored climate variable */
+                        const Real data[],   /**< climate data of year */
+                        int nyear,           /**< number of years stored */
+                        int year,            /**< year index */
+                        const Cell grid[],   /**< LPJ grid */
+                        const Config *config /**< LPJ configuration */
+                       )                     /** \return TRUE on error */
+{
+  long long i,index;
+  int len;
+  Real value;
+  Bool isexact;
+  index=var->n*year;
+  len=var->n/config->ngridcell;
+  do
+  {
+    isexact=TRUE;
+    switch(var->datatype)
+    {
+      case LPJ_SHORT:
+        for(i=0;i<var->n;i++)
+        {
+          if(grid[i/len].skip)
+            value=0;
+          else
+          {
+            value=floor((data[i]-var->intercept)/var->slope+0.5);
+            if(value<SHRT_MIN || value>SHRT_MAX || var->intercept+(short)value*var->slope!=data[i])
+            {
+              isexact=FALSE;
+              break;
+            }
+          }
+          ((short *)var->data)[index+i]=(short)value;
+        }
+        break;
+      case LPJ_FLOAT:
+        for(i=0;i<var->n;i++)
+        {
+          if(grid[i/len].skip)
+            value=0;
+          else
+          {
+            value=(float)((data[i]-var->intercept)/var->slope);
+            if(var->intercept+(float)value*var->slope!=data[i])
+            {
+              isexact=FALSE;
+              break;
+            }
+          }
+          ((float *)var->data)[index+i]=(float)value;
+        }
+        break;
+      default:
+        for(i=0;i<var->n;i++)
+          ((double *)var->data)[index+i]=data[i];
+    }
+    /* values cannot be restored exactly, use wider datatype */
+    if(!isexact && widenstore(var,nyear,year))
+      return TRUE;
+  } while(!isexact);
+  return FALSE;
+} /* of 'encodestore' */
 
-Bool storeclimate(Climatedata *store,  /**< pointer to climate data to be stored */
+Bool storeclimate(Climatestore *store, /**< pointer to climate data to be stored */
                   Climate *climate,    /**< climate pointer data is read */
                   const Cell grid[],   /**< LPJ grid */
                   int firstyear,       /**< first year of climate to be read */
@@ -24,270 +192,118 @@ Bool storeclimate(Climatedata *store,  /**< pointer to climate data to be stored
                   const Config *config /**< LPJ configuration */
                  )                     /** \return TRUE on error */
 {
-  int year,j;
-  long count;
+  int year;
   /**
   * allocate arrays for climate storage
   **/
-  store->temp=newvec(Real,climate->file_temp.n*nyear);
-  checkptr(store->temp);
-  store->prec=newvec(Real,climate->file_prec.n*nyear);
-  checkptr(store->prec);
-  store->no3deposition=NULL;
-  store->nh4deposition=NULL;
+  store->temp.data=store->prec.data=store->tmax.data=store->humid.data=NULL;
+  store->tmin.data=store->sun.data=store->lwnet.data=store->swdown.data=NULL;
+  store->wet.data=store->wind.data=store->tamp.data=store->burntarea.data=NULL;
+  initvar(temp,file_temp);
+  initvar(prec,file_prec);
   if(climate->data.tmax!=NULL)
-  {
-    store->tmax=newvec(Real,climate->file_tmax.n*nyear);
-    checkptr(store->tmax);
-  }
-  else
-    store->tmax=NULL;
+    initvar(tmax,file_tmax);
   if(climate->data.humid!=NULL)
-  {
-    store->humid=newvec(Real,climate->file_humid.n*nyear);
-    checkptr(store->humid);
-  }
-  else
-    store->humid=NULL;
+    initvar(humid,file_humid);
   if(climate->data.tmin!=NULL)
-  {
-    store->tmin=newvec(Real,climate->file_tmin.n*nyear);
-    checkptr(store->tmin);
-  }
-  else
-    store->tmin=NULL;
+    initvar(tmin,file_tmin);
   if(climate->data.sun!=NULL)
-  {
-    store->sun=newvec(Real,climate->file_cloud.n*nyear);
-    checkptr(store->sun);
-  }
-  else
-    store->sun=NULL;
+    initvar(sun,file_cloud);
   if(climate->data.lwnet!=NULL)
-  {
-    store->lwnet=newvec(Real,climate->file_lwnet.n*nyear);
-    checkptr(store->lwnet);
-  }
-  else
-    store->lwnet=NULL;
+    initvar(lwnet,file_lwnet);
   if(climate->data.swdown!=NULL)
-  {
-    store->swdown=newvec(Real,climate->file_swdown.n*nyear);
-    checkptr(store->swdown);
-  }
-  else
-    store->swdown=NULL;
+    initvar(swdown,file_swdown);
   if(climate->data.wet!=NULL)
-  {
-    store->wet=newvec(Real,climate->file_wet.n*nyear);
-    checkptr(store->wet);
-  }
-  else
-    store->wet=NULL;
+    initvar(wet,file_wet);
   if(climate->data.wind!=NULL)
-  {
-    store->wind=newvec(Real,climate->file_wind.n*nyear);
-    checkptr(store->wind);
-  }
-  else
-    store->wind=NULL;
+    initvar(wind,file_wind);
   if(climate->data.tamp!=NULL)
-  {
-    store->tamp=newvec(Real,climate->file_tamp.n*nyear);
-    checkptr(store->tamp);
-  }
-  else
-    store->tamp=NULL;
+    initvar(tamp,file_tamp);
   if(climate->data.burntarea!=NULL)
-  {
-    store->burntarea=newvec(Real,climate->file_burntarea.n*nyear);
-    checkptr(store->burntarea);
-  }
-  else
-    store->burntarea=NULL;
-  if(climate->data.lightning!=NULL)
-  {
-    store->lightning=newvec(Real,climate->file_lightning.n);
-    checkptr(store->lightning);
-    for(j=0;j<climate->file_lightning.n;j++)
-      store->lightning[j]=climate->data.lightning[j];
-  }
-  else
-    store->lightning=NULL;
+    initvar(burntarea,file_burntarea);
   for(year=firstyear;year<firstyear+nyear;year++)
   {
     if(getclimate(climate,grid,year,config))
       return TRUE;
-    count=climate->file_temp.n*(year-firstyear);
-    for(j=0;j<climate->file_temp.n;j++)
-      store->temp[count++]=climate->data.temp[j];
-    count=climate->file_prec.n*(year-firstyear);
-    for(j=0;j<climate->file_prec.n;j++)
-      store->prec[count++]=climate->data.prec[j];
-    if(store->sun!=NULL)
-    {
-      count=climate->file_cloud.n*(year-firstyear);
-      for(j=0;j<climate->file_cloud.n;j++)
-        store->sun[count++]=climate->data.sun[j];
-    }
-    if(store->tmax!=NULL)
-    {
-      count=climate->file_tmax.n*(year-firstyear);
-      for(j=0;j<climate->file_tmax.n;j++)
-        store->tmax[count++]=climate->data.tmax[j];
-    }
-    if(store->humid!=NULL)
-    {
-      count=climate->file_humid.n*(year-firstyear);
-      for(j=0;j<climate->file_humid.n;j++)
-        store->humid[count++]=climate->data.humid[j];
-    }
-    if(store->tmin!=NULL)
-    {
-      count=climate->file_tmin.n*(year-firstyear);
-      for(j=0;j<climate->file_tmin.n;j++)
-        store->tmin[count++]=climate->data.tmin[j];
-    }
-    if(store->lwnet!=NULL)
-    {
-      count=climate->file_lwnet.n*(year-firstyear);
-      for(j=0;j<climate->file_lwnet.n;j++)
-        store->lwnet[count++]=climate->data.lwnet[j];
-    }
-    if(store->swdown!=NULL)
-    {
-      count=climate->file_swdown.n*(year-firstyear);
-      for(j=0;j<climate->file_swdown.n;j++)
-        store->swdown[count++]=climate->data.swdown[j];
-    }
-    if(store->wet!=NULL)
-    {
-      count=climate->file_wet.n*(year-firstyear);
-      for(j=0;j<climate->file_wet.n;j++)
-        store->wet[count++]=climate->data.wet[j];
-    }
-    if(store->wind!=NULL)
-    {
-      count=climate->file_wind.n*(year-firstyear);
-      for(j=0;j<climate->file_wind.n;j++)
-        store->wind[count++]=climate->data.wind[j];
-    }
-    if(store->tamp!=NULL)
-    {
-      count=climate->file_tamp.n*(year-firstyear);
-      for(j=0;j<climate->file_tamp.n;j++)
-        store->tamp[count++]=climate->data.tamp[j];
-    }
-    if(store->burntarea!=NULL)
-    {
-      count=climate->file_burntarea.n*(year-firstyear);
-      for(j=0;j<climate->file_burntarea.n;j++)
-        store->burntarea[count++]=climate->data.burntarea[j];
-    }
+    if(encodestore(&store->temp,climate->data.temp,nyear,year-firstyear,grid,config))
+      return TRUE;
+    if(encodestore(&store->prec,climate->data.prec,nyear,year-firstyear,grid,config))
+      return TRUE;
+    if(store->sun.data!=NULL && encodestore(&store->sun,climate->data.sun,nyear,year-firstyear,grid,config))
+      return TRUE;
+    if(store->tmax.data!=NULL && encodestore(&store->tmax,climate->data.tmax,nyear,year-firstyear,grid,config))
+      return TRUE;
+    if(store->humid.data!=NULL && encodestore(&store->humid,climate->data.humid,nyear,year-firstyear,grid,config))
+      return TRUE;
+    if(store->tmin.data!=NULL && encodestore(&store->tmin,climate->data.tmin,nyear,year-firstyear,grid,config))
+      return TRUE;
+    if(store->lwnet.data!=NULL && encodestore(&store->lwnet,climate->data.lwnet,nyear,year-firstyear,grid,config))
+      return TRUE;
+    if(store->swdown.data!=NULL && encodestore(&store->swdown,climate->data.swdown,nyear,year-firstyear,grid,config))
+      return TRUE;
+    if(store->wet.data!=NULL && encodestore(&store->wet,climate->data.wet,nyear,year-firstyear,grid,config))
+      return TRUE;
+    if(store->wind.data!=NULL && encodestore(&store->wind,climate->data.wind,nyear,year-firstyear,grid,config))
+      return TRUE;
+    if(store->tamp.data!=NULL && encodestore(&store->tamp,climate->data.tamp,nyear,year-firstyear,grid,config))
+      return TRUE;
+    if(store->burntarea.data!=NULL && encodestore(&store->burntarea,climate->data.burntarea,nyear,year-firstyear,grid,config))
+      return TRUE;
   }
   return FALSE;
 } /* of 'storeclimate' */
 
-void restoreclimate(Climate *climate,         /**< pointer to climate data */
-                    const Climatedata *store, /**< pointer to climate data */
-                    int year                  /**< year (AD) */
-                    )                         /** \return void*/
+void restoreclimate(Climate *climate,          /**< pointer to climate data */
+                    const Climatestore *store, /**< pointer to stored climate data */
+                    int year                   /**< year index */
+                    )                          /** \return void*/
 {
-  int i;
-  long index;
-  index=year*climate->file_temp.n;
-  for(i=0;i<climate->file_temp.n;i++)
-    climate->data.temp[i]=store->temp[index++];
-  index=year*climate->file_prec.n;
-  for(i=0;i<climate->file_prec.n;i++)
-    climate->data.prec[i]=store->prec[index++];
-  if(store->tmax!=NULL)
-  {
-    index=year*climate->file_tmax.n;
-    for(i=0;i<climate->file_tmax.n;i++)
-      climate->data.tmax[i]=store->tmax[index++];
-  }
-  if(store->humid!=NULL)
-  {
-    index=year*climate->file_humid.n;
-    for(i=0;i<climate->file_humid.n;i++)
-      climate->data.humid[i]=store->humid[index++];
-  }
-  if(store->tmin!=NULL)
-  {
-    index=year*climate->file_tmin.n;
-    for(i=0;i<climate->file_tmin.n;i++)
-      climate->data.tmin[i]=store->tmin[index++];
-  }
-  if(store->sun!=NULL)
-  {
-    index=year*climate->file_cloud.n;
-    for(i=0;i<climate->file_cloud.n;i++)
-      climate->data.sun[i]=store->sun[index++];
-  }
-  if(store->lwnet!=NULL)
-  {
-    index=year*climate->file_lwnet.n;
-    for(i=0;i<climate->file_lwnet.n;i++)
-      climate->data.lwnet[i]=store->lwnet[index++];
-  }
-  if(store->swdown!=NULL)
-  {
-    index=year*climate->file_swdown.n;
-    for(i=0;i<climate->file_swdown.n;i++)
-      climate->data.swdown[i]=store->swdown[index++];
-  }
-  if(store->wet!=NULL)
-  {
-    index=year*climate->file_wet.n;
-    for(i=0;i<climate->file_wet.n;i++)
-      climate->data.wet[i]=store->wet[index++];
-  }
-  if(store->wind!=NULL)
-  {
-    index=year*climate->file_wind.n;
-    for(i=0;i<climate->file_wind.n;i++)
-      climate->data.wind[i]=store->wind[index++];
-  }
-  if(store->tamp!=NULL)
-  {
-    index=year*climate->file_tamp.n;
-    for(i=0;i<climate->file_tamp.n;i++)
-      climate->data.tamp[i]=store->tamp[index++];
-  }
-  if(store->burntarea!=NULL)
-  {
-    index=year*climate->file_burntarea.n;
-    for(i=0;i<climate->file_burntarea.n;i++)
-      climate->data.burntarea[i]=store->burntarea[index++];
-  }
+  decodestore(climate->data.temp,&store->temp,year);
+  decodestore(climate->data.prec,&store->prec,year);
+  if(store->tmax.data!=NULL)
+    decodestore(climate->data.tmax,&store->tmax,year);
+  if(store->humid.data!=NULL)
+    decodestore(climate->data.humid,&store->humid,year);
+  if(store->tmin.data!=NULL)
+    decodestore(climate->data.tmin,&store->tmin,year);
+  if(store->sun.data!=NULL)
+    decodestore(climate->data.sun,&store->sun,year);
+  if(store->lwnet.data!=NULL)
+    decodestore(climate->data.lwnet,&store->lwnet,year);
+  if(store->swdown.data!=NULL)
+    decodestore(climate->data.swdown,&store->swdown,year);
+  if(store->wet.data!=NULL)
+    decodestore(climate->data.wet,&store->wet,year);
+  if(store->wind.data!=NULL)
+    decodestore(climate->data.wind,&store->wind,year);
+  if(store->tamp.data!=NULL)
+    decodestore(climate->data.tamp,&store->tamp,year);
+  if(store->burntarea.data!=NULL)
+    decodestore(climate->data.burntarea,&store->burntarea,year);
 } /* of 'restoreclimate' */
 
-void moveclimate(Climate *climate,  /**< Pointer to climate data */
-                 const Climatedata *store, /**< climate buffer */
-                 int year           /**< year (AD) */
-                 )                  /** \return void */
+void moveclimate(Climate *climate,          /**< Pointer to climate data */
+                 const Climatestore *store, /**< climate buffer */
+                 int year                   /**< year index */
+                 )                          /** \return void */
 {
-  climate->data.prec=store->prec+climate->file_prec.n*year;
-  climate->data.temp=store->temp+climate->file_temp.n*year;
-  if(climate->data.tmax!=NULL)
-    climate->data.tmax=store->tmax+climate->file_tmax.n*year;
-  if(climate->data.humid!=NULL)
-    climate->data.humid=store->humid+climate->file_humid.n*year;
-  if(climate->data.tmin!=NULL)
-    climate->data.tmin=store->tmin+climate->file_tmin.n*year;
-  if(climate->data.sun!=NULL)
-    climate->data.sun=store->sun+climate->file_cloud.n*year;
-  if(climate->data.lwnet!=NULL)
-    climate->data.lwnet=store->lwnet+climate->file_lwnet.n*year;
-  if(climate->data.swdown!=NULL)
-    climate->data.swdown=store->swdown+climate->file_swdown.n*year;
-  if(climate->data.wet!=NULL)
-    climate->data.wet=store->wet+climate->file_wet.n*year;
-  if(climate->data.wind!=NULL)
-    climate->data.wind=store->wind+climate->file_wind.n*year;
-  if(climate->data.tamp!=NULL)
-    climate->data.tamp=store->tamp+climate->file_tamp.n*year;
-  if(climate->data.burntarea!=NULL)
-    climate->data.burntarea=store->burntarea+climate->file_burntarea.n*year;
+  /* stored data are decoded into climate data arrays */
+  restoreclimate(climate,store,year);
 } /* of 'moveclimate' */
+
+void freeclimatestore(Climatestore *store /**< pointer to stored climate data */
+                     )                    /** \return void */
+{
+  free(store->temp.data);
+  free(store->prec.data);
+  free(store->tmax.data);
+  free(store->humid.data);
+  free(store->tmin.data);
+  free(store->sun.data);
+  free(store->lwnet.data);
+  free(store->swdown.data);
+  free(store->wet.data);
+  free(store->wind.data);
+  free(store->tamp.data);
+  free(store->burntarea.data);
+} /* of 'freeclimatestore' */
@@ -34,4 +34,5 @@ void close_coupler(Bool errorcode,      /**< error code (0= no error) */
 #endif
     }
   }
+  closeshm_coupler(config);
 } /* of 'close_coupler' */
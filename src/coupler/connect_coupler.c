@@ -15,12 +15,13 @@
 
 #include "lpj.h"
 
-Socket *connect_coupler(int port, /**< socket port */
-                        int wait  /**< time to wait (sec) */
-                       )          /** \return pointer to open socket or NULL */
+Socket *connect_coupler(int port,    /**< socket port */
+                        int wait,    /**< time to wait (sec) */
+                        int *version /**< protocol version sent by LPJmL */
+                       )             /** \return pointer to open socket or NULL */
 {
   Socket *socket;
-  int version,my_version=COUPLER_VERSION;
+  int my_version;
   socket=opentdt_socket(port,wait);
   if(socket==NULL)
   {
@@ -29,13 +30,17 @@ Socket *connect_coupler(int port, /**< socket port */
     return NULL;
   }
   /* Get protocol version */
-  readint_socket(socket,&version,1);
-  if(version>3)
+  readint_socket(socket,version,1);
+  if(*version>3)
+  {
+    /* confirm version if supported, version 3 expects no reply */
+    my_version=(*version<=COUPLER_VERSION) ? *version : COUPLER_VERSION;
     writeint_socket(socket,&my_version,1);
-  if(version!=COUPLER_VERSION)
+  }
+  if(*version<COUPLER_VERSION_MIN || *version>COUPLER_VERSION)
   {
-    fprintf(stderr,"Unsupported coupler version %d, must be %d.\n",
-            version,COUPLER_VERSION);
+    fprintf(stderr,"Unsupported coupler version %d, must be in [%d,%d].\n",
+            *version,COUPLER_VERSION_MIN,COUPLER_VERSION);
     close_socket(socket);
     return NULL;
   }
@@ -32,65 +32,81 @@ static void alarmhandler(int UNUSED(num))
   fail(OPEN_COUPLER_ERR,FALSE,"Timeout in connection to %s",coupled_model);
 } /* of 'alarmhandler' */
 
-Bool open_coupler(Config *config /**< LPJmL configuration */
-                 )               /** \return TRUE on error */
+static Bool opensocket(Config *config /**< LPJmL configuration */
+                      )               /** \return TRUE on error */
 {
-  int version=COUPLER_VERSION;
+  int version;
   Type type=LPJ_INT;
-  if(isroot(*config))
-  {
 
-    /* Establish the TDT connection */
-    printf("Connecting to %s model...\n",config->coupled_model);
-    coupled_model=config->coupled_model;
-    fflush(stdout);
-    if(config->wait)
-    {
+  /* Establish the TDT connection */
+  printf("Connecting to %s model...\n",config->coupled_model);
+  coupled_model=config->coupled_model;
+  fflush(stdout);
+  if(config->wait)
+  {
 #ifndef _WIN32
-      /* set alarm timer */
-      signal(SIGALRM,alarmhandler);
-      alarm(config->wait);
+    /* set alarm timer */
+    signal(SIGALRM,alarmhandler);
+    alarm(config->wait);
 #endif
-    }
-    config->socket=connecttdt_socket(config->coupled_host,config->coupler_port);
+  }
+  config->socket=connecttdt_socket(config->coupled_host,config->coupler_port);
 #ifndef _WIN32
-    if(config->wait)
-    {
-      /* disable alarm handler */
-      alarm(0);
-      signal(SIGALRM,SIG_DFL);
-    }
+  if(config->wait)
+  {
+    /* disable alarm handler */
+    alarm(0);
+    signal(SIGALRM,SIG_DFL);
+  }
 #endif
-    if(config->socket==NULL)
-      return TRUE;
+  if(config->socket==NULL)
+    return TRUE;
 #ifndef _WIN32
-    signal(SIGPIPE,handler);
+  signal(SIGPIPE,handler);
 #endif
-    /* send coupler version */
-    writeint_socket(config->socket,&version,1);
-    if(version>3)
+  /* send coupler version */
+  writeint_socket(config->socket,&config->coupler_version,1);
+  if(config->coupler_version>3)
+  {
+    /* receive version from coupled model, version 3 models do not reply */
+    readint_socket(config->socket,&version,1);
+    if(version!=config->coupler_version)
     {
-      /* receive version from coupled model */
-      readint_socket(config->socket,&version,1);
-      if(version!=COUPLER_VERSION)
-      {
-        fprintf(stderr,"ERROR312: Invalid coupler version %d received from %s, must be %d.\n",
-                version,config->coupled_model,COUPLER_VERSION);
-        return TRUE;
-      }
-      /* send 5 integer values */
-      send_token_coupler(PUT_INIT_DATA,5,config);
-      writeint_socket(config->socket,&type,1);
-      /* send first index of cell */
-      writeint_socket(config->socket,&config->firstgrid,1);
-      /* send total number of cells */
-      writeint_socket(config->socket,&config->nall,1);
+      fprintf(stderr,"ERROR312: Invalid coupler version %d received from %s, must be %d, set %s to version of coupled model.\n",
+              version,config->coupled_model,config->coupler_version,LPJCOUPLERVERSION);
+      return TRUE;
     }
-    /* send number of cells with valid soil code */
-    writeint_socket(config->socket,&config->total,1);
-    /* send number of input and output streams */
-    writeint_socket(config->socket,&config->coupler_in,1);
-    writeint_socket(config->socket,&config->coupler_out,1);
+    /* send 5 integer values */
+    send_token_coupler(PUT_INIT_DATA,5,config);
+    writeint_socket(config->socket,&type,1);
+    /* send first index of cell */
+    writeint_socket(config->socket,&config->firstgrid,1);
+    /* send total number of cells */
+    writeint_socket(config->socket,&config->nall,1);
+  }
+  /* send number of cells with valid soil code */
+  writeint_socket(config->socket,&config->total,1);
+  /* send number of input and output streams */
+  writeint_socket(config->socket,&config->coupler_in,1);
+  writeint_socket(config->socket,&config->coupler_out,1);
+  return FALSE;
+} /* of 'opensocket' */
+
+Bool open_coupler(Config *config /**< LPJmL configuration */
+                 )               /** \return TRUE on error */
+{
+  Bool rc;
+  rc=(isroot(*config)) ? opensocket(config) : FALSE;
+  if(iserror(rc,config))
+    return TRUE;
+  if(config->coupler_version<COUPLER_VERSION_SHM && (config->shm_size || config->coupler_batch))
+  {
+    /* coupled model does not know PUT_SHM and PUT_DATA_BATCH tokens */
+    if(isroot(*config))
+      fprintf(stderr,"WARNING049: Coupler version %d set for %s model, shared memory and batched output require version %d and are disabled.\n",
+              config->coupler_version,config->coupled_model,COUPLER_VERSION_SHM);
+    config->shm_size=0;
+    config->coupler_batch=FALSE;
   }
   return FALSE;
 } /* of 'open_coupler' */
@@ -34,16 +34,17 @@ Bool openinput_coupler(int id,              /**< id of input stream */
     printf(", done.\n");
     fflush(stdout);
 #endif
-#if COUPLER_VERSION == 4
+    if(config->coupler_version>=4)
+    {
 #ifdef DEBUG_COUPLER
-    printf("Sending ncell=%d",ncell);
+      printf("Sending ncell=%d",ncell);
 #endif
-    writeint_socket(config->socket,&ncell,1);
+      writeint_socket(config->socket,&ncell,1);
 #ifdef DEBUG_COUPLER
-    printf(", done.\n");
-    fflush(stdout);
-#endif
+      printf(", done.\n");
+      fflush(stdout);
 #endif
+    }
 #ifdef DEBUG_COUPLER
     printf("Receiving nbands");
     fflush(stdout);
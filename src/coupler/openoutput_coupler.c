@@ -29,9 +29,8 @@ Bool openoutput_coupler(int id,              /**< id of output stream */
   printf("Sending ncell=%d, nstep=%d, nbands=%d, type=%s",ncell,nstep,nbands,typenames[type]);
   fflush(stdout);
 #endif
-#if COUPLER_VERSION == 4
-  writeint_socket(config->socket,&ncell,1);
-#endif
+  if(config->coupler_version>=4)
+    writeint_socket(config->socket,&ncell,1);
   writeint_socket(config->socket,&nstep,1);
   writeint_socket(config->socket,&nbands,1);
   writeint_socket(config->socket,&type,1);
@@ -30,12 +30,21 @@ Bool receive_coupler(int index,           /**< index of input file */
 #ifdef USE_MPI
   int *counts;
   int *offsets;
-#if COUPLER_VERSION == 4
   int rc;
-#endif
 #else
   int rc=TRUE;
 #endif
+  const void *shmdata;
+  if(config->shm!=NULL)
+  {
+    /* data of task is copied directly from shared memory */
+    shmdata=receiveshm_coupler(index,type,size,year,config);
+    if(shmdata==NULL)
+      return TRUE;
+    memcpy(data,shmdata,(size_t)config->ngridcell*size*typesizes[type]);
+    releaseshm_coupler(config);
+    return FALSE;
+  }
   if(isroot(*config))
   {
     send_token_coupler(GET_DATA,index,config);
@@ -48,27 +57,29 @@ Bool receive_coupler(int index,           /**< index of input file */
     printf(", done.\n");
     fflush(stdout);
 #endif
-#if COUPLER_VERSION == 4
+    if(config->coupler_version>=4)
+    {
 #ifdef DEBUG_COUPLER
-    printf("Receiving status");
-    fflush(stdout);
+      printf("Receiving status");
+      fflush(stdout);
 #endif
-    readint_socket(config->socket,&rc,1);
+      readint_socket(config->socket,&rc,1);
 #ifdef DEBUG_COUPLER
-    printf(", %d received.\n",rc);
-    fflush(stdout);
-#endif
-    if(rc!=COUPLER_OK)
-      fprintf(stderr,"ERROR312: Cannot receive data from socket.\n");
+      printf(", %d received.\n",rc);
+      fflush(stdout);
 #endif
+      if(rc!=COUPLER_OK)
+        fprintf(stderr,"ERROR312: Cannot receive data from socket.\n");
+    }
   }
-#if COUPLER_VERSION == 4
+  if(config->coupler_version>=4)
+  {
 #ifdef USE_MPI
-  MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
-#endif
-  if(rc!=COUPLER_OK)
-    return TRUE;
+    MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
 #endif
+    if(rc!=COUPLER_OK)
+      return TRUE;
+  }
 #ifdef DEBUG_COUPLER
   if(isroot(*config))
   {
@@ -81,7 +92,7 @@ Bool receive_coupler(int index,           /**< index of input file */
   check(counts);
   offsets=newvec(int,config->ntask);
   check(offsets);
-  getcounts(counts,offsets,config->nall,size,config->ntask);
+  getcellcounts(counts,offsets,size,config);
   if(mpi_read_socket(config->socket,data,mpi_types[type],config->nall*size,
                      counts,offsets,config->rank,config->comm))
   {
@@ -22,7 +22,19 @@ Bool receive_real_coupler(int index,           /**< index of input file */
                          )                     /** \return TRUE on error */
 {
   float *f;
+  const float *shmdata;
   int i;
+  if(config->shm!=NULL)
+  {
+    /* convert data of task in place from shared memory */
+    shmdata=receiveshm_coupler(index,LPJ_FLOAT,size,year,config);
+    if(shmdata==NULL)
+      return TRUE;
+    for(i=0;i<config->ngridcell*size;i++)
+      data[i]=shmdata[i];
+    releaseshm_coupler(config);
+    return FALSE;
+  }
   f=newvec(float,config->ngridcell*size);
   check(f);
   if(receive_coupler(index,f,LPJ_FLOAT,size,year,config))
@@ -22,34 +22,34 @@ Bool receive_scalar_coupler(int index,           /**< index of input stream */
                             const Config *config /**< LPJmL configuration */
                            )                     /** \return TRUE on error */
 {
-#if COUPLER_VERSION == 4
   int rc;
-#endif
   if(isroot(*config))
   {
     send_token_coupler(GET_DATA,index,config);
     writeint_socket(config->socket,&year,1);
-#if COUPLER_VERSION == 4
+    if(config->coupler_version>=4)
+    {
 #ifdef DEBUG_COUPLER
-    printf("Receiving status");
-    fflush(stdout);
+      printf("Receiving status");
+      fflush(stdout);
 #endif
-    readint_socket(config->socket,&rc,1);
+      readint_socket(config->socket,&rc,1);
 #ifdef DEBUG_COUPLER
-    printf(", %d received.\n",rc);
-    fflush(stdout);
-#endif
-    if(rc!=COUPLER_OK)
-      fprintf(stderr,"ERROR312: Cannot receive data from socket.\n");
+      printf(", %d received.\n",rc);
+      fflush(stdout);
 #endif
+      if(rc!=COUPLER_OK)
+        fprintf(stderr,"ERROR312: Cannot receive data from socket.\n");
+    }
   }
-#if COUPLER_VERSION == 4
+  if(config->coupler_version>=4)
+  {
 #ifdef USE_MPI
-  MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
-#endif
-  if(rc!=COUPLER_OK)
-    return TRUE;
+    MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
 #endif
+    if(rc!=COUPLER_OK)
+      return TRUE;
+  }
   if(isroot(*config))
   {
 #ifdef DEBUG_COUPLER
@@ -17,7 +17,8 @@
 
 Bool receive_token_coupler(Socket *socket, /**< pointer to open socket */
                            Token *token,   /**< token received */
-                           int *index      /**< index received */
+                           int *index,     /**< index received */
+                           int version     /**< protocol version of LPJmL */
                           )                /** \return TRUE on error */
 {
 #ifdef DEBUG_COUPLER
@@ -25,7 +26,7 @@ Bool receive_token_coupler(Socket *socket, /**< pointer to open socket */
   fflush(stdout);
 #endif
   readint_socket(socket,(int *)token,1);
-  if(*token<0 || *token>PUT_INIT_DATA)
+  if(*token<0 || *token>PUT_DATA_BATCH)
   {
     fprintf(stderr,"Invalid token %d.\n",(int)*token);
     return TRUE;
@@ -36,21 +37,22 @@ Bool receive_token_coupler(Socket *socket, /**< pointer to open socket */
 #endif
   if(*token==FAIL_DATA)
   {
-#if COUPLER_VERSION == 4
-    /* get LPJmL error code */
+    if(version>=4)
+    {
+      /* get LPJmL error code */
 #ifdef DEBUG_COUPLER
-    printf("Receiving error code");
-    fflush(stdout);
+      printf("Receiving error code");
+      fflush(stdout);
 #endif
-    readint_socket(socket,index,1);
+      readint_socket(socket,index,1);
 #ifdef DEBUG_COUPLER
-    printf(", %d received.\n",*index);
-    fflush(stdout);
-#endif
-    fprintf(stderr,"LPJmL stopped with error %d.\n",*index);
-#else
-    fprintf(stderr,"LPJmL stopped with error.\n");
+      printf(", %d received.\n",*index);
+      fflush(stdout);
 #endif
+      fprintf(stderr,"LPJmL stopped with error %d.\n",*index);
+    }
+    else
+      fprintf(stderr,"LPJmL stopped with error.\n");
     return TRUE;
   }
   if(*token!=END_DATA && *token!=GET_STATUS)
@@ -25,8 +25,7 @@ void send_output_coupler(int index,           /**< index of output stream */
   {
     send_token_coupler(PUT_DATA,index,config);
     writeint_socket(config->socket,&year,1);
-#if COUPLER_VERSION == 4
-    writeint_socket(config->socket,&step,1);
-#endif
+    if(config->coupler_version>=4)
+      writeint_socket(config->socket,&step,1);
   }
 } /* of 'send_output_coupler' */
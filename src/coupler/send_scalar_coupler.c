@@ -24,13 +24,10 @@ Bool send_scalar_coupler(int index,           /**< index of output stream */
                          const Config *config /**< LPJ configuration */
                         )                     /** \return TRUE on error */
 {
-#if COUPLER_VERSION == 4
   int date=0;
-#endif
   send_token_coupler(PUT_DATA,index,config);
   writeint_socket(config->socket,&year,1);
-#if COUPLER_VERSION == 4
-  writeint_socket(config->socket,&date,1);
-#endif
+  if(config->coupler_version>=4)
+    writeint_socket(config->socket,&date,1);
   return write_socket(config->socket,data,typesizes[type]*size);
 } /* of 'send_scalar_coupler' */
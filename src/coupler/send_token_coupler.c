@@ -17,7 +17,8 @@
 #include "lpj.h"
 
 char *token_names[]={"GET_DATA","PUT_DATA","GET_DATA_SIZE","PUT_DATA_SIZE",
-                     "END_DATA","GET_STATUS","FAIL_DATA","PUT_INIT_DATA"};
+                     "END_DATA","GET_STATUS","FAIL_DATA","PUT_INIT_DATA",
+                     "PUT_SHM","PUT_DATA_BATCH"};
 
 Bool send_token_coupler(Token token,         /**< Token (GET_DATA,PUT_DATA, ...) */
                         int index,           /**< index for in- or output stream */
@@ -25,7 +26,7 @@ Bool send_token_coupler(Token token,         /**< Token (GET_DATA,PUT_DATA, ...)
                        )                     /** \return TRUE on error */
 {
   Bool rc;
-  if(token<0 || token>PUT_INIT_DATA)
+  if(token<0 || token>PUT_DATA_BATCH)
   {
     fprintf(stderr,"ERROR310: Invalid token %d.\n",(int)token);
     return TRUE;
@@ -35,11 +36,8 @@ Bool send_token_coupler(Token token,         /**< Token (GET_DATA,PUT_DATA, ...)
   fflush(stdout);
 #endif
   writeint_socket(config->socket,&token,1);
-#if COUPLER_VERSION == 4
-  if(token!=END_DATA && token!=GET_STATUS)
-#else
-  if(token!=END_DATA && token!=FAIL_DATA && token!=GET_STATUS)
-#endif
+  /* error code is sent after FAIL_DATA since version 4 */
+  if(token!=END_DATA && token!=GET_STATUS && (token!=FAIL_DATA || config->coupler_version>=4))
     rc=writeint_socket(config->socket,&index,1);
   else
     rc=FALSE;
@@ -0,0 +1,225 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                   s  h  m  _  c  o  u  p  l  e  r  .  c                        \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Functions for receiving data from coupled model via POSIX shared           \n**/
+/**     memory. Root task creates the segment and sends its name to the            \n**/
+/**     coupled model. All tasks map the segment and read their part of            \n**/
+/**     the data in place instead of scattering it from the socket.                \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <stdatomic.h>
+#endif
+
+#ifndef _WIN32
+
+static Bool mapshm(Shmcoupler *shm,Bool create)
+{
+  int fd;
+  fd=shm_open(shm->name,(create) ? O_RDWR | O_CREAT | O_EXCL : O_RDWR,S_IRUSR | S_IWUSR);
+  if(fd==-1)
+    return TRUE;
+  if(create && ftruncate(fd,shm->size))
+  {
+    close(fd);
+    shm_unlink(shm->name);
+    return TRUE;
+  }
+  shm->header=mmap(NULL,shm->size,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+  close(fd);
+  if(shm->header==MAP_FAILED)
+  {
+    shm->header=NULL;
+    if(create)
+      shm_unlink(shm->name);
+    return TRUE;
+  }
+  shm->data=(char *)shm->header+SHM_HEADER_SIZE;
+  return FALSE;
+} /* of 'mapshm' */
+
+#endif
+
+Bool openshm_coupler(Config *config /**< LPJmL configuration */
+                    )               /** \return TRUE on error */
+{
+  /*
+   * Function tries to set up shared memory for data received from coupled
+   * model. If tasks do not share one node or coupled model does not
+   * support shared memory, data are received via socket.
+   */
+  Shmcoupler *shm;
+  int status;
+  Bool rc;
+#ifdef USE_MPI
+  MPI_Comm node;
+  int nnode;
+#endif
+  config->shm=NULL;
+  /* PUT_SHM token is only known by coupled models of version COUPLER_VERSION_SHM */
+  if(config->shm_size==0 || config->coupler_version<COUPLER_VERSION_SHM)
+    return FALSE;
+#ifdef _WIN32
+  if(isroot(*config))
+    fputs("WARNING047: Shared memory for coupler not supported, socket used.\n",stderr);
+  return FALSE;
+#else
+#ifdef USE_MPI
+#if MPI_VERSION>=3
+  MPI_Comm_split_type(config->comm,MPI_COMM_TYPE_SHARED,0,MPI_INFO_NULL,&node);
+  MPI_Comm_size(node,&nnode);
+  MPI_Comm_free(&node);
+#else
+  nnode=1;
+#endif
+  if(nnode<config->ntask)
+  {
+    if(isroot(*config))
+      fputs("WARNING047: Tasks do not share one node, socket used for coupler.\n",stderr);
+    return FALSE;
+  }
+#endif
+  shm=new(Shmcoupler);
+  check(shm);
+  shm->header=NULL;
+  shm->size=(size_t)config->shm_size*1024*1024;
+  status=COUPLER_OK;
+  if(isroot(*config))
+  {
+    snprintf(shm->name,sizeof(shm->name),"/lpjml.%d",(int)getpid());
+    if(mapshm(shm,TRUE))
+    {
+      fprintf(stderr,"WARNING047: Cannot create shared memory '%s' for coupler: %s, socket used.\n",
+              shm->name,strerror(errno));
+      status=COUPLER_ERR;
+    }
+    else
+    {
+      shm->header->version=config->coupler_version;
+      shm->header->size=(int)(shm->size-SHM_HEADER_SIZE);
+      shm->header->tail=0;
+      send_token_coupler(PUT_SHM,shm->header->size,config);
+      writestring_socket(config->socket,shm->name);
+      readint_socket(config->socket,&status,1);
+      if(status!=COUPLER_OK)
+      {
+        fprintf(stderr,"WARNING047: %s model does not support shared memory, socket used.\n",
+                config->coupled_model);
+        munmap(shm->header,shm->size);
+        shm_unlink(shm->name);
+        shm->header=NULL;
+      }
+    }
+  }
+#ifdef USE_MPI
+  MPI_Bcast(&status,1,MPI_INT,0,config->comm);
+  MPI_Bcast(shm->name,sizeof(shm->name),MPI_CHAR,0,config->comm);
+#endif
+  if(status!=COUPLER_OK)
+  {
+    free(shm);
+    return FALSE;
+  }
+  config->shm=shm;
+  if(!isroot(*config))
+  {
+    /* coupled model already writes into shared memory, so failure is an error */
+    rc=mapshm(shm,FALSE);
+    if(rc)
+      fprintf(stderr,"ERROR313: Cannot map shared memory '%s' for coupler: %s.\n",
+              shm->name,strerror(errno));
+  }
+  else
+    rc=FALSE;
+  if(iserror(rc,config))
+    return TRUE;
+  if(isroot(*config))
+    printf("Data from %s model received via shared memory '%s'.\n",
+           config->coupled_model,shm->name);
+  return FALSE;
+#endif
+} /* of 'openshm_coupler' */
+
+const void *receiveshm_coupler(int index,           /**< index of input stream */
+                               Type type,           /**< type of data */
+                               int size,            /**< number of items per cell */
+                               int year,            /**< year (AD) */
+                               const Config *config /**< LPJmL configuration */
+                              )                     /** \return pointer to data of task or NULL on error */
+{
+  int offset,rc;
+  if(isroot(*config))
+  {
+    send_token_coupler(GET_DATA,index,config);
+    writeint_socket(config->socket,&year,1);
+    /* shared memory requires version COUPLER_VERSION_SHM, so status is always sent */
+    readint_socket(config->socket,&rc,1);
+    if(rc!=COUPLER_OK)
+    {
+      fprintf(stderr,"ERROR312: Cannot receive data from socket.\n");
+      offset=-1;
+    }
+    else
+    {
+      /* data are already in shared memory, only offset is sent */
+      readint_socket(config->socket,&offset,1);
+      if(offset<0 || (long long)offset+(long long)config->nall*size*typesizes[type]>config->shm->header->size)
+      {
+        fprintf(stderr,"ERROR313: Invalid offset %d in shared memory for input %d.\n",offset,index);
+        offset=-1;
+      }
+    }
+  }
+#ifdef USE_MPI
+  MPI_Bcast(&offset,1,MPI_INT,0,config->comm);
+#endif
+  if(offset<0)
+    return NULL;
+  config->shm->tail=offset+config->nall*size*typesizes[type];
+  return config->shm->data+offset+(size_t)(config->startgrid-config->firstgrid)*size*typesizes[type];
+} /* of 'receiveshm_coupler' */
+
+void releaseshm_coupler(const Config *config /**< LPJmL configuration */
+                       )
+{
+  /* shared memory can be reused by coupled model after all tasks have read data */
+#ifdef USE_MPI
+  MPI_Barrier(config->comm);
+#endif
+  if(isroot(*config))
+  {
+#ifndef _WIN32
+    atomic_thread_fence(memory_order_seq_cst);
+#endif
+    config->shm->header->tail=config->shm->tail;
+  }
+} /* of 'releaseshm_coupler' */
+
+void closeshm_coupler(const Config *config /**< LPJmL configuration */
+                     )
+{
+#ifndef _WIN32
+  if(config->shm!=NULL)
+  {
+    if(config->shm->header!=NULL)
+      munmap(config->shm->header,config->shm->size);
+    if(isroot(*config))
+      shm_unlink(config->shm->name);
+    free(config->shm);
+  }
+#endif
+} /* of 'closeshm_coupler' */
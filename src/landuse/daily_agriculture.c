@@ -40,6 +40,7 @@ Real daily_agriculture(Stand *stand,                /**< [inout] stand pointer *
   int p,l,nnat,nirrig,index=-1;
   Pft *pft;
   Real *gp_pft;         /**< pot. canopy conductance for PFTs & CFTs (mm/s) */
+  Scratch *scratch;     /**< preallocated buffers of thread */
   Real gp_stand;               /**< potential stomata conductance  (mm/s) */
   Real gp_stand_leafon;        /**< pot. canopy conduct.at full leaf cover  (mm/s) */
   Real fpc_total_stand;
@@ -71,17 +72,12 @@ Real daily_agriculture(Stand *stand,                /**< [inout] stand pointer *
   output=&stand->cell->output;
   cover_stand=intercep_stand=intercep_stand_blue=wet_all=rw_apply=intercept=sprink_interc=rainmelt=irrig_apply=0.0;
   evap=evap_blue=runoff=return_flow_b=0.0;
-  if(getnpft(&stand->pftlist)>0)
-  {
-    wet=newvec(Real,getnpft(&stand->pftlist)); /* wet from pftlist */
-    check(wet);
-    for(p=0;p<getnpft(&stand->pftlist);p++)
-      wet[p]=0;
-  }
-  else
-    wet=NULL;
-  gp_pft=newvec(Real,npft+ncft);
-  check(gp_pft);
+  /* use preallocated buffers of thread instead of allocating vectors every day */
+  scratch=getscratch();
+  wet=scratch->wet; /* wet from pftlist */
+  for(p=0;p<getnpft(&stand->pftlist);p++)
+    wet[p]=0;
+  gp_pft=scratch->gp_pft;
   gp_stand=gp_sum(&stand->pftlist,co2,climate->temp,par,daylength,
                   &gp_stand_leafon,gp_pft,&fpc_total_stand,config);
 
@@ -137,9 +133,9 @@ Real daily_agriculture(Stand *stand,                /**< [inout] stand pointer *
       getoutputindex(output,PFT_NROOT,nnat+index,config)=crop->ind.root.nitrogen;
     if(!isannual(PFT_CROOT,config))
       getoutputindex(output,PFT_CROOT,nnat+index,config)=crop->ind.root.carbon;
-    if(!isannual(PFT_VEGN,config))
+    if(isoutput(PFT_VEGN,config) && !isannual(PFT_VEGN,config))
       getoutputindex(output,PFT_VEGN,nnat+index,config)=vegn_sum(pft);
-    if(!isannual(PFT_VEGC,config))
+    if(isoutput(PFT_VEGC,config) && !isannual(PFT_VEGC,config))
       getoutputindex(output,PFT_VEGC,nnat+index,config)=vegc_sum(pft);
 
     if(phenology_crop(pft,climate->temp,daylength,npft,config))
@@ -312,7 +308,8 @@ Real daily_agriculture(Stand *stand,                /**< [inout] stand pointer *
       getoutputindex(output,PFT_NPP,nnat+index,config)+=npp*stand->frac;
     else
       getoutputindex(output,PFT_NPP,nnat+index,config)+=npp;
-    getoutputindex(output,PFT_LAI,nnat+index,config)+=actual_lai_crop(pft);
+    if(isoutput(PFT_LAI,config))
+      getoutputindex(output,PFT_LAI,nnat+index,config)+=actual_lai_crop(pft);
     crop=pft->data;
     if(stand->type->landusetype==AGRICULTURE && config->separate_harvests)
     {
@@ -388,7 +385,6 @@ Real daily_agriculture(Stand *stand,                /**< [inout] stand pointer *
       p--;
     } /* of if(negbm) */
   } /* of foreachpft */
-  free(gp_pft);
   /* soil outflow: evap and transpiration */
   waterbalance(stand,aet_stand,green_transp,&evap,&evap_blue,wet_all,eeq,cover_stand,
                &frac_g_evap,config->rw_manage);
@@ -436,7 +432,5 @@ Real daily_agriculture(Stand *stand,                /**< [inout] stand pointer *
     }
   }
 
-  free(wet);
-
   return runoff;
 } /* of 'daily_agriculture' */
@@ -47,6 +47,7 @@ Real daily_agriculture_grass(Stand *stand,                /**< stand pointer */
   Real aet_stand[LASTLAYER];
   Real green_transp[LASTLAYER];
   Real *gp_pft;         /**< pot. canopy conductance for PFTs & CFTs (mm/s) */
+  Scratch *scratch;     /**< preallocated buffers of thread */
   Real gp_stand;               /**< potential stomata conductance  (mm/s) */
   Real gp_stand_leafon;        /**< pot. canopy conduct.at full leaf cover  (mm/s) */
   Real fpc_total_stand;
@@ -74,17 +75,12 @@ Real daily_agriculture_grass(Stand *stand,                /**< stand pointer */
   data = stand->data;
   output = &stand->cell->output;
   evap = evap_blue = cover_stand = intercep_stand = intercep_stand_blue = runoff = return_flow_b = wet_all = intercept = sprink_interc = 0;
-  if (getnpft(&stand->pftlist) > 0)
-  {
-    wet = newvec(Real, getnpft(&stand->pftlist)); /* wet from pftlist */
-    check(wet);
-    for (p = 0; p < getnpft(&stand->pftlist); p++)
-      wet[p] = 0;
-  }
-  else
-    wet = NULL;
-  gp_pft=newvec(Real,npft+ncft);
-  check(gp_pft);
+  /* use preallocated buffers of thread instead of allocating vectors every day */
+  scratch=getscratch();
+  wet=scratch->wet; /* wet from pftlist */
+  for(p=0;p<getnpft(&stand->pftlist);p++)
+    wet[p]=0;
+  gp_pft=scratch->gp_pft;
   gp_stand=gp_sum(&stand->pftlist,co2,climate->temp,par,daylength,
                   &gp_stand_leafon,gp_pft,&fpc_total_stand,config);
 
@@ -244,7 +240,6 @@ Real daily_agriculture_grass(Stand *stand,                /**< stand pointer */
     else
       getoutputindex(output,PFT_NPP,nnat+index,config)+=npp;
   } /* of foreachpft */
-  free(gp_pft);
   /* calculate water balance */
   waterbalance(stand, aet_stand, green_transp, &evap, &evap_blue, wet_all, eeq, cover_stand,
                  &frac_g_evap, config->rw_manage);
@@ -359,6 +354,5 @@ Real daily_agriculture_grass(Stand *stand,                /**< stand pointer */
              return_flow_b, aet_stand, green_transp,
              intercep_stand, intercep_stand_blue,
              index, data->irrigation, config);
-  free(wet);
   return runoff;
 } /* of 'daily_agriculture_grass' */
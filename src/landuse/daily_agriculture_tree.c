@@ -56,6 +56,7 @@ Real daily_agriculture_tree(Stand *stand,                /**< stand pointer */
   Pfttree *tree;
   Pfttreepar *treepar;
   Real *gp_pft;         /**< pot. canopy conductance for PFTs & CFTs (mm/s) */
+  Scratch *scratch;     /**< preallocated buffers of thread */
   Real gp_stand;        /**< potential stomata conductance  (mm/s) */
   Real gp_stand_leafon; /**< pot. canopy conduct.at full leaf cover  (mm/s) */
   Real fpc_total_stand;
@@ -84,6 +85,8 @@ Real daily_agriculture_tree(Stand *stand,                /**< stand pointer */
   Bool iscotton;
   irrig_apply=0.0;
 
+  /* use preallocated buffers of thread instead of allocating vectors every day */
+  scratch=getscratch();
   soil = &stand->soil;
   data=stand->data;
   output=&stand->cell->output;
@@ -104,8 +107,7 @@ Real daily_agriculture_tree(Stand *stand,                /**< stand pointer */
     foreachpft(pft,p,&stand->pftlist)
       if(pft->par->type==GRASS)
         fpc_grass(pft);
-    fpc_type=newvec(Real,config->ntypes);
-    check(fpc_type);
+    fpc_type=scratch->fpc_type;
 
     fpc_sum(fpc_type,config->ntypes,&stand->pftlist);
     foreachpft(pft,p,&stand->pftlist)
@@ -116,20 +118,12 @@ Real daily_agriculture_tree(Stand *stand,                /**< stand pointer */
       foreachpft(pft,p,&stand->pftlist)
         if(pft->par->type==GRASS)
           reduce(&stand->soil.litter,pft,fpc_type[GRASS]/(1+fpc_type[GRASS]-fpc_total),config);
-    free(fpc_type);
     albedo_stand(stand);
   }
-  if(getnpft(&stand->pftlist)>0)
-  {
-    wet=newvec(Real,getnpft(&stand->pftlist)); /* wet from pftlist */
-    check(wet);
-    for(p=0;p<getnpft(&stand->pftlist);p++)
-      wet[p]=0;
-  }
-  else
-     wet=NULL;
-  gp_pft=newvec(Real,npft+ncft);
-  check(gp_pft);
+  wet=scratch->wet; /* wet from pftlist */
+  for(p=0;p<getnpft(&stand->pftlist);p++)
+    wet[p]=0;
+  gp_pft=scratch->gp_pft;
   gp_stand=gp_sum(&stand->pftlist,co2,climate->temp,par,daylength,
                   &gp_stand_leafon,gp_pft,&fpc_total_stand,config);
 
@@ -323,9 +317,9 @@ Real daily_agriculture_tree(Stand *stand,                /**< stand pointer */
     }
     else
       getoutputindex(output,PFT_NPP,nnat+index,config)+=npp;
-    getoutputindex(output,PFT_LAI,nnat+index,config)+=actual_lai(pft);
+    if(isoutput(PFT_LAI,config))
+      getoutputindex(output,PFT_LAI,nnat+index,config)+=actual_lai(pft);
   } /* of foreachpft */
-  free(gp_pft);
   /* soil outflow: evap and transpiration */
   waterbalance(stand,aet_stand,green_transp,&evap,&evap_blue,wet_all,eeq,cover_stand,
                &frac_g_evap,config->rw_manage);
@@ -420,7 +414,6 @@ Real daily_agriculture_tree(Stand *stand,                /**< stand pointer */
   }
   if(data->irrigation.irrigation && stand->pftlist.n>0) /*second element to avoid irrigation on just harvested fields */
     calc_nir(stand,&data->irrigation,gp_stand,wet,eeq,config->others_to_crop);
-  free(wet);
 
   return runoff;
 } /* of 'daily_agriculture_tree' */
@@ -40,6 +40,7 @@ Real daily_biomass_grass(Stand *stand,                /**< stand pointer */
   int p,l,n_pft,nnat;
   Pft *pft;
   Real *gp_pft;         /**< pot. canopy conductance for PFTs & CFTs (mm/s) */
+  Scratch *scratch;     /**< preallocated buffers of thread */
   Real gp_stand;               /**< potential stomata conductance  (mm/s) */
   Real gp_stand_leafon;        /**< pot. canopy conduct.at full leaf cover  (mm/s) */
   Real fpc_total_stand;
@@ -75,17 +76,12 @@ Real daily_biomass_grass(Stand *stand,                /**< stand pointer */
   output=&stand->cell->output;
   evap=evap_blue=cover_stand=intercep_stand=intercep_stand_blue=runoff=return_flow_b=wet_all=intercept=sprink_interc=0;
   n_pft=getnpft(&stand->pftlist);
-  if(n_pft>0)
-  {
-    wet=newvec(Real,getnpft(&stand->pftlist)); /* wet from pftlist */
-    check(wet);
-    for(p=0;p<getnpft(&stand->pftlist);p++)
-      wet[p]=0;
-  }
-  else
-    wet=NULL;
-  gp_pft=newvec(Real,npft+ncft);
-  check(gp_pft);
+  /* use preallocated buffers of thread instead of allocating vectors every day */
+  scratch=getscratch();
+  wet=scratch->wet; /* wet from pftlist */
+  for(p=0;p<getnpft(&stand->pftlist);p++)
+    wet[p]=0;
+  gp_pft=scratch->gp_pft;
   gp_stand=gp_sum(&stand->pftlist,co2,climate->temp,par,daylength,
                   &gp_stand_leafon,gp_pft,&fpc_total_stand,config);
 
@@ -236,11 +232,11 @@ Real daily_biomass_grass(Stand *stand,                /**< stand pointer */
       getoutputindex(output,PFT_NPP,nnat+index,config)+=npp*stand->frac;
     else
       getoutputindex(output,PFT_NPP,nnat+index,config)+=npp;
-    getoutputindex(output,PFT_LAI,nnat+index,config)+=actual_lai(pft);
+    if(isoutput(PFT_LAI,config))
+      getoutputindex(output,PFT_LAI,nnat+index,config)+=actual_lai(pft);
   } /* of foreachpft */
 
   /* calculate water balance */
-  free(gp_pft);
   waterbalance(stand,aet_stand,green_transp,&evap,&evap_blue,wet_all,eeq,cover_stand,
                &frac_g_evap,config->rw_manage);
 
@@ -249,8 +245,7 @@ Real daily_biomass_grass(Stand *stand,                /**< stand pointer */
   {
     if(n_pft>0)
     {
-      fpc_inc=newvec(Real,n_pft);
-      check(fpc_inc);
+      fpc_inc=scratch->fpc_inc;
 
       foreachpft(pft,p,&stand->pftlist)
       {
@@ -287,7 +282,6 @@ Real daily_biomass_grass(Stand *stand,                /**< stand pointer */
         }
       }
       light(stand,fpc_inc,config);
-      free(fpc_inc);
     }
   }
   else
@@ -388,6 +382,5 @@ Real daily_biomass_grass(Stand *stand,                /**< stand pointer */
 
   output_gbw(output,stand,frac_g_evap,evap,evap_blue,return_flow_b,aet_stand,green_transp,
              intercep_stand,intercep_stand_blue,index,data->irrigation,config);
-  free(wet);
   return runoff;
 } /* of 'daily_biomass_grass' */
@@ -39,6 +39,7 @@ Real daily_biomass_tree(Stand *stand,                /**< stand pointer */
   int p,l,nnat,nirrig;
   Pft *pft;
   Real *gp_pft;         /**< pot. canopy conductance for PFTs & CFTs (mm/s) */
+  Scratch *scratch;     /**< preallocated buffers of thread */
   Real gp_stand;               /**< potential stomata conductance  (mm/s) */
   Real gp_stand_leafon;        /**< pot. canopy conduct.at full leaf cover  (mm/s) */
   Real fpc_total_stand;
@@ -68,17 +69,12 @@ Real daily_biomass_tree(Stand *stand,                /**< stand pointer */
   output=&stand->cell->output;
   stand->growing_days++;
   evap=evap_blue=cover_stand=intercep_stand=intercep_stand_blue=runoff=return_flow_b=wet_all=intercept=sprink_interc=rainmelt=irrig_apply=0.0;
-  if(getnpft(&stand->pftlist)>0)
-  {
-    wet=newvec(Real,getnpft(&stand->pftlist)); /* wet from pftlist */
-    check(wet);
-    for(p=0;p<getnpft(&stand->pftlist);p++)
-      wet[p]=0;
-  }
-  else
-    wet=NULL;
-  gp_pft=newvec(Real,npft+ncft);
-  check(gp_pft);
+  /* use preallocated buffers of thread instead of allocating vectors every day */
+  scratch=getscratch();
+  wet=scratch->wet; /* wet from pftlist */
+  for(p=0;p<getnpft(&stand->pftlist);p++)
+    wet[p]=0;
+  gp_pft=scratch->gp_pft;
   gp_stand=gp_sum(&stand->pftlist,co2,climate->temp,par,daylength,
                   &gp_stand_leafon,gp_pft,&fpc_total_stand,config);
   if(!config->river_routing)
@@ -205,12 +201,12 @@ Real daily_biomass_tree(Stand *stand,                /**< stand pointer */
      getoutputindex(output,PFT_NPP,nnat+rbtree(ncft)+data->irrigation.irrigation*nirrig,config)+=npp*stand->frac;
    else
      getoutputindex(output,PFT_NPP,nnat+rbtree(ncft)+data->irrigation.irrigation*nirrig,config)+=npp;
-   getoutputindex(output,PFT_LAI,nnat+rbtree(ncft)+data->irrigation.irrigation*nirrig,config)+=actual_lai(pft);
+   if(isoutput(PFT_LAI,config))
+     getoutputindex(output,PFT_LAI,nnat+rbtree(ncft)+data->irrigation.irrigation*nirrig,config)+=actual_lai(pft);
 
   } /* of foreachpft */
 
   /* soil outflow: evap and transpiration */
-  free(gp_pft);
   waterbalance(stand,aet_stand,green_transp,&evap,&evap_blue,wet_all,eeq,cover_stand,
                &frac_g_evap,config->rw_manage);
 
@@ -241,6 +237,5 @@ Real daily_biomass_tree(Stand *stand,                /**< stand pointer */
   /* output for green and blue water for evaporation, transpiration and interception */
   output_gbw(output,stand,frac_g_evap,evap,evap_blue,return_flow_b,aet_stand,green_transp,
              intercep_stand,intercep_stand_blue,rbtree(ncft)+data->irrigation.irrigation*nirrig,data->irrigation.irrigation,config);
-  free(wet);
   return runoff;
 } /* of 'daily_biomass_tree' */
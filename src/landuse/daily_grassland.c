@@ -51,6 +51,7 @@ Real daily_grassland(Stand *stand,                /**< stand pointer */
   int p,l;
   Pft *pft;
   Real *gp_pft;         /**< pot. canopy conductance for PFTs & CFTs (mm/s) */
+  Scratch *scratch;     /**< preallocated buffers of thread */
   Real gp_stand;               /**< potential stomata conductance  (mm/s) */
   Real gp_stand_leafon;        /**< pot. canopy conduct.at full leaf cover  (mm/s) */
   Real fpc_total_stand;
@@ -95,27 +96,16 @@ Real daily_grassland(Stand *stand,                /**< stand pointer */
   output=&stand->cell->output;
   evap=evap_blue=cover_stand=intercep_stand=intercep_stand_blue=wet_all=rw_apply=intercept=sprink_interc=rainmelt=0.0;
   runoff=return_flow_b=0.0;
-  if(getnpft(&stand->pftlist)>0)
-  {
-    wet=newvec(Real,getnpft(&stand->pftlist)); /* wet from pftlist */
-    check(wet);
-#ifdef PERMUTE
-    pvec=newvec(int,getnpft(&stand->pftlist));
-    check(pvec);
-    permute(pvec,getnpft(&stand->pftlist),stand->cell->seed);
-#endif
-    for(p=0;p<getnpft(&stand->pftlist);p++)
-      wet[p]=0;
-  }
-  else
-  {
-    wet=NULL;
+  /* use preallocated buffers of thread instead of allocating vectors every day */
+  scratch=getscratch();
+  wet=scratch->wet; /* wet from pftlist */
+  for(p=0;p<getnpft(&stand->pftlist);p++)
+    wet[p]=0;
 #ifdef PERMUTE
-    pvec=NULL;
+  pvec=scratch->pvec;
+  permute(pvec,getnpft(&stand->pftlist),stand->cell->seed);
 #endif
-  }
-  gp_pft=newvec(Real,npft+ncft);
-  check(gp_pft);
+  gp_pft=scratch->gp_pft;
   gp_stand=gp_sum(&stand->pftlist,co2,climate->temp,par,daylength,
                   &gp_stand_leafon,gp_pft,&fpc_total_stand,config);
 
@@ -297,11 +287,11 @@ Real daily_grassland(Stand *stand,                /**< stand pointer */
     {
       getoutputindex(output,PFT_NPP,nnat+index,config)+=npp;
     }
-    getoutputindex(output,PFT_LAI,nnat+index,config)+=actual_lai_grass(pft);
+    if(isoutput(PFT_LAI,config))
+      getoutputindex(output,PFT_LAI,nnat+index,config)+=actual_lai_grass(pft);
     grass = pft->data;
     pft->npp_bnf=0.0;
   }
-  free(gp_pft);
   /* calculate water balance */
   waterbalance(stand,aet_stand,green_transp,&evap,&evap_blue,wet_all,eeq,cover_stand,
                &frac_g_evap,config->rw_manage);
@@ -310,8 +300,7 @@ Real daily_grassland(Stand *stand,                /**< stand pointer */
   {
     if(n_pft>0) /* nonzero? */
     {
-      fpc_inc=newvec(Real,n_pft);
-      check(fpc_inc);
+      fpc_inc=scratch->fpc_inc;
 
       foreachpft(pft,p,&stand->pftlist)
       {
@@ -358,7 +347,6 @@ Real daily_grassland(Stand *stand,                /**< stand pointer */
          }
       }
       light(stand,fpc_inc,config);
-      free(fpc_inc);
     }
   }
   else
@@ -393,8 +381,7 @@ Real daily_grassland(Stand *stand,                /**< stand pointer */
           hfrac=1-param.hfrac2/(param.hfrac2+cleaf);
           if(config->with_nitrogen)
           {
-            fpc_inc=newvec(Real,n_pft);
-            check(fpc_inc);
+            fpc_inc=scratch->fpc_inc;
             foreachpft(pft,p,&stand->pftlist)
             {
               grass=pft->data;
@@ -402,7 +389,6 @@ Real daily_grassland(Stand *stand,                /**< stand pointer */
             }
             allocation_today(stand,config);
             light(stand,fpc_inc,config);
-            free(fpc_inc);
           }
         }
         break;
@@ -532,15 +518,16 @@ Real daily_grassland(Stand *stand,                /**< stand pointer */
     grass=pft->data;
     if(stand->type->landusetype==GRASSLAND)
     {
-      getoutput(output,MEANVEGCMANGRASS,config)+=vegc_sum(pft);
+      if(isoutput(MEANVEGCMANGRASS,config))
+        getoutput(output,MEANVEGCMANGRASS,config)+=vegc_sum(pft);
       if(!isannual(FPC_BFT,config))
         getoutputindex(output,FPC_BFT,getpftpar(pft, id)-(nnat-config->ngrass)+data->irrigation.irrigation*(config->nbiomass+2*config->ngrass),config)=pft->fpc;
     }
-    if(!isannual(PFT_VEGC,config))
+    if(isoutput(PFT_VEGC,config) && !isannual(PFT_VEGC,config))
     {
       getoutputindex(output,PFT_VEGC,nnat+index,config)=vegc_sum(pft);
     }
-    if(!isannual(PFT_VEGN,config))
+    if(isoutput(PFT_VEGN,config) && !isannual(PFT_VEGN,config))
     {
       getoutputindex(output,PFT_VEGN,nnat+index,config)=vegn_sum(pft)+pft->bm_inc.nitrogen;
     }
@@ -566,9 +553,5 @@ Real daily_grassland(Stand *stand,                /**< stand pointer */
   /* output for green and blue water for evaporation, transpiration and interception */
   output_gbw(output,stand,frac_g_evap,evap,evap_blue,return_flow_b,aet_stand,green_transp,
              intercep_stand,intercep_stand_blue,index,data->irrigation.irrigation,config);
-  free(wet);
-#ifdef PERMUTE
-  free(pvec);
-#endif
   return runoff;
 } /* of 'daily_grassland' */
@@ -0,0 +1,67 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                 b  c  a  s  t  c  o  n  f  i  g  .  c                          \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function broadcasts parsed LPJ configuration from root task to             \n**/
+/**     all other tasks. Only the root task preprocesses and parses the            \n**/
+/**     configuration file. The JSON object is sent as compact text and            \n**/
+/**     parsed from memory by the other tasks.                                     \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <json-c/json.h>
+#include "lpj.h"
+
+#ifdef USE_MPI
+
+LPJfile *bcastconfig(LPJfile *lpjfile,    /**< parsed configuration on root task or NULL */
+                     const Config *config /**< LPJ configuration */
+                    )                     /** \return parsed configuration or NULL on error */
+{
+  const char *s=NULL;
+  char *text;
+  int len;
+  if(isroot(*config))
+  {
+    if(lpjfile==NULL)
+      len=0;
+    else
+    {
+      s=json_object_to_json_string_ext(lpjfile,JSON_C_TO_STRING_PLAIN);
+      if(s==NULL)
+      {
+        printallocerr("text");
+        json_object_put(lpjfile);
+        lpjfile=NULL;
+        len=0;
+      }
+      else
+        len=strlen(s)+1;
+    }
+  }
+  /* send length of text first, zero length indicates error on root task */
+  MPI_Bcast(&len,1,MPI_INT,0,config->comm);
+  if(len==0)
+    return NULL;
+  if(isroot(*config))
+  {
+    MPI_Bcast((void *)s,len,MPI_CHAR,0,config->comm);
+    return lpjfile;
+  }
+  text=malloc(len);
+  check(text);
+  MPI_Bcast(text,len,MPI_CHAR,0,config->comm);
+  lpjfile=json_tokener_parse(text);
+  free(text);
+  return lpjfile;
+} /* of 'bcastconfig' */
+
+#endif
@@ -209,6 +209,35 @@ Bool seekcelldata(Celldata celldata, /**< pointer to celldata */
   return FALSE;
 } /* of 'seekcelldata' */
 
+#ifdef USE_MPI
+
+Bool readslicecelldata(Celldata celldata,   /**< pointer to celldata */
+                       const Config *config, /**< LPJmL configuration */
+                       MPI_Comm node         /**< communicator of tasks on node */
+                      )                      /** \return TRUE on error */
+{
+  /* data of all cells of task are read collectively by one task per node */
+  FILE *file;
+  if(celldata->soil_fmt!=CDF)
+  {
+    if(readslicecoord(celldata->soil.bin.file_coord,config->ngridcell,node))
+      return TRUE;
+    file=freadslice(celldata->soil.bin.file,(size_t)config->ngridcell*typesizes[celldata->soil.bin.type],node);
+    if(file==NULL)
+      return TRUE;
+    celldata->soil.bin.file=file;
+  }
+  if(config->with_nitrogen && readsliceinput(&celldata->soilph,config->ngridcell,node))
+    return TRUE;
+  if(config->landfrac_from_file && readsliceinput(&celldata->landfrac,config->ngridcell,node))
+    return TRUE;
+  if(config->with_lakes && readsliceinput(&celldata->lakes,config->ngridcell,node))
+    return TRUE;
+  return FALSE;
+} /* of 'readslicecelldata' */
+
+#endif
+
 Bool readcelldata(Celldata celldata,      /**< pointer to celldata */
                   Cell *grid,             /**< pointer to grid cell */
                   unsigned int *soilcode, /**< soil code */
@@ -21,6 +21,17 @@ void closeoutput_yearly(Outputfile *output, /**< Output data */
                        )
 {
  int i;
+ flushwriter(output->writer); /* write queued data before files are closed */
+#ifdef USE_MPI
+ for(i=0;i<config->n_out;i++)
+   if(config->outputvars[i].oneyear && output->files[config->outputvars[i].id].isparallel)
+   {
+     /* file written in parallel has to be closed by all tasks */
+     MPI_File_close(&output->files[config->outputvars[i].id].fh);
+     output->files[config->outputvars[i].id].isparallel=FALSE;
+     output->files[config->outputvars[i].id].isopen=FALSE;
+   }
+#endif
  if(isroot(*config))
    for(i=0;i<config->n_out;i++)
      if(config->outputvars[i].oneyear && output->files[config->outputvars[i].id].isopen)
@@ -58,6 +58,7 @@ Real daily_natural(Stand *stand,                /**< [inout] stand pointer */
   Real gc_pft;
   Real transp;
   Real vol_water_enth; /* volumetric enthalpy of water (J/m^3) */
+  Scratch *scratch;    /* preallocated buffers of thread */
 
 #ifdef DAILY_ESTABLISHMENT
   Stocks flux_estab = {0,0};
@@ -70,27 +71,16 @@ Real daily_natural(Stand *stand,                /**< [inout] stand pointer */
 
   runoff=return_flow_b=0.0;
   stand->growing_days++;
-  if(getnpft(&stand->pftlist)>0)
-  {
-    wet=newvec(Real,getnpft(&stand->pftlist)); /* wet from pftlist */
-    check(wet);
-#ifdef PERMUTE
-    pvec=newvec(int,getnpft(&stand->pftlist));
-    check(pvec);
-    permute(pvec,getnpft(&stand->pftlist),stand->cell->seed);
-#endif
-    for(p=0;p<getnpft(&stand->pftlist);p++)
-      wet[p]=0;
-  }
-  else
-  {
-    wet=NULL;
+  /* use preallocated buffers of thread instead of allocating vectors every day */
+  scratch=getscratch();
+  wet=scratch->wet; /* wet from pftlist */
+  for(p=0;p<getnpft(&stand->pftlist);p++)
+    wet[p]=0;
 #ifdef PERMUTE
-    pvec=NULL;
+  pvec=scratch->pvec;
+  permute(pvec,getnpft(&stand->pftlist),stand->cell->seed);
 #endif
-  }
-  gp_pft=newvec(Real,npft+ncft);
-  check(gp_pft);
+  gp_pft=scratch->gp_pft;
   gp_stand=gp_sum(&stand->pftlist,co2,climate->temp,par,daylength,
                   &gp_stand_leafon,gp_pft,&fpc_total_stand,config);
 
@@ -180,10 +170,10 @@ Real daily_natural(Stand *stand,                /**< [inout] stand pointer */
         getoutputindex(output,PFT_NPP,pft->par->id,config)+=npp*stand->frac;
       else
         getoutputindex(output,PFT_NPP,pft->par->id,config)+=npp;
-      getoutputindex(output,PFT_LAI,pft->par->id,config)+=actual_lai(pft);
+      if(isoutput(PFT_LAI,config))
+        getoutputindex(output,PFT_LAI,pft->par->id,config)+=actual_lai(pft);
     }
   } /* of foreachpft */
-  free(gp_pft);
   /* soil outflow: evap and transpiration */
   waterbalance(stand,aet_stand,green_transp,&evap,&evap_blue,wet_all,eeq,cover_stand,
                &frac_g_evap,FALSE);
@@ -206,7 +196,7 @@ Real daily_natural(Stand *stand,                /**< [inout] stand pointer */
   if(stand->cell->ml.image_data!=NULL)
     stand->cell->ml.image_data->mevapotr[month] += transp + (evap + intercep_stand)*stand->frac;
 #endif
-  if(stand->type->landusetype==NATURAL)
+  if(stand->type->landusetype==NATURAL && isoutput(NV_LAI,config))
     foreachpft(pft, p, &stand->pftlist)
     {
       getoutputindex(output,NV_LAI,getpftpar(pft,id),config)+=actual_lai(pft);
@@ -224,9 +214,5 @@ Real daily_natural(Stand *stand,                /**< [inout] stand pointer */
   output->dcflux-=flux_estab.carbon*stand->frac;
 #endif
 
-  free(wet);
-#ifdef PERMUTE
-  free(pvec);
-#endif
   return runoff;
 } /* of 'daily_natural' */
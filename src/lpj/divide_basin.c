@@ -0,0 +1,127 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                   d  i  v  i  d  e  _  b  a  s  i  n  .  c                     \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function distributes the cell grid on the parallel tasks in                \n**/
+/**     contiguous blocks of approximately equal size. Boundaries between          \n**/
+/**     tasks are moved to positions crossed by a minimum number of river          \n**/
+/**     links read from the drainage file to keep drainage basins on one task.     \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#define BASIN_TOLERANCE 0.1 /* maximum deviation from equal number of cells per task */
+
+static Bool getcuts(int cut[],                 /**< [out] index of first cell of each task */
+                    int n,                     /**< [in] number of cells */
+                    const Filename *filename,  /**< [in] filename of drainage file */
+                    const Config *config       /**< [in] LPJmL configuration */
+                   )                           /** \return TRUE on error */
+{
+  FILE *file;
+  Header header;
+  String headername;
+  Routing r;
+  Bool swap;
+  size_t offset;
+  int i,c,lo,hi,slice,rem,target,version,*cross;
+  if((file=openinputfile(&header,&swap,filename,headername,NULL,LPJ_INT,&version,&offset,FALSE,config))==NULL)
+    return TRUE;
+  if(fseek(file,sizeof(Routing)*(config->firstgrid-header.firstcell)+offset,SEEK_CUR))
+  {
+    fprintf(stderr,"ERROR139: Cannot seek to drainage of cell %d.\n",config->firstgrid);
+    fclose(file);
+    return TRUE;
+  }
+  cross=newvec(int,n+1);
+  if(cross==NULL)
+  {
+    printallocerr("cross");
+    fclose(file);
+    return TRUE;
+  }
+  for(i=0;i<=n;i++)
+    cross[i]=0;
+  for(i=0;i<n;i++)
+  {
+    if(getroute(file,&r,swap))
+    {
+      fprintf(stderr,"ERROR144: Cannot read river route for cell %d.\n",i+config->firstgrid);
+      free(cross);
+      fclose(file);
+      return TRUE;
+    }
+    r.index-=config->firstgrid;
+    if(r.index>=0 && r.index<n)
+    {
+      /* river link between cell i and r.index crosses all boundaries in between */
+      cross[min(i,r.index)+1]++;
+      cross[max(i,r.index)+1]--;
+    }
+  }
+  fclose(file);
+  /* cross[c] is number of river links crossing boundary before cell c */
+  for(i=1;i<=n;i++)
+    cross[i]+=cross[i-1];
+  slice=n/config->ntask;
+  rem=n % config->ntask;
+  cut[0]=0;
+  for(i=1;i<config->ntask;i++)
+  {
+    /* boundary of equal distribution as calculated by divide() */
+    target=i*slice+min(i,rem);
+    lo=max(cut[i-1]+1,target-(int)(slice*BASIN_TOLERANCE));
+    hi=min(n-config->ntask+i,target+(int)(slice*BASIN_TOLERANCE));
+    cut[i]=max(lo,min(hi,target));
+    for(c=lo;c<=hi;c++)
+      if(cross[c]<cross[cut[i]] || (cross[c]==cross[cut[i]] && abs(c-target)<abs(cut[i]-target)))
+        cut[i]=c;
+  }
+  cut[config->ntask]=n;
+  free(cross);
+  return FALSE;
+} /* of 'getcuts' */
+
+Bool divide_basin(int *start,               /**< index of first grid cell */
+                  int *end,                 /**< index of last grid cell */
+                  const Filename *filename, /**< filename of drainage file */
+                  const Config *config      /**< LPJmL configuration */
+                 )                          /** \return TRUE on error */
+{
+  int *cut;
+  Bool rc;
+  cut=newvec(int,config->ntask+1);
+  if(cut==NULL)
+  {
+    printallocerr("cut");
+    return TRUE;
+  }
+  rc=FALSE;
+  /* drainage file is only read by the root task and boundaries are broadcast */
+  if(isroot(*config))
+    rc=getcuts(cut,*end-*start+1,filename,config);
+#ifdef USE_MPI
+  MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
+#endif
+  if(rc)
+  {
+    free(cut);
+    return TRUE;
+  }
+#ifdef USE_MPI
+  MPI_Bcast(cut,config->ntask+1,MPI_INT,0,config->comm);
+#endif
+  *end=*start+cut[config->rank+1]-1;
+  *start+=cut[config->rank];
+  free(cut);
+  return FALSE;
+} /* of 'divide_basin' */
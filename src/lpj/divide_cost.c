@@ -0,0 +1,111 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                   d  i  v  i  d  e  _  c  o  s  t  .  c                        \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function distributes the cell grid on the parallel tasks in                \n**/
+/**     contiguous blocks of approximately equal computational cost.               \n**/
+/**     Cost of each cell is read from a file written by fwritecellcost()          \n**/
+/**     in a previous run.                                                         \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+Bool divide_cost(int *start,               /**< index of first grid cell */
+                 int *end,                 /**< index of last grid cell */
+                 const Filename *filename, /**< filename of cell cost file */
+                 const Config *config      /**< LPJmL configuration */
+                )                          /** \return TRUE on error */
+{
+  Infile file;
+  Real *cost,sum,target,mincost;
+  int i,k,n,r,lo,hi;
+  Bool rc;
+  n=*end-*start+1;
+  cost=newvec(Real,n);
+  if(cost==NULL)
+  {
+    printallocerr("cost");
+    return TRUE;
+  }
+  rc=FALSE;
+  if(isroot(*config))
+  {
+    /* cost file is only read by the root task and broadcast */
+    if(openinputdata(&file,filename,"cell cost",NULL,LPJ_FLOAT,1.0,config))
+      rc=TRUE;
+    else
+    {
+      for(i=0;i<n;i++)
+        if(readinputdata(&file,cost+i,NULL,i+*start,filename))
+        {
+          rc=TRUE;
+          break;
+        }
+      closeinput(&file);
+    }
+  }
+#ifdef USE_MPI
+  MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
+#endif
+  if(rc)
+  {
+    free(cost);
+    return TRUE;
+  }
+#ifdef USE_MPI
+  MPI_Bcast(cost,n*sizeof(Real),MPI_BYTE,0,config->comm);
+#endif
+  sum=0;
+  for(i=0;i<n;i++)
+  {
+    if(cost[i]<0)
+      cost[i]=0;
+    sum+=cost[i];
+  }
+  /* cells without cost still get a small weight to avoid empty tasks */
+  mincost=(sum>0) ? sum/n*1e-3 : 1;
+  sum=0;
+  for(i=0;i<n;i++)
+  {
+    cost[i]+=mincost;
+    sum+=cost[i];
+  }
+  /* find first cell of each task up to my rank, each task gets at least one cell */
+  lo=hi=0;
+  target=0;
+  i=0;
+  for(r=1;r<=config->rank+1 && r<config->ntask;r++)
+  {
+    while(i<n && target+cost[i]*0.5<sum*r/config->ntask)
+      target+=cost[i++];
+    while(i<hi+1)
+      target+=cost[i++];
+    if(i>n-(config->ntask-r))
+    {
+      i=n-(config->ntask-r);
+      target=0;
+      for(k=0;k<i;k++)
+        target+=cost[k];
+    }
+    lo=hi;
+    hi=i;
+  }
+  if(config->rank==config->ntask-1)
+  {
+    lo=hi;
+    hi=n;
+  }
+  free(cost);
+  *end=*start+hi-1;
+  *start+=lo;
+  return FALSE;
+} /* of 'divide_cost' */
@@ -42,18 +42,145 @@ static Real fillreservoir(Real *mass,Real in,Real mass_max)
   return in;
 } /* of 'fillreservoir' */
 
+static void outflow(Cell *cell,const Config *config)
+{
+  /* calculate outflow from delay queue */
+  cell->discharge.fout=convqueue(cell->discharge.queue,cell->discharge.tfunct);
+
+  cell->discharge.dmass_river-=cell->discharge.fout;
+  cell->discharge.dfout+=cell->discharge.fout;
+  getoutput(&cell->output,DISCHARGE,config)+=cell->discharge.fout;
+#ifdef IMAGE
+  getoutput(&cell->output,YDISCHARGE,config)+=cell->discharge.fout;
+#ifdef COUPLED
+  cell->ydischarge+=cell->discharge.fout;
+#endif
+#endif
+
+  if(cell->discharge.next<0)
+  {
+    getoutput(&cell->output,ADISCHARGE,config)+=cell->discharge.fout;           /* only endcell outflow */
+    cell->balance.adischarge+=cell->discharge.fout;           /* only endcell outflow */
+  }
+  cell->discharge.mfout+=cell->discharge.fout;
+} /* of 'outflow' */
+
+static Real extinflow(Cell *cell,int iter)
+{
+  /* external inflow is added in the first iteration */
+  if(iter==0)
+  {
+    cell->discharge.afin_ext+=cell->discharge.fin_ext;
+    return cell->discharge.fin_ext;
+  }
+  return 0;
+} /* of 'extinflow' */
+
+static void inflow(Cell *cell,Real fin,int count)
+{
+  /* inflow fills reservoir and lake, the remainder enters the delay queue */
+  Real fout_lake;
+  cell->discharge.mfin+=fin;
+
+  if(cell->ml.dam)
+    fin=fillreservoir(&cell->ml.resdata->dmass,fin,
+                      cell->ml.resdata->reservoir.capacity);
+
+  fin=fillreservoir(&cell->discharge.dmass_lake,fin,
+                     cell->discharge.dmass_lake_max);
+
+
+  /* lake outflow */
+  if(cell->discharge.dmass_lake>0.0 && cell->discharge.next>=0)
+  {
+    fout_lake=kr/count*cell->discharge.dmass_lake*pow(cell->discharge.dmass_lake/cell->discharge.dmass_lake_max,1.5);
+    cell->discharge.dmass_lake-=fout_lake;
+    fin+=fout_lake;
+  }
+
+  /* water withdrawal */
+  if(fin>cell->discharge.wd_demand/count)
+  {
+    cell->discharge.withdrawal+=cell->discharge.wd_demand/count;
+    cell->discharge.mfout+=cell->discharge.wd_demand/count;
+    fin-=cell->discharge.wd_demand/count;
+  }
+  else
+  {
+    cell->discharge.withdrawal+=fin;
+    cell->discharge.mfout+=fin;
+    fin=0.0;
+  }
+
+  /* the remainder enters the river system */
+  cell->discharge.dmass_river+=fin;
+  putqueue(cell->discharge.queue,fin);
+  cell->discharge.dmass_sum+=cell->discharge.dmass_river+cell->discharge.dmass_lake+sumqueue(cell->discharge.queue);
+} /* of 'inflow' */
+
+static void drain_ordered(Cell grid[],int count,const Config *config)
+{
+  /*
+   * Cells are processed from upstream to downstream, all sub-steps of a cell
+   * are calculated at once. Data are only exchanged between groups of cells
+   * depending on cells of other tasks.
+   */
+  int r,g,k,cell,j,iter,src;
+  Real fin,*out,*in;
+  const Routeorder *order;
+  Pnet *route;
+  order=config->routeorder;
+  route=config->route_sub;
+  out=(Real *)pnet_output(route);
+  in=(Real *)pnet_input(route);
+  for(r=0;r<order->nround;r++)
+  {
+    for(g=order->roundstart[r];g<order->roundstart[r+1];g++)
+    {
+      /* cells within a group do not depend on each other */
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic) private(cell,j,iter,src,fin)
+#endif
+      for(k=order->start[g];k<order->start[g+1];k++)
+      {
+        cell=order->order[k];
+        for(iter=0;iter<count;iter++)
+        {
+          outflow(grid+cell,config);
+          order->fout[cell*count+iter]=grid[cell].discharge.fout;
+          fin=extinflow(grid+cell,iter);
+          /* sum up all inflows from other cells */
+          for(j=order->instart[cell];j<order->instart[cell+1];j++)
+          {
+            src=order->inindex[j];
+            fin+=(src<0) ? order->fout[(-src-1)*count+iter] : in[src*count+iter];
+          }
+          inflow(grid+cell,fin,count);
+        }
+      }
+    }
+    if(r<order->nround-1)
+    {
+      /* fill output buffer with outflows of all sub-steps */
+      for(k=0;k<pnet_outlen(route);k++)
+        for(iter=0;iter<count;iter++)
+          out[k*count+iter]=order->fout[(pnet_outindex(route,k)-pnet_lo(route))*count+iter];
+      /* communication function fills input buffer */
+      pnet_exchg(route);
+    }
+  }
+} /* of 'drain_ordered' */
+
 void drain(Cell grid[],         /**< Cell array */
            int month,           /**< month (0..11) */
            const Config *config /**< LPJmL configuration */
           )
 {
-  int count,cell,i,j,iter,t,ncoeff;
+  int count,cell,i,j,iter;
   Real fin,*out,*in;
-  Real fout_lake,irrig_to_river;
+  Real irrig_to_river;
 
   count=(int)(1.0/TSTEP); /* calculate number of iterations */
-  out=(Real *)pnet_output(config->route);
-  in=(Real *)pnet_input(config->route);
 
   for(cell=0;cell<config->ngridcell;cell++)
   {
@@ -113,98 +240,38 @@ void drain(Cell grid[],         /**< Cell array */
   } /* of 'for(cell=...)' */
 
 
-  grid-=config->startgrid-config->firstgrid; /* adjust first index of grid
-                                              array needed for pnet library */
-  for(iter=0;iter<count;iter++)
+  if(config->routeorder!=NULL)
+    drain_ordered(grid,count,config);
+  else
   {
-    for(i=pnet_lo(config->route);i<=pnet_hi(config->route);i++)
-    {
-      /* calculate outflow */
-      grid[i].discharge.fout=0;
-      ncoeff=queuesize(grid[i].discharge.queue);
-      for(t=0;t<ncoeff;t++)
-        grid[i].discharge.fout+=getqueue(grid[i].discharge.queue,t)*grid[i].discharge.tfunct[t];
-
-      grid[i].discharge.dmass_river-=grid[i].discharge.fout;
-      grid[i].discharge.dfout+=grid[i].discharge.fout;
-      getoutput(&grid[i].output,DISCHARGE,config)+=grid[i].discharge.fout;
-#ifdef IMAGE
-      getoutput(&grid[i].output,YDISCHARGE,config)+=grid[i].discharge.fout;
-#ifdef COUPLED
-     grid[i].ydischarge+=grid[i].discharge.fout;
-#endif
-#endif
-
-      if(grid[i].discharge.next<0)
-      {
-        getoutput(&grid[i].output,ADISCHARGE,config)+=grid[i].discharge.fout;           /* only endcell outflow */
-        grid[i].balance.adischarge+=grid[i].discharge.fout;           /* only endcell outflow */
-      }
-      grid[i].discharge.mfout+=grid[i].discharge.fout;
-    }
-
-    /* fill output buffer */
-    for(i=0;i<pnet_outlen(config->route);i++)
-      out[i]=grid[pnet_outindex(config->route,i)].discharge.fout;
-
-    /* communication function fills input buffer */
-    pnet_exchg(config->route);
-
-    for(i=pnet_lo(config->route);i<=pnet_hi(config->route);i++)
+    out=(Real *)pnet_output(config->route);
+    in=(Real *)pnet_input(config->route);
+    grid-=config->startgrid-config->firstgrid; /* adjust first index of grid
+                                                array needed for pnet library */
+    for(iter=0;iter<count;iter++)
     {
-      if(iter==0)
-      {
-        fin=grid[i].discharge.fin_ext;
-        grid[i].discharge.afin_ext+=fin;
-      }
-      else
-        fin=0;
-      /* sum up all inflows from other cells */
-      for(j=0;j<pnet_inlen(config->route,i);j++)
-        fin+=in[pnet_inindex(config->route,i,j)];
-
-      grid[i].discharge.mfin+=fin;
+      for(i=pnet_lo(config->route);i<=pnet_hi(config->route);i++)
+        outflow(grid+i,config);
 
-      if(grid[i].ml.dam)
-        fin=fillreservoir(&grid[i].ml.resdata->dmass,fin,
-                          grid[i].ml.resdata->reservoir.capacity);
+      /* fill output buffer */
+      for(i=0;i<pnet_outlen(config->route);i++)
+        out[i]=grid[pnet_outindex(config->route,i)].discharge.fout;
 
-      fin=fillreservoir(&grid[i].discharge.dmass_lake,fin,
-                         grid[i].discharge.dmass_lake_max);
-
-
-      /* lake outflow */
-      if(grid[i].discharge.dmass_lake>0.0 && grid[i].discharge.next>=0)
-      {
-        fout_lake=kr/count*grid[i].discharge.dmass_lake*pow(grid[i].discharge.dmass_lake/grid[i].discharge.dmass_lake_max,1.5);
-        grid[i].discharge.dmass_lake-=fout_lake;
-        fin+=fout_lake;
-      }
+      /* communication function fills input buffer */
+      pnet_exchg(config->route);
 
-      /* water withdrawal */
-      if(fin>grid[i].discharge.wd_demand/count)
+      for(i=pnet_lo(config->route);i<=pnet_hi(config->route);i++)
       {
-        grid[i].discharge.withdrawal+=grid[i].discharge.wd_demand/count;
-        grid[i].discharge.mfout+=grid[i].discharge.wd_demand/count;
-        fin-=grid[i].discharge.wd_demand/count;
-      }
-      else
-      {
-        grid[i].discharge.withdrawal+=fin;
-        grid[i].discharge.mfout+=fin;
-        fin=0.0;
-      }
-  
-      /* the remainder enters the river system */
-      grid[i].discharge.dmass_river+=fin;
-      putqueue(grid[i].discharge.queue,fin);
-      grid[i].discharge.dmass_sum+=grid[i].discharge.dmass_river+grid[i].discharge.dmass_lake+sumqueue(grid[i].discharge.queue);
-
-
-    } /* of 'for(i=...)' */
-  } /* of 'for(iter=...)' */
-
-  grid+=config->startgrid-config->firstgrid; /* re-adjust first index of grid array */
+        fin=extinflow(grid+i,iter);
+        /* sum up all inflows from other cells */
+        for(j=0;j<pnet_inlen(config->route,i);j++)
+          fin+=in[pnet_inindex(config->route,i,j)];
+        inflow(grid+i,fin,count);
+      } /* of 'for(i=...)' */
+    } /* of 'for(iter=...)' */
+
+    grid+=config->startgrid-config->firstgrid; /* re-adjust first index of grid array */
+  }
 
   
   for(cell=0;cell<config->ngridcell;cell++)
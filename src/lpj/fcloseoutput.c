@@ -44,14 +44,25 @@ void fcloseoutput(Outputfile *output,  /**< Output file array */
                  )
 {
   int i;
+  freewriter(output->writer); /* write remaining queued data */
   for(i=0;i<output->n;i++)
     if(output->files[i].isopen)  /* output file is open? */
     {
+#ifdef USE_MPI
+      if(output->files[i].isparallel)
+      {
+        /* file written in parallel has to be closed by all tasks */
+        MPI_File_close(&output->files[i].fh);
+        if(isroot(*config) && output->files[i].compress)
+          compress(output->files[i].filename,config->compress_cmd);
+        continue;
+      }
+#endif
       if(isroot(*config) && !output->files[i].oneyear)
       {
         switch(output->files[i].fmt)
         {
-          case RAW: case TXT:
+          case RAW: case CLM: case TXT:
             fclose(output->files[i].fp.file);
             break;
           case CDF:
@@ -67,7 +78,13 @@ void fcloseoutput(Outputfile *output,  /**< Output file array */
   free(output->offsets);
 #endif
   free(output->files);
+  free(output->batch_index);
+  free(output->batch_size);
+  free(output->batch);
   freecoordarray(output->index);
   freecoordarray(output->index_all);
+  free(output->countrycode);
+  free(output->mask);
+  free(output->area);
   free(output);
 } /* of 'fcloseoutput' */
@@ -350,7 +350,7 @@ static int checkrestartfile(Config *config, const char *filename)
   Bool swap;
   file=openrestart(filename,config,
                    config->npft[GRASS]+config->npft[TREE]+config->npft[CROP],
-                   &swap);
+                   &swap,NULL);
   if(file==NULL)
     return 1;
   fclose(file);
@@ -460,6 +460,8 @@ Bool filesexist(Config config, /**< LPJmL configuration */
   }
   if(config.grassharvest_filename.name!=NULL)
     bad+=checkinputdata(&config,&config.grassharvest_filename,"grassharvest",NULL,LPJ_SHORT);
+  if(config.aggregate_mask_filename.name!=NULL)
+    bad+=checkinputdata(&config,&config.aggregate_mask_filename,"aggregate mask",NULL,LPJ_INT);
   if(config.with_nitrogen || config.fire==SPITFIRE || config.fire==SPITFIRE_TMAX)
     bad+=checkclmfile(&config,"wind speed",&config.wind_filename,"m/s",LPJ_SHORT,TRUE);
   if(config.fire==SPITFIRE || config.fire==SPITFIRE_TMAX)
@@ -50,6 +50,38 @@ static Bool create(Netcdf *cdf,const char *filename,int index,
                              (config->outnames[config->outputvars[index].id].timestep==ANNUAL) ? 1 : config->outnames[config->outputvars[index].id].timestep,0,FALSE,array,config);
 } /* of 'create' */
 
+static FILE *createfile(const char *filename, /**< filename */
+                        size_t offset,        /**< size of file header in bytes */
+                        int index,            /**< index in outputvars array */
+                        Type type,            /**< datatype of output */
+                        const Config *config  /**< LPJmL configuration */
+                       )                      /** \return file pointer or NULL */
+{
+  /*
+   * Records of one time step and band are compressed in blocks. Records
+   * of aggregated outputs hold one value per region, so the block size is
+   * taken from outputncell() to keep random access to each record. Grid,
+   * country code and area outputs are not compressed, because they are
+   * used as input files.
+   */
+  if(config->compress_binary && config->outputvars[index].id>LAKE_AREA)
+    return createzfile(filename,offset,outputncell(index,config)*typesizes[type],
+                       (config->shuffle_binary) ? typesizes[type] : 1,
+                       config->compress_binary);
+  return fopen(filename,"wb");
+} /* of 'createfile' */
+
+static Bool iscompressed(int id,const Config *config)
+{
+  if(config->compress_binary && id>LAKE_AREA)
+  {
+    fprintf(stderr,"ERROR276: Compressed output '%s' cannot be continued from checkpoint.\n",
+            config->outnames[id].name);
+    return TRUE;
+  }
+  return FALSE;
+} /* of 'iscompressed' */
+
 static void openfile(Outputfile *output,const Cell grid[],
                      const char *filename,int i,
                      const Config *config)
@@ -103,6 +135,8 @@ static void openfile(Outputfile *output,const Cell grid[],
        case CLM:
         if(config->ischeckpoint && getnyear(config->outnames,config->outputvars[i].id)!=0)
         {
+          if(iscompressed(config->outputvars[i].id,config))
+            break;
           if((output->files[config->outputvars[i].id].fp.file=fopen(filename,"r+b"))==NULL)
             printfopenerr(config->outputvars[i].filename.name);
           else
@@ -121,17 +155,17 @@ static void openfile(Outputfile *output,const Cell grid[],
         }
         else
         {
-          if((output->files[config->outputvars[i].id].fp.file=fopen(filename,"wb"))==NULL)
+          if((output->files[config->outputvars[i].id].fp.file=createfile(filename,
+              headersize((config->outputvars[i].id==GRID) ? LPJGRID_HEADER : LPJOUTPUT_HEADER,config->outputvars[i].filename.version),
+              i,getoutputtype(config->outputvars[i].id,config->grid_type),config))==NULL)
             printfcreateerr(config->outputvars[i].filename.name);
           else
           {
             output->files[config->outputvars[i].id].isopen=TRUE;
             header.firstyear=config->outputyear;
-            if(config->outputvars[i].id==ADISCHARGE)
-              header.ncell=config->nall;
-            else
-              header.ncell=config->total;
-            header.firstcell=config->firstgrid;
+            header.ncell=outputncell(i,config);
+            /* cells of aggregated output are regions */
+            header.firstcell=(config->outputvars[i].aggregate==NO_AGGREGATION) ? config->firstgrid : 0;
             header.cellsize_lon=(float)config->resolution.lon;
             header.cellsize_lat=(float)config->resolution.lat;
             header.scalar=1;
@@ -177,6 +211,8 @@ static void openfile(Outputfile *output,const Cell grid[],
       case RAW:
         if(config->ischeckpoint && getnyear(config->outnames,config->outputvars[i].id)!=0)
         {
+          if(iscompressed(config->outputvars[i].id,config))
+            break;
           if((output->files[config->outputvars[i].id].fp.file=fopen(filename,"r+b"))==NULL)
             printfopenerr(config->outputvars[i].filename.name);
           else
@@ -191,7 +227,8 @@ static void openfile(Outputfile *output,const Cell grid[],
         }
         else
         {
-          if((output->files[config->outputvars[i].id].fp.file=fopen(filename,"wb"))==NULL)
+          if((output->files[config->outputvars[i].id].fp.file=createfile(filename,0,
+              i,getoutputtype(config->outputvars[i].id,config->grid_type),config))==NULL)
             printfcreateerr(config->outputvars[i].filename.name);
           else
             output->files[config->outputvars[i].id].isopen=TRUE;
@@ -208,6 +245,114 @@ static void openfile(Outputfile *output,const Cell grid[],
   output->files[config->outputvars[i].id].oneyear=config->outputvars[i].oneyear;
 } /* of 'openfile' */
 
+#ifdef USE_MPI
+static void openparallel(File *file,           /**< output file */
+                         const char *name,     /**< filename, only used on root task */
+                         int id,               /**< output index */
+                         const Config *config  /**< LPJmL configuration */
+                        )
+{
+  /*
+   * File has been created and header written by the root task.
+   * File is closed and reopened by all tasks using MPI-IO. Grid, country
+   * code and area outputs are still written by the root task.
+   */
+  long long offset;
+  int len;
+  char *filename;
+  Bool rc;
+  file->isparallel=FALSE;
+  if(!config->parallel_output || !file->isopen || (file->fmt!=RAW && file->fmt!=CLM) || id<=LAKE_AREA)
+    return;
+  /* aggregated output is reduced on and written by the root task */
+  if(file->aggregate!=NO_AGGREGATION)
+    return;
+  /* compressed output is written sequentially by the root task */
+  if(config->compress_binary)
+    return;
+  if(isroot(*config))
+  {
+    offset=ftell(file->fp.file);
+    fclose(file->fp.file);
+    len=strlen(name);
+  }
+  MPI_Bcast(&offset,1,MPI_LONG_LONG,0,config->comm);
+  MPI_Bcast(&len,1,MPI_INT,0,config->comm);
+  filename=malloc(len+1);
+  check(filename);
+  if(isroot(*config))
+    strcpy(filename,name);
+  MPI_Bcast(filename,len+1,MPI_CHAR,0,config->comm);
+  rc=MPI_File_open(config->comm,filename,MPI_MODE_WRONLY,MPI_INFO_NULL,&file->fh)!=MPI_SUCCESS;
+  if(iserror(rc,config))
+  {
+    if(!rc)
+      MPI_File_close(&file->fh);
+    if(isroot(*config))
+    {
+      fprintf(stderr,"WARNING043: Cannot open output file '%s' for parallel write, output written by root task.\n",filename);
+      /* reopen file for writing by root task */
+      file->fp.file=fopen(filename,"r+b");
+      if(file->fp.file==NULL)
+      {
+        printfopenerr(filename);
+        file->isopen=FALSE;
+      }
+      else
+        fseek(file->fp.file,offset,SEEK_SET);
+    }
+    MPI_Bcast(&file->isopen,1,MPI_INT,0,config->comm);
+  }
+  else
+  {
+    file->offset=offset;
+    file->isparallel=TRUE;
+  }
+  free(filename);
+} /* of 'openparallel' */
+#endif
+
+static void initregions(Outputfile *output,const Cell grid[],const Config *config)
+{
+  /* region of each local cell is stored for aggregated outputs */
+  int i,cell,count;
+  for(i=0;i<config->n_out;i++)
+    switch(config->outputvars[i].aggregate)
+    {
+      case COUNTRY_AGGREGATION:
+        if(output->countrycode==NULL)
+        {
+          output->countrycode=newvec(int,config->count);
+          check(output->countrycode);
+          count=0;
+          for(cell=0;cell<config->ngridcell;cell++)
+            if(!grid[cell].skip)
+              output->countrycode[count++]=grid[cell].ml.manage.par->id;
+        }
+        break;
+      case MASK_AGGREGATION:
+        if(output->mask==NULL)
+        {
+          output->mask=newvec(int,config->count);
+          check(output->mask);
+          count=0;
+          for(cell=0;cell<config->ngridcell;cell++)
+            if(!grid[cell].skip)
+              output->mask[count++]=grid[cell].mask;
+        }
+        break;
+    } /* of switch */
+  if(output->countrycode!=NULL || output->mask!=NULL)
+  {
+    output->area=newvec(Real,config->count);
+    check(output->area);
+    count=0;
+    for(cell=0;cell<config->ngridcell;cell++)
+      if(!grid[cell].skip)
+        output->area[count++]=grid[cell].coord.area;
+  }
+} /* of 'initregions' */
+
 Outputfile *fopenoutput(const Cell grid[],   /**< LPJ grid */
                         int n,               /**< size of output file array */
                         const Config *config /**< LPJmL configuration */
@@ -226,8 +371,31 @@ Outputfile *fopenoutput(const Cell grid[],   /**< LPJ grid */
   check(output->files);
   output->n=n;
   output->index=output->index_all=NULL; 
+  output->countrycode=output->mask=NULL;
+  output->area=NULL;
+  initregions(output,grid,config);
+  /* binary output of root task is written in separate thread */
+  output->writer=(config->async_output && isroot(*config)) ? initwriter(MAXWRITERSIZE) : NULL;
+  /* float outputs of one time step are sent in one frame to coupled model */
+  if(iscoupled(*config) && config->coupler_batch && config->coupler_version>=COUPLER_VERSION_SHM)
+  {
+    output->batch_index=newvec(int,n);
+    check(output->batch_index);
+    output->batch_size=newvec(int,n);
+    check(output->batch_size);
+  }
+  else
+    output->batch_index=output->batch_size=NULL;
+  output->batch=NULL;
+  output->nbatch=output->nband=output->maxband=0;
   for(i=0;i<n;i++)
+  {
     output->files[i].isopen=output->files[i].issocket=FALSE;
+    output->files[i].aggregate=NO_AGGREGATION;
+#ifdef USE_MPI
+    output->files[i].isparallel=FALSE;
+#endif
+  }
 #ifdef USE_MPI
   output->counts=newvec(int,config->ntask);
   check(output->counts);
@@ -257,6 +425,7 @@ Outputfile *fopenoutput(const Cell grid[],   /**< LPJ grid */
     }
     output->files[config->outputvars[i].id].filename=config->outputvars[i].filename.name;
     output->files[config->outputvars[i].id].fmt=config->outputvars[i].filename.fmt;
+    output->files[config->outputvars[i].id].aggregate=config->outputvars[i].aggregate;
     if(iscoupled(*config) && config->outputvars[i].filename.issocket)
     {
       output->files[config->outputvars[i].id].issocket=TRUE;
@@ -292,6 +461,7 @@ Outputfile *fopenoutput(const Cell grid[],   /**< LPJ grid */
 #ifdef USE_MPI
     MPI_Bcast(&output->files[config->outputvars[i].id].isopen,1,MPI_INT,
               0,config->comm);
+    openparallel(output->files+config->outputvars[i].id,filename,config->outputvars[i].id,config);
 #endif
     if(config->pedantic && config->outputvars[i].filename.fmt!=SOCK && !output->files[config->outputvars[i].id].isopen)
       return NULL;
@@ -309,6 +479,7 @@ void openoutput_yearly(Outputfile *output,int year,const Config *config)
   for(i=0;i<config->n_out;i++)
     if(config->outputvars[i].oneyear)
     {
+      filename=NULL;
       if(isroot(*config))
       {
         count=snprintf(NULL,0,config->outputvars[i].filename.name,year);
@@ -327,7 +498,10 @@ void openoutput_yearly(Outputfile *output,int year,const Config *config)
           switch(config->outputvars[i].filename.fmt)
           {
             case CLM:
-              if((output->files[config->outputvars[i].id].fp.file=fopen(filename,"wb"))==NULL)
+              if((output->files[config->outputvars[i].id].fp.file=createfile(filename,
+                  headersize(LPJOUTPUT_HEADER,config->outputvars[i].filename.version),i,
+                  getoutputtype(config->outputvars[i].id,config->grid_type),
+                  config))==NULL)
               {
                 printfcreateerr(filename);
                 output->files[config->outputvars[i].id].isopen=FALSE;
@@ -337,8 +511,8 @@ void openoutput_yearly(Outputfile *output,int year,const Config *config)
                 output->files[config->outputvars[i].id].isopen=TRUE;
                 header.firstyear=year;
                 header.nyear=1;
-                header.ncell=config->total;
-                header.firstcell=config->firstgrid;
+                header.ncell=outputncell(i,config);
+                header.firstcell=(config->outputvars[i].aggregate==NO_AGGREGATION) ? config->firstgrid : 0;
                 header.cellsize_lon=(float)config->resolution.lon;
                 header.cellsize_lat=(float)config->resolution.lat;
                 header.scalar=1;
@@ -348,17 +522,15 @@ void openoutput_yearly(Outputfile *output,int year,const Config *config)
                 header.nbands=outputsize(config->outputvars[i].id,
                                          config->npft[GRASS]+config->npft[TREE],
                                          config->npft[CROP],config);
-                if(config->outputvars[i].id==SDATE || config->outputvars[i].id==HDATE || config->outputvars[i].id==SEASONALITY)
-                  header.datatype=LPJ_SHORT;
-                else
-                  header.datatype=LPJ_FLOAT;
+                header.datatype=getoutputtype(config->outputvars[i].id,config->grid_type);
                 fwriteheader(output->files[config->outputvars[i].id].fp.file,
                              &header,LPJOUTPUT_HEADER,config->outputvars[i].filename.version);
 
               }
               break;
           case RAW:
-            if((output->files[config->outputvars[i].id].fp.file=fopen(filename,"wb"))==NULL)
+            if((output->files[config->outputvars[i].id].fp.file=createfile(filename,0,i,
+                getoutputtype(config->outputvars[i].id,config->grid_type),config))==NULL)
             {
               printfcreateerr(filename);
               output->files[config->outputvars[i].id].isopen=FALSE;
@@ -402,11 +574,12 @@ void openoutput_yearly(Outputfile *output,int year,const Config *config)
                                output->index,config);
 
           } /* of switch */
-          free(filename);
         }
      } /* of(isroot(*config)) */
 #ifdef USE_MPI
      MPI_Bcast(&output->files[config->outputvars[i].id].isopen,1,MPI_INT,0,config->comm);
+     openparallel(output->files+config->outputvars[i].id,filename,config->outputvars[i].id,config);
 #endif
+     free(filename);
    }
 } /* of 'openoutput_yearly */
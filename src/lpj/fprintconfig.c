@@ -110,6 +110,8 @@ static size_t isnetcdfinput(const Config *config)
     width=max(width,strlen(config->popdens_filename.var));
   if(config->grassharvest_filename.name!=NULL && config->grassharvest_filename.fmt==CDF)
     width=max(width,strlen(config->grassharvest_filename.var));
+  if(config->aggregate_mask_filename.name!=NULL && config->aggregate_mask_filename.fmt==CDF)
+    width=max(width,strlen(config->aggregate_mask_filename.var));
   if(config->withlanduse!=NO_LANDUSE)
   {
     if(config->countrycode_filename.fmt==CDF)
@@ -267,9 +269,10 @@ void fprintconfig(FILE *file,          /**< File pointer to text output file */
   fprintattrs(file,config->global_attrs,config->n_global);
   fprintf(file,"Simulation \"%s\"",config->sim_name);
   if(config->ntask>1)
-    fprintf(file," running on %d tasks\n",config->ntask);
-  else
-    putc('\n',file);
+    fprintf(file," running on %d tasks",config->ntask);
+  if(config->nthreads>1)
+    fprintf(file,(config->ntask>1) ? " with %d threads each" : " running on %d threads",config->nthreads);
+  putc('\n',file);
   len=0;
   if(config->landfrac_from_file)
     len=printsim(file,len,&count,"land fraction read from file");
@@ -325,7 +328,7 @@ void fprintconfig(FILE *file,          /**< File pointer to text output file */
   if(config->no_ndeposition)
     len=printsim(file,len,&count,"no N deposition");
   if(config->river_routing)
-    len=printsim(file,len,&count,"river routing");
+    len=printsim(file,len,&count,(config->ordered_routing) ? "ordered river routing" : "river routing");
   if(config->with_lakes)
     len=printsim(file,len,&count,"with lakes");
   if(config->extflow)
@@ -602,6 +605,8 @@ void fprintconfig(FILE *file,          /**< File pointer to text output file */
     printinputfile(file,"landcover",&config->landcover_filename,width,config);
   if(config->grassharvest_filename.name!=NULL)
     printinputfile(file,"Grassharvest",&config->grassharvest_filename,width,config);
+  if(config->aggregate_mask_filename.name!=NULL)
+    printinputfile(file,"aggr. mask",&config->aggregate_mask_filename,width,config);
   if(config->withlanduse!=NO_LANDUSE)
   {
     printinputfile(file,"countries",&config->countrycode_filename,width,config);
@@ -675,6 +680,27 @@ void fprintconfig(FILE *file,          /**< File pointer to text output file */
   if(ischeckpointrestart(config))
     fprintf(file,"Checkpoint restart file: '%s'.\n",
             config->checkpoint_restart_filename);
+  if(config->partition==COST_PARTITION)
+    fprintf(file,"Cells distributed on tasks according to cell cost file '%s'.\n",
+            config->cellcost_filename.name);
+  else if(config->partition==BASIN_PARTITION)
+    fputs("Cells distributed on tasks keeping drainage basins together.\n",file);
+  if(config->write_cellcost_filename!=NULL)
+    fprintf(file,"Writing cell cost file '%s' after year %d.\n",
+            config->write_cellcost_filename,
+            (config->ischeckpoint) ? config->checkpointyear+1 : config->firstyear-config->nspinup);
+  if(config->timing_filename!=NULL)
+    fprintf(file,"Writing phase timers to '%s'.\n",config->timing_filename);
+  if(config->print_timing)
+    fputs("Phase timers printed for each year.\n",file);
+  if(config->distribute_netcdf_input)
+    fputs("NetCDF climate data read by each task for its own cells.\n",file);
+  if(config->prefetch_climate)
+    fputs("Climate data of next year read in separate thread.\n",file);
+  if(config->check_netcdf_input==CHECK_ONCE)
+    fputs("NetCDF input checked for missing values only at first read.\n",file);
+  else if(config->check_netcdf_input==NO_CHECK)
+    fputs("NetCDF input not checked for missing values.\n",file);
 
 #if defined IMAGE && defined COUPLED
   if(config->sim_id==LPJML_IMAGE)
@@ -691,6 +717,10 @@ void fprintconfig(FILE *file,          /**< File pointer to text output file */
             config->coupled_model,config->coupled_host,config->coupler_port);
     if(config->wait)
       fprintf(file,"Time to wait for connection: %5d sec\n",config->wait);
+    if(config->shm_size)
+      fprintf(file,"Shared memory for inputs:    %5d MB\n",config->shm_size);
+    if(config->coupler_batch)
+      fputs("Outputs of each time step sent in one frame.\n",file);
     fprintf(file,"Number of inputs from %s: %5d\n"
             "Number of outputs to %s:  %5d\n",
             config->coupled_model,config->coupler_in,config->coupled_model,config->coupler_out);
@@ -743,6 +773,15 @@ void fprintconfig(FILE *file,          /**< File pointer to text output file */
                 config->compress_suffix,config->compress_cmd);
         break;
       }
+#ifdef USE_MPI
+    if(config->parallel_output && config->ntask>1)
+      fputs("Raw and clm output written in parallel by all tasks.\n",file);
+#endif
+    if(config->async_output)
+      fputs("Raw and clm output written in separate thread.\n",file);
+    if(config->compress_binary)
+      fprintf(file,"Raw and clm output compressed with level %d%s.\n",
+              config->compress_binary,(config->shuffle_binary) ? " and byte shuffle" : "");
     for(i=0;i<config->n_out;i++)
       if(config->outputvars[i].filename.fmt==CDF)
       {
@@ -789,6 +828,11 @@ void fprintconfig(FILE *file,          /**< File pointer to text output file */
     putc('\n',file);
     if(config->pft_output_scaled)
       fputs("PFT-specific output is grid scaled.\n",file);
+    for(i=0;i<config->n_out;i++)
+      if(config->outputvars[i].aggregate!=NO_AGGREGATION)
+        fprintf(file,"Output '%s' aggregated over %s.\n",
+                config->outnames[config->outputvars[i].id].name,
+                (config->outputvars[i].aggregate==COUNTRY_AGGREGATION) ? "countries" : "regions of mask");
   }
   else
     fputs("No output files written.\n",file);
@@ -799,6 +843,9 @@ void fprintconfig(FILE *file,          /**< File pointer to text output file */
     fprintf(file,"Spinup years:                %6d\n"
             "Cycle length during spinup:  %6d\n",
              config->nspinup,config->nspinyear);
+    if(config->spinup_tolerance>0)
+      fprintf(file,"Spinup convergence:          %6g over %d yrs\n",
+              config->spinup_tolerance,config->spinup_window);
   }
   else
     fputs("No spinup years.\n",file);
@@ -143,8 +143,16 @@ Bool fprintoutputjson(int index,           /**< index in outputvars array */
   }
   fprintf(file,"  \"name\" : \"%s\",\n",config->outnames[id].name);
   fprintf(file,"  \"variable\" : \"%s\",\n",config->outnames[id].var);
-  fprintf(file,"  \"firstcell\" : %d,\n",config->firstgrid);
-  fprintf(file,"  \"ncell\" : %d,\n",(id==ADISCHARGE) ? config->nall : config->total);
+  if(config->outputvars[index].aggregate==NO_AGGREGATION)
+    fprintf(file,"  \"firstcell\" : %d,\n",config->firstgrid);
+  else
+  {
+    /* cells are regions, values are area-weighted sums */
+    fprintf(file,"  \"aggregate\" : \"%s\",\n",
+            (config->outputvars[index].aggregate==COUNTRY_AGGREGATION) ? "country" : "mask");
+    fprintf(file,"  \"firstcell\" : 0,\n");
+  }
+  fprintf(file,"  \"ncell\" : %d,\n",outputncell(index,config));
   fprintf(file,"  \"cellsize_lon\" : %f,\n",config->resolution.lon);
   fprintf(file,"  \"cellsize_lat\" : %f,\n",config->resolution.lat);
   fprintf(file,"  \"nstep\" : %d,\n",max(1,getnyear(config->outnames,id)));
@@ -247,8 +255,11 @@ Bool fprintoutputjson(int index,           /**< index in outputvars array */
   fprintf(file,"  \"format\" : \"%s\",\n",fmt[config->outputvars[index].filename.fmt]);
   if(config->outputvars[index].filename.fmt==CLM)
     fprintf(file,"  \"version\" : %d,\n",config->outputvars[index].filename.version);
-  fprintreffile(file,index,GRID,"grid",config);
-  fprintreffile(file,index,TERR_AREA,"ref_area",config);
+  if(config->outputvars[index].aggregate==NO_AGGREGATION)
+  {
+    fprintreffile(file,index,GRID,"grid",config);
+    fprintreffile(file,index,TERR_AREA,"ref_area",config);
+  }
   fprintf(file,"  \"filename\" : \"%s\"\n",strippath(filename));
   fprintf(file,"}\n");
   fclose(file);
@@ -71,6 +71,12 @@ void freeconfig(Config *config /**< LPJmL configuration */
       pnet_free(config->irrig_back);
     }
     pnet_free(config->route);
+#ifdef USE_MPI
+    if(config->route_sub!=NULL)
+      MPI_Type_free(&config->route_sub->type);
+#endif
+    pnet_free(config->route_sub);
+    freerouteorder(config->routeorder);
   }
   if(config->wateruse)
     freefilename(&config->wateruse_filename);
@@ -97,6 +103,12 @@ void freeconfig(Config *config /**< LPJmL configuration */
   free(config->restart_filename);
   free(config->checkpoint_restart_filename);
   free(config->write_restart_filename);
+  free(config->write_cellcost_filename);
+  free(config->timing_filename);
+  free(config->cellcounts);
+  free(config->celloffsets);
+  if(config->partition==COST_PARTITION)
+    freefilename(&config->cellcost_filename);
   free(config->cult_types);
   free(config->pfttypes);
   freepftpar(config->pftpar,ivec_sum(config->npft,config->ntypes));
@@ -108,6 +120,8 @@ void freeconfig(Config *config /**< LPJmL configuration */
     freefilename(&config->popdens_filename);
   if(config->grassharvest_filename.name!=NULL)
     freefilename(&config->grassharvest_filename);
+  if(config->aggregate_mask_filename.name!=NULL)
+    freefilename(&config->aggregate_mask_filename);
   if(config->with_nitrogen  || config->fire==SPITFIRE || config->fire==SPITFIRE_TMAX)
     freefilename(&config->wind_filename);
   if(config->fire==SPITFIRE || config->fire==SPITFIRE_TMAX)
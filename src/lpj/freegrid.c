@@ -26,10 +26,7 @@ void freegrid(Cell grid[],         /**< cell grid */
   for(cell=0;cell<config->ngridcell;cell++)
   {
     if(config->river_routing)
-    {
       freequeue(grid[cell].discharge.queue);
-      free(grid[cell].discharge.tfunct);
-    }
     freelandfrac(grid[cell].ml.fertilizer_nr);
     freelandfrac(grid[cell].ml.manure_nr);
     freelandfrac(grid[cell].ml.residue_on_field);
@@ -75,5 +72,10 @@ void freegrid(Cell grid[],         /**< cell grid */
 #endif
     }
   } /* of 'for(cell=...)' */
+  if(config->river_routing)
+  {
+    free(config->tfunct);
+    free(config->queuedata);
+  }
   free(grid);
 } /* of 'freegrid' */
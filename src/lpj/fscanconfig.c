@@ -195,6 +195,9 @@ Bool fscanconfig(Config *config,    /**< LPJ configuration */
   LPJfile *input;
   Bool israndom;
   int i,restart,endgrid,grassharvest;
+#if defined USE_PTHREAD && defined USE_MPI
+  int provided;
+#endif
   Verbosity verbose;
   char *landuse[]={"no","yes","const","all_crops","only_crops"};
   char *fertilizer[]={"no","yes","auto"};
@@ -210,6 +213,8 @@ Bool fscanconfig(Config *config,    /**< LPJ configuration */
   char *nitrogen[]={"no","lim","unlim"};
   char *tillage[]={"no","all","read"};
   char *residue_treatment[]={"no_residue_remove","fixed_residue_remove","read_residue_data"};
+  char *partition[]={"equal","cost","basin"};
+  char *check_netcdf_input[]={"never","once","always"};
   Bool def[N_IN];
   verbose=(isroot(*config)) ? config->scan_verbose : NO_ERR;
 
@@ -310,10 +315,16 @@ Bool fscanconfig(Config *config,    /**< LPJ configuration */
   if(fscanbool(file,&config->with_lakes,"with_lakes",!config->pedantic,verbose))
     return TRUE;
   config->extflow=FALSE;
+  config->ordered_routing=FALSE;
+  config->route_sub=NULL;
+  config->routeorder=NULL;
+  config->tfunct=config->queuedata=NULL;
   if(config->river_routing)
   {
     if(fscanbool(file,&config->extflow,"extflow",!config->pedantic,verbose))
       return TRUE;
+    if(fscanbool(file,&config->ordered_routing,"ordered_routing",TRUE,verbose))
+      return TRUE;
   }
   config->reservoir=FALSE;
 #ifdef IMAGE
@@ -357,6 +368,36 @@ Bool fscanconfig(Config *config,    /**< LPJ configuration */
   config->storeclimate=TRUE;
   if(fscanbool(file,&config->storeclimate,"store_climate",!config->pedantic,verbose))
     return TRUE;
+  config->distribute_netcdf_input=FALSE;
+  if(fscanbool(file,&config->distribute_netcdf_input,"distribute_netcdf_input",TRUE,verbose))
+    return TRUE;
+  config->prefetch_climate=FALSE;
+  if(fscanbool(file,&config->prefetch_climate,"prefetch_climate",TRUE,verbose))
+    return TRUE;
+#ifdef USE_PTHREAD
+#ifdef USE_MPI
+  if(config->prefetch_climate)
+  {
+    MPI_Query_thread(&provided);
+    if(provided<MPI_THREAD_MULTIPLE)
+    {
+      if(isroot(*config))
+        fputs("WARNING041: MPI library does not support MPI_THREAD_MULTIPLE, prefetch of climate data disabled.\n",stderr);
+      config->prefetch_climate=FALSE;
+    }
+  }
+#endif
+#else
+  if(config->prefetch_climate)
+  {
+    if(isroot(*config))
+      fputs("WARNING041: LPJmL not compiled with -DUSE_PTHREAD, prefetch of climate data disabled.\n",stderr);
+    config->prefetch_climate=FALSE;
+  }
+#endif
+  config->check_netcdf_input=CHECK_ALWAYS;
+  if(fscankeywords(file,&config->check_netcdf_input,"check_netcdf_input",check_netcdf_input,3,TRUE,verbose))
+    return TRUE;
   config->fix_climate=FALSE;
   if(fscanbool(file,&config->fix_climate,"fix_climate",!config->pedantic,verbose))
     return TRUE;
@@ -789,6 +830,12 @@ Bool fscanconfig(Config *config,    /**< LPJ configuration */
     config->grassharvest_filename.name = NULL;
     config->lsuha_filename.name = NULL;
   }
+  if(iskeydefined(input,"aggregate_mask"))
+  {
+    scanclimatefilename(input,&config->aggregate_mask_filename,FALSE,FALSE,"aggregate_mask");
+  }
+  else
+    config->aggregate_mask_filename.name=NULL;
   if(config->landfrac_from_file)
   {
     scanclimatefilename(input,&config->landfrac_filename,FALSE,FALSE,"landfrac");
@@ -1027,6 +1074,8 @@ Bool fscanconfig(Config *config,    /**< LPJ configuration */
       return TRUE;
     }
   }
+  config->partition=EQUAL_PARTITION;
+  config->cellcounts=config->celloffsets=NULL;
   if(endgrid==-1)
   {
    /* no soilcode file found */
@@ -1044,14 +1093,75 @@ Bool fscanconfig(Config *config,    /**< LPJ configuration */
                 config->nall,config->ntask);
       return TRUE;
     }
+    if(fscankeywords(file,&config->partition,"partition",partition,3,TRUE,verbose))
+      return TRUE;
+    if(config->partition==COST_PARTITION)
+    {
+      scanfilename(file,&config->cellcost_filename,config->inputdir,"cellcost");
+      if(config->cellcost_filename.fmt==CDF)
+      {
+        if(verbose)
+          fprintf(stderr,"ERROR280: Cell cost file '%s' must not be in NetCDF format.\n",
+                  config->cellcost_filename.name);
+        return TRUE;
+      }
+    }
+    else if(config->partition==BASIN_PARTITION && (!config->river_routing || config->drainage_filename.fmt==CDF))
+    {
+      if(verbose)
+        fputs("WARNING045: Partition by drainage basins requires river routing and drainage file not in NetCDF format, equal partition used.\n",stderr);
+      config->partition=EQUAL_PARTITION;
+    }
     if(config->ntask>1) /* parallel mode? */
-      divide(&config->startgrid,&endgrid,config->rank,
-             config->ntask);
+    {
+      if(config->partition==COST_PARTITION)
+      {
+        if(divide_cost(&config->startgrid,&endgrid,&config->cellcost_filename,config))
+        {
+          if(verbose)
+            fputs("ERROR265: Cannot distribute cells according to cell cost file.\n",stderr);
+          return TRUE;
+        }
+      }
+      else if(config->partition==BASIN_PARTITION)
+      {
+        if(divide_basin(&config->startgrid,&endgrid,&config->drainage_filename,config))
+        {
+          if(verbose)
+            fputs("ERROR267: Cannot distribute cells according to drainage file.\n",stderr);
+          return TRUE;
+        }
+      }
+      else
+        divide(&config->startgrid,&endgrid,config->rank,
+               config->ntask);
+    }
     config->ngridcell=endgrid-config->startgrid+1;
+    /* distribution of cells does not change, counts are determined only once */
+    if(initcellcounts(config))
+      return TRUE;
   }
+  config->write_cellcost_filename=NULL;
+  if(iskeydefined(file,"write_cellcost_filename") && !isnull(file,"write_cellcost_filename"))
+  {
+    fscanname(file,name,"write_cellcost_filename");
+    config->write_cellcost_filename=addpath(name,config->outputdir);
+    checkptr(config->write_cellcost_filename);
+  }
+  config->timing_filename=NULL;
+  if(iskeydefined(file,"timing_filename") && !isnull(file,"timing_filename"))
+  {
+    fscanname(file,name,"timing_filename");
+    config->timing_filename=addpath(name,config->outputdir);
+    checkptr(config->timing_filename);
+  }
+  config->print_timing=FALSE;
+  if(fscanbool(file,&config->print_timing,"print_timing",TRUE,verbose))
+    return TRUE;
   fscanint2(file,&config->nspinup,"nspinup");
   config->isfirstspinupyear=FALSE;
   config->shuffle_spinup_climate=FALSE;
+  config->spinup_tolerance=0;
   if(config->nspinup)
   {
     if(config->nspinup<0)
@@ -1076,6 +1186,28 @@ Bool fscanconfig(Config *config,    /**< LPJ configuration */
       fscanint2(file,&config->firstspinupyear,"firstspinupyear");
       config->isfirstspinupyear=TRUE;
     }
+    if(fscanreal(file,&config->spinup_tolerance,"spinup_tolerance",TRUE,verbose))
+      return TRUE;
+    if(config->spinup_tolerance<0)
+    {
+      if(verbose)
+        fprintf(stderr,"ERROR269: Tolerance for convergence in spinup=%g must be greater than or equal to zero.\n",
+                config->spinup_tolerance);
+      return TRUE;
+    }
+    if(config->spinup_tolerance>0)
+    {
+      config->spinup_window=50;
+      if(fscanint(file,&config->spinup_window,"spinup_window",TRUE,verbose))
+        return TRUE;
+      if(config->spinup_window<1)
+      {
+        if(verbose)
+          fprintf(stderr,"ERROR270: Window for convergence in spinup=%d must be greater than zero.\n",
+                  config->spinup_window);
+        return TRUE;
+      }
+    }
   }
   fscanint2(file,&config->firstyear,"firstyear");
   fscanint2(file,&config->lastyear,"lastyear");
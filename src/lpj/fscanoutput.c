@@ -31,6 +31,37 @@ static Bool isopenoutput(int id,const Outputvar output[],int n)
   return FALSE; /* not found */
 } /* of 'isopenoutput' */
 
+static char *aggregation[]={"none","country","mask"};
+
+static Bool checkaggregate(const Outputvar *output,const Config *config,Verbosity verbosity)
+{
+  /* checks whether output can be aggregated over regions */
+  if((output->filename.fmt!=RAW && output->filename.fmt!=CLM && output->filename.fmt!=TXT) ||
+     getnyear(config->outnames,output->id)==0 || output->id==ADISCHARGE || output->id==GLOBALFLUX ||
+     getoutputtype(output->id,config->grid_type)!=LPJ_FLOAT)
+  {
+    if(verbosity)
+      fprintf(stderr,"ERROR277: Output '%s' in format '%s' cannot be aggregated, only float outputs in raw, clm or txt format allowed.\n",
+              config->outnames[output->id].name,fmt[output->filename.fmt]);
+    return TRUE;
+  }
+  if(output->aggregate==COUNTRY_AGGREGATION && config->withlanduse==NO_LANDUSE)
+  {
+    if(verbosity)
+      fprintf(stderr,"ERROR278: Aggregation of output '%s' over countries requires land use.\n",
+              config->outnames[output->id].name);
+    return TRUE;
+  }
+  if(output->aggregate==MASK_AGGREGATION && config->aggregate_mask_filename.name==NULL)
+  {
+    if(verbosity)
+      fprintf(stderr,"ERROR281: Aggregation of output '%s' over mask requires 'aggregate_mask' input.\n",
+              config->outnames[output->id].name);
+    return TRUE;
+  }
+  return FALSE;
+} /* of 'checkaggregate' */
+
 static int findid(const char *name,const Variable var[],int size)
 {
   int i;
@@ -164,6 +195,41 @@ Bool fscanoutput(LPJfile *file,  /**< pointer to LPJ file */
   config->flush_output=FALSE;
   if(fscanbool(file,&config->flush_output,"flush_output",!config->pedantic,verbosity))
     return TRUE;
+  config->parallel_output=FALSE;
+  if(fscanbool(file,&config->parallel_output,"parallel_output",TRUE,verbosity))
+    return TRUE;
+  config->async_output=FALSE;
+  if(fscanbool(file,&config->async_output,"async_output",TRUE,verbosity))
+    return TRUE;
+#ifndef USE_PTHREAD
+  if(config->async_output)
+  {
+    if(isroot(*config))
+      fputs("WARNING044: LPJmL not compiled with -DUSE_PTHREAD, asynchronous output disabled.\n",stderr);
+    config->async_output=FALSE;
+  }
+#endif
+  config->compress_binary=0;
+  if(fscanint(file,&config->compress_binary,"compress_binary",TRUE,verbosity))
+    return TRUE;
+  if(config->compress_binary<0 || config->compress_binary>9)
+  {
+    if(verbosity)
+      fprintf(stderr,"ERROR275: Invalid compression level %d for raw and clm output, must be in [0,9].\n",
+              config->compress_binary);
+    return TRUE;
+  }
+  config->shuffle_binary=FALSE;
+  if(fscanbool(file,&config->shuffle_binary,"shuffle_binary",TRUE,verbosity))
+    return TRUE;
+#ifndef USE_ZLIB
+  if(config->compress_binary)
+  {
+    if(isroot(*config))
+      fputs("WARNING048: LPJmL not compiled with -DUSE_ZLIB, raw and clm output not compressed.\n",stderr);
+    config->compress_binary=0;
+  }
+#endif
   config->rev_lat=FALSE;
   if(fscanbool(file,&config->rev_lat,"rev_lat",!config->pedantic,verbosity))
     return TRUE;
@@ -227,6 +293,12 @@ Bool fscanoutput(LPJfile *file,  /**< pointer to LPJ file */
       fscanint2(item,&flag,"id");
     }
     config->outputvars[count].filename.meta=metafile;
+    config->outputvars[count].aggregate=NO_AGGREGATION;
+    if(iskeydefined(item,"aggregate"))
+    {
+      if(fscankeywords(item,&config->outputvars[count].aggregate,"aggregate",aggregation,3,FALSE,verbosity))
+        return TRUE;
+    }
     config->outputvars[count].filename.issocket=FALSE;
     config->outputvars[count].filename.id=flag;
     if(version>0)
@@ -298,6 +370,9 @@ Bool fscanoutput(LPJfile *file,  /**< pointer to LPJ file */
                   fmt[config->outputvars[count].filename.fmt]);
         return TRUE;
       }
+      if(config->outputvars[count].aggregate!=NO_AGGREGATION &&
+         checkaggregate(config->outputvars+count,config,verbosity))
+        return TRUE;
       if(config->outputvars[count].filename.issocket)
         config->coupler_out++;
       if(config->outputvars[count].filename.var!=NULL)
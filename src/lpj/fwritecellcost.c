@@ -0,0 +1,114 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                 f  w  r  i  t  e  c  e  l  l  c  o  s  t  .  c                 \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function writes wall clock time spent in each cell into a CLM file.        \n**/
+/**     File can be used by divide_cost() for a cost-aware distribution of         \n**/
+/**     the cell grid on the parallel tasks.                                       \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+Bool fwritecellcost(const char *filename, /**< filename of cell cost file */
+                    const Cell grid[],    /**< LPJ grid */
+                    int year,             /**< simulation year cost was measured (AD) */
+                    const Config *config  /**< LPJmL configuration */
+                   )                      /** \return TRUE on error */
+{
+  FILE *file;
+  Header header;
+  float *vec,*global;
+  int cell,rc;
+#ifdef USE_MPI
+  int *counts,*offsets;
+#endif
+  vec=newvec(float,config->ngridcell);
+  if(vec==NULL)
+  {
+    printallocerr("vec");
+    rc=TRUE;
+  }
+  else
+  {
+    for(cell=0;cell<config->ngridcell;cell++)
+      vec[cell]=(float)grid[cell].cost;
+    rc=FALSE;
+  }
+  global=NULL;
+  if(isroot(*config) && !rc)
+  {
+    global=newvec(float,config->nall);
+    if(global==NULL)
+    {
+      printallocerr("global");
+      rc=TRUE;
+    }
+  }
+  if(iserror(rc,config))
+  {
+    free(vec);
+    free(global);
+    return TRUE;
+  }
+#ifdef USE_MPI
+  counts=newvec(int,config->ntask);
+  check(counts);
+  offsets=newvec(int,config->ntask);
+  check(offsets);
+  getcellcounts(counts,offsets,1,config);
+  MPI_Gatherv(vec,config->ngridcell,MPI_FLOAT,global,counts,offsets,MPI_FLOAT,0,config->comm);
+  free(counts);
+  free(offsets);
+#else
+  for(cell=0;cell<config->ngridcell;cell++)
+    global[cell]=vec[cell];
+#endif
+  free(vec);
+  rc=FALSE;
+  if(isroot(*config))
+  {
+    file=fopen(filename,"wb");
+    if(file==NULL)
+    {
+      printfcreateerr(filename);
+      rc=TRUE;
+    }
+    else
+    {
+      header.order=CELLYEAR;
+      header.firstyear=year;
+      header.nyear=1;
+      header.firstcell=config->firstgrid;
+      header.ncell=config->nall;
+      header.nbands=1;
+      header.nstep=1;
+      header.timestep=1;
+      header.cellsize_lon=(float)config->resolution.lon;
+      header.cellsize_lat=(float)config->resolution.lat;
+      header.scalar=1;
+      header.datatype=LPJ_FLOAT;
+      fwriteheader(file,&header,LPJ_CELLCOST_HEADER,LPJ_CELLCOST_VERSION);
+      if(fwrite(global,sizeof(float),config->nall,file)!=config->nall)
+      {
+        fprintf(stderr,"ERROR204: Cannot write cell cost file '%s': %s.\n",
+                filename,strerror(errno));
+        rc=TRUE;
+      }
+      fclose(file);
+    }
+    free(global);
+  }
+#ifdef USE_MPI
+  MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
+#endif
+  return rc;
+} /* of 'fwritecellcost' */
@@ -24,6 +24,11 @@ static void flush_output(Outputfile *output,int index)
   switch(output->files[index].fmt)
   {
     case RAW: case CLM: case TXT:
+      flushwriter(output->writer);
+#ifdef USE_MPI
+      if(output->files[index].isparallel)
+        break; /* no stdio buffer for files written by MPI-IO */
+#endif
       fflush(output->files[index].fp.file);
       break;
     case CDF:
@@ -32,6 +37,42 @@ static void flush_output(Outputfile *output,int index)
   }
 }
 
+#ifdef USE_MPI
+static int mpi_write_file(Outputfile *output,int index,void *data,MPI_Datatype type,int size,
+                          int counts[],int offsets[],int rank,MPI_Comm comm)
+{
+  MPI_Aint lb;
+  MPI_Aint extent;
+  void *vec=NULL;
+  if(output->files[index].isparallel)
+    return mpi_write_at(output->files[index].fh,&output->files[index].offset,data,type,size,counts,offsets,rank);
+  if(output->writer==NULL)
+    return mpi_write(output->files[index].fp.file,data,type,size,counts,offsets,rank,comm);
+  /* data are gathered on root task and written by writer thread */
+  MPI_Type_get_extent(type,&lb,&extent);
+  if(rank==0)
+  {
+    vec=malloc(size*extent); /* allocate receive buffer */
+    check(vec);
+  }
+  MPI_Gatherv(data,counts[rank],type,vec,counts,offsets,type,0,comm);
+  if(rank==0)
+  {
+    putwriter(output->writer,output->files[index].fp.file,vec,size*extent);
+    free(vec);
+  }
+  return size;
+} /* of 'mpi_write_file' */
+#else
+static void writefile(Outputfile *output,int index,const void *data,size_t size,size_t n)
+{
+  if(output->writer!=NULL)
+    putwriter(output->writer,output->files[index].fp.file,data,size*n);
+  else if(fwrite(data,size,n,output->files[index].fp.file)!=n)
+    fprintf(stderr,"ERROR204: Cannot write output: %s.\n",strerror(errno));
+} /* of 'writefile' */
+#endif
+
 #define iswrite(output,index) (isopen(output,index) && iswrite2(index,timestep,year,config))
 
 #define writeoutputvar(index,scale) if(iswrite(output,index))\
@@ -47,7 +88,7 @@ static void flush_output(Outputfile *output,int index)
 
 #define writeoutputarray(index,scale) if(iswrite(output,index))\
   {\
-    outindex(output,index,year,date,config);\
+    outindex(output,index,LPJ_FLOAT,year,date,config);\
     for(i=0;i<config->outputsize[index];i++)\
     {\
       count=0;\
@@ -62,7 +103,7 @@ static void flush_output(Outputfile *output,int index)
 
 #define writeoutputshortvar(index) if(iswrite(output,index))\
   {\
-    outindex(output,index,year,date,config);\
+    outindex(output,index,LPJ_SHORT,year,date,config);\
     svec=newvec(short,config->count);\
     check(svec);\
     for(i=0;i<config->outputsize[index];i++)\
@@ -86,12 +127,110 @@ static Bool iswrite2(int index,int timestep,int year,const Config *config)
     return config->outnames[index].timestep==timestep;
 } /* of 'iswrite2' */
 
-static void outindex(Outputfile *output,int index,int year,int date,const Config *config)
+static void outindex(Outputfile *output,int index,Type type,int year,int date,const Config *config)
 {
-  if(output->files[index].issocket)
+  /* header of float outputs is sent with the frame if batched output is enabled */
+  if(output->files[index].issocket && (type!=LPJ_FLOAT || output->batch_index==NULL))
     send_output_coupler(output->files[index].id,year,date,config);
 } /* of 'outindex' */
 
+static void addbatch(Outputfile *output,int index,const float data[],const Config *config)
+{
+  /* append band of output to frame */
+  if(output->nbatch==0 || output->batch_index[output->nbatch-1]!=index)
+  {
+    output->batch_index[output->nbatch]=index;
+    output->batch_size[output->nbatch++]=0;
+  }
+  if(output->nband==output->maxband)
+  {
+    output->maxband=(output->maxband==0) ? 16 : 2*output->maxband;
+    output->batch=realloc(output->batch,sizeof(float)*output->maxband*config->count);
+    check(output->batch);
+  }
+  memcpy(output->batch+output->nband*config->count,data,sizeof(float)*config->count);
+  output->batch_size[output->nbatch-1]++;
+  output->nband++;
+} /* of 'addbatch' */
+
+static void sendbatch(Outputfile *output,int year,int date,const Config *config)
+{
+  /* send all outputs of time step collected in frame to coupled model */
+  Sockbuffer vec[3];
+  int header[4];
+  int *id=NULL;
+  int i,n;
+  float *data;
+#ifdef USE_MPI
+  int *counts,*offsets;
+  int j,b;
+  float *vec_all=NULL;
+#endif
+  if(output->nbatch==0)
+    return;
+#ifdef USE_MPI
+  /* gather all bands of all outputs with one call */
+  counts=newvec(int,config->ntask);
+  check(counts);
+  offsets=newvec(int,config->ntask);
+  check(offsets);
+  for(i=0;i<config->ntask;i++)
+  {
+    counts[i]=output->counts[i]*output->nband;
+    offsets[i]=output->offsets[i]*output->nband;
+  }
+  if(isroot(*config))
+  {
+    vec_all=newvec(float,config->total*output->nband);
+    check(vec_all);
+  }
+  MPI_Gatherv(output->batch,counts[config->rank],MPI_FLOAT,vec_all,counts,offsets,MPI_FLOAT,0,config->comm);
+  free(counts);
+  free(offsets);
+  if(isroot(*config))
+  {
+    /* reorder data from task and band order into band and cell order */
+    data=newvec(float,config->total*output->nband);
+    check(data);
+    for(i=0;i<config->ntask;i++)
+      for(b=0;b<output->nband;b++)
+        for(j=0;j<output->counts[i];j++)
+          data[b*config->total+output->offsets[i]+j]=vec_all[output->offsets[i]*output->nband+b*output->counts[i]+j];
+    free(vec_all);
+  }
+#else
+  data=output->batch;
+#endif
+  if(isroot(*config))
+  {
+    n=0;
+    header[n++]=PUT_DATA_BATCH;
+    header[n++]=output->nbatch;
+    header[n++]=year;
+    header[n++]=date; /* batched output requires version COUPLER_VERSION_SHM */
+    id=newvec(int,2*output->nbatch);
+    check(id);
+    for(i=0;i<output->nbatch;i++)
+    {
+      id[i]=output->files[output->batch_index[i]].id;
+      id[output->nbatch+i]=output->batch_size[i]*config->total;
+    }
+    vec[0].data=header;
+    vec[0].size=sizeof(int)*n;
+    vec[1].data=id;
+    vec[1].size=sizeof(int)*2*output->nbatch;
+    vec[2].data=data;
+    vec[2].size=sizeof(float)*output->nband*config->total;
+    if(writevec_socket(config->socket,vec,3))
+      fprintf(stderr,"ERROR100: Cannot write output to socket.\n");
+    free(id);
+#ifdef USE_MPI
+    free(data);
+#endif
+  }
+  output->nbatch=output->nband=0;
+} /* of 'sendbatch' */
+
 static Real getscale(int date,int ndata,int timestep,Time time)
 {
   Real scale;
@@ -135,6 +274,59 @@ static Real getscale(int date,int ndata,int timestep,Time time)
   return scale;
 } /* of 'getscale' */
 
+static void writeaggregate(Outputfile *output,int index,const float data[],
+                           const Config *config)
+{
+  /* area-weighted sums over regions are reduced on root task and written */
+  const int *region;
+  double *sum;
+  float *vec;
+  int i,n;
+  if(output->files[index].aggregate==COUNTRY_AGGREGATION)
+  {
+    region=output->countrycode;
+    n=config->ncountries;
+  }
+  else
+  {
+    region=output->mask;
+    n=config->nmask;
+  }
+  sum=newvec(double,n);
+  check(sum);
+  for(i=0;i<n;i++)
+    sum[i]=0;
+  for(i=0;i<config->count;i++)
+    if(region[i]>=0)
+      sum[region[i]]+=data[i]*output->area[i];
+#ifdef USE_MPI
+  MPI_Reduce((isroot(*config)) ? MPI_IN_PLACE : sum,sum,n,MPI_DOUBLE,MPI_SUM,0,config->comm);
+#endif
+  if(isroot(*config) && output->files[index].isopen)
+  {
+    vec=newvec(float,n);
+    check(vec);
+    for(i=0;i<n;i++)
+      vec[i]=(float)sum[i];
+    switch(output->files[index].fmt)
+    {
+      case RAW: case CLM:
+        if(output->writer!=NULL)
+          putwriter(output->writer,output->files[index].fp.file,vec,sizeof(float)*n);
+        else if(fwrite(vec,sizeof(float),n,output->files[index].fp.file)!=n)
+          fprintf(stderr,"ERROR204: Cannot write output: %s.\n",strerror(errno));
+        break;
+      case TXT:
+        for(i=0;i<n-1;i++)
+          fprintf(output->files[index].fp.file,"%g%c",vec[i],config->csv_delimit);
+        fprintf(output->files[index].fp.file,"%g\n",vec[n-1]);
+        break;
+    }
+    free(vec);
+  }
+  free(sum);
+} /* of 'writeaggregate' */
+
 static void writedata(Outputfile *output,int index,float data[],int year,int date,int ndata,
                       const Config *config)
 {
@@ -143,12 +335,17 @@ static void writedata(Outputfile *output,int index,float data[],int year,int dat
   scale=getscale(date,ndata,(config->outnames[index].timestep==ANNUAL) ? 1 : config->outnames[index].timestep,config->outnames[index].time);
   for(i=0;i<config->count;i++)
     data[i]=(float)(config->outnames[index].scale*scale*data[i]+config->outnames[index].offset);
+  if(output->files[index].aggregate!=NO_AGGREGATION)
+  {
+    writeaggregate(output,index,data,config);
+    return;
+  }
 #ifdef USE_MPI
   if(output->files[index].isopen)
     switch(output->files[index].fmt)
     {
       case RAW: case CLM:
-        mpi_write(output->files[index].fp.file,data,MPI_FLOAT,config->total,
+        mpi_write_file(output,index,data,MPI_FLOAT,config->total,
                   output->counts,output->offsets,config->rank,config->comm);
         break;
       case TXT:
@@ -172,17 +369,21 @@ static void writedata(Outputfile *output,int index,float data[],int year,int dat
     }
   if(output->files[index].issocket)
   {
-    send_output_coupler(index,year,date,config);
-    mpi_write_socket(config->socket,data,MPI_FLOAT,config->total,
-                     output->counts,output->offsets,config->rank,config->comm);
+    if(output->batch_index!=NULL)
+      addbatch(output,index,data,config);
+    else
+    {
+      send_output_coupler(index,year,date,config);
+      mpi_write_socket(config->socket,data,MPI_FLOAT,config->total,
+                       output->counts,output->offsets,config->rank,config->comm);
+    }
   }
 #else
   if(output->files[index].isopen)
     switch(output->files[index].fmt)
     {
       case RAW: case CLM:
-        if(fwrite(data,sizeof(float),config->count,output->files[index].fp.file)!=config->count)
-          fprintf(stderr,"ERROR204: Cannot write output: %s.\n",strerror(errno));
+        writefile(output,index,data,sizeof(float),config->count);
         break;
       case TXT:
         for(i=0;i<config->count-1;i++)
@@ -206,8 +407,13 @@ static void writedata(Outputfile *output,int index,float data[],int year,int dat
     }
   if(output->files[index].issocket)
   {
-    send_output_coupler(index,year,date,config);
-    writefloat_socket(config->socket,data,config->count);
+    if(output->batch_index!=NULL)
+      addbatch(output,index,data,config);
+    else
+    {
+      send_output_coupler(index,year,date,config);
+      writefloat_socket(config->socket,data,config->count);
+    }
   }
 #endif
 } /* of 'writedata' */
@@ -221,7 +427,7 @@ static void writeshortdata(Outputfile *output,int index,short data[],int year,in
     switch(output->files[index].fmt)
     {
       case RAW: case CLM:
-        mpi_write(output->files[index].fp.file,data,MPI_SHORT,config->total,
+        mpi_write_file(output,index,data,MPI_SHORT,config->total,
                   output->counts,output->offsets,config->rank,config->comm);
         break;
       case TXT:
@@ -255,7 +461,7 @@ static void writeshortdata(Outputfile *output,int index,short data[],int year,in
     switch(output->files[index].fmt)
     {
       case RAW: case CLM:
-        fwrite(data,sizeof(short),config->count,output->files[index].fp.file);
+        writefile(output,index,data,sizeof(short),config->count);
         break;
       case TXT:
         for(i=0;i<config->count-1;i++)
@@ -301,12 +507,12 @@ static void writealldata(Outputfile *output,int index,float data[],int year,int
   check(counts);
   offsets=newvec(int,config->ntask);
   check(offsets);
-  getcounts(counts,offsets,config->nall,1,config->ntask);
+  getcellcounts(counts,offsets,1,config);
   if(output->files[index].isopen)
     switch(output->files[index].fmt)
     {
       case RAW: case CLM:
-        mpi_write(output->files[index].fp.file,data,MPI_FLOAT,config->nall,counts,
+        mpi_write_file(output,index,data,MPI_FLOAT,config->nall,counts,
                   offsets,config->rank,config->comm);
         break;
       case TXT:
@@ -341,7 +547,7 @@ static void writealldata(Outputfile *output,int index,float data[],int year,int
     switch(output->files[index].fmt)
     {
       case RAW: case CLM:
-        fwrite(data,sizeof(float),config->ngridcell,output->files[index].fp.file);
+        writefile(output,index,data,sizeof(float),config->ngridcell);
         break;
       case TXT:
         for(i=0;i<config->ngridcell-1;i++)
@@ -379,12 +585,17 @@ static void writepft(Outputfile *output,int index,float *data,int year,
   scale=getscale(date,ndata,(config->outnames[index].timestep==ANNUAL) ? 1 : config->outnames[index].timestep,config->outnames[index].time);
   for(i=0;i<config->count;i++)
     data[i]=(float)(config->outnames[index].scale*scale*data[i]+config->outnames[index].offset);
+  if(output->files[index].aggregate!=NO_AGGREGATION)
+  {
+    writeaggregate(output,index,data,config);
+    return;
+  }
 #ifdef USE_MPI
   if(output->files[index].isopen)
     switch(output->files[index].fmt)
     {
       case RAW: case CLM:
-        mpi_write(output->files[index].fp.file,data,MPI_FLOAT,config->total,
+        mpi_write_file(output,index,data,MPI_FLOAT,config->total,
                   output->counts,output->offsets,config->rank,config->comm);
         break;
       case TXT:
@@ -409,16 +620,18 @@ static void writepft(Outputfile *output,int index,float *data,int year,
     }
   if(output->files[index].issocket)
   {
-    mpi_write_socket(config->socket,data,MPI_FLOAT,config->total,
-                     output->counts,output->offsets,config->rank,config->comm);
+    if(output->batch_index!=NULL)
+      addbatch(output,index,data,config);
+    else
+      mpi_write_socket(config->socket,data,MPI_FLOAT,config->total,
+                       output->counts,output->offsets,config->rank,config->comm);
   }
 #else
   if(output->files[index].isopen)
     switch(output->files[index].fmt)
     {
       case RAW: case CLM:
-        if(fwrite(data,sizeof(float),config->count,output->files[index].fp.file)!=config->count)
-          fprintf(stderr,"ERROR204: Cannot write output: %s.\n",strerror(errno));
+        writefile(output,index,data,sizeof(float),config->count);
         break;
       case TXT:
         for(i=0;i<config->count-1;i++)
@@ -440,7 +653,12 @@ static void writepft(Outputfile *output,int index,float *data,int year,
         break;
     }
   if(output->files[index].issocket)
-    writefloat_socket(config->socket,data,config->count);
+  {
+    if(output->batch_index!=NULL)
+      addbatch(output,index,data,config);
+    else
+      writefloat_socket(config->socket,data,config->count);
+  }
 #endif
 } /* of 'writepft' */
 
@@ -455,7 +673,7 @@ static void writeshortpft(Outputfile *output,int index,short *data,int year,
     switch(output->files[index].fmt)
     {
       case RAW: case CLM:
-        mpi_write(output->files[index].fp.file,data,MPI_SHORT,config->total,
+        mpi_write_file(output,index,data,MPI_SHORT,config->total,
                   output->counts,output->offsets,config->rank,config->comm);
         break;
       case TXT:
@@ -486,8 +704,7 @@ static void writeshortpft(Outputfile *output,int index,short *data,int year,
     switch(output->files[index].fmt)
     {
       case RAW: case CLM:
-        if(fwrite(data,sizeof(short),config->count,output->files[index].fp.file)!=config->count)
-          fprintf(stderr,"ERROR204: Cannot write output: %s.\n",strerror(errno));
+        writefile(output,index,data,sizeof(short),config->count);
         break;
       case TXT:
         for(i=0;i<config->count-1;i++)
@@ -551,7 +768,7 @@ void fwriteoutput(Outputfile *output,  /**< output file array */
   }
   if(iswrite(output,SEASONALITY))
   {
-    outindex(output,SEASONALITY,year,date,config);
+    outindex(output,SEASONALITY,LPJ_SHORT,year,date,config);
     count=0;
     svec=newvec(short,config->ngridcell);
     check(svec);
@@ -1217,7 +1434,7 @@ void fwriteoutput(Outputfile *output,  /**< output file array */
   }
   if(iswrite(output,PFT_GCGP))
   {
-    outindex(output,PFT_GCGP,year,date,config);
+    outindex(output,PFT_GCGP,LPJ_FLOAT,year,date,config);
     for(i=0;i<nnat+nirrig;i++)
     {
       count=0;
@@ -1952,4 +2169,6 @@ void fwriteoutput(Outputfile *output,  /**< output file array */
     writeoutputarray(PFT_NUPTAKE2,1);
   }
   free(vec);
+  if(output->batch_index!=NULL)
+    sendbatch(output,year,date,config);
 } /* of 'fwriteoutput' */
@@ -4,7 +4,9 @@
 /**                                                                                \n**/
 /**     C implementation of LPJmL                                                  \n**/
 /**                                                                                \n**/
-/**     Functions writes restart file.                                             \n**/
+/**     Functions writes restart file. Cells are serialized into one memory        \n**/
+/**     buffer and written with a single call. In the MPI version all tasks        \n**/
+/**     write in parallel at offsets calculated by MPI_Exscan() using MPI-IO.      \n**/
 /**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
@@ -16,11 +18,64 @@
 
 #include "lpj.h"
 
-#ifndef _WIN32
-#include <unistd.h>
-#endif
+static void writeheader(FILE *file,           /**< pointer to restart file */
+                        int npft,             /**< number of natural PFTs */
+                        int ncft,             /**< number of crop PFTs */
+                        int year,             /**< year */
+                        const Config *config  /**< LPJ configuration */
+                       )
+{
+  Header header;
+  Restartheader restartheader;
+  int i;
+  /* set header data */
+  header.order=CELLYEAR;
+  header.firstyear=year;
+  header.nyear=1;
+  header.firstcell=config->startgrid;
+  header.ncell=config->nall;
+  header.nbands=npft+ncft;
+  header.scalar=1;
+  header.cellsize_lat=(float)config->resolution.lat;
+  header.cellsize_lon=(float)config->resolution.lon;
+  header.datatype=(sizeof(Real)==sizeof(float)) ? LPJ_FLOAT : LPJ_DOUBLE;
+  /* write header */
+  fwriteheader(file,&header,RESTART_HEADER,RESTART_VERSION);
+  restartheader.landuse=(config->withlanduse!=NO_LANDUSE);
+  restartheader.sdate_option=config->sdate_option;
+  restartheader.crop_option=config->crop_phu_option==PRESCRIBED_CROP_PHU;
+  restartheader.river_routing=config->river_routing;
+  restartheader.separate_harvests=config->separate_harvests;
+  for(i=0;i<NSEED;i++)
+    restartheader.seed[i]=config->seed[i];
+  fwriterestartheader(file,&restartheader);
+} /* of 'writeheader' */
+
+#ifdef USE_MPI
 
-#define MSGTAG 101 /* MPI message tag */
+#define MAXCHUNK (1<<30) /* maximum number of bytes written in one call */
+
+static Bool writeat(MPI_File fh,      /**< MPI file handle */
+                    MPI_Offset offset, /**< offset in file (bytes) */
+                    const char *data, /**< data to write */
+                    size_t size       /**< number of bytes to write */
+                   )                  /** \return TRUE on error */
+{
+  MPI_Status status;
+  int count;
+  while(size>0)
+  {
+    count=(size>MAXCHUNK) ? MAXCHUNK : (int)size;
+    if(MPI_File_write_at(fh,offset,(void *)data,count,MPI_BYTE,&status)!=MPI_SUCCESS)
+      return TRUE;
+    offset+=count;
+    data+=count;
+    size-=count;
+  }
+  return FALSE;
+} /* of 'writeat' */
+
+#endif
 
 Bool fwriterestart(const Cell grid[],   /**< cell array               */
                    int npft,            /**< number of natural PFTs   */
@@ -32,102 +87,98 @@ Bool fwriterestart(const Cell grid[],   /**< cell array               */
                   )                     /** \return TRUE on error     */
 {
 #ifdef USE_MPI
-  MPI_Status status;
-  Bool iserror;
+  MPI_File fh;
+  long long size;
 #endif
+  long long offset,start;
   FILE *file;
   long long *index;
-  Header header;
-  Restartheader restartheader;
+  char *buffer;
+  size_t len;
+  Bool rc;
   int i;
+  rc=FALSE;
   if(isroot(*config))
-    /* create file */
-    file=fopen(filename,"wb");
-  else
   {
-#ifdef USE_MPI
-    /* wait until previous task has finished work */
-    MPI_Recv(&iserror,1,MPI_INT,config->rank-1,MSGTAG,config->comm,&status);
-    if(iserror)
+    /* create file and write header */
+    file=fopen(filename,"wb");
+    if(file==NULL)
     {
-      if(config->rank<config->ntask-1)
-        MPI_Send(&iserror,1,MPI_INT,config->rank+1,MSGTAG,config->comm);
-      return TRUE;
+      printfcreateerr(filename);
+      rc=TRUE;
+    }
+    else
+    {
+      writeheader(file,npft,ncft,year,config);
+      fclose(file);
     }
-#endif
-    /* append file */
-    file=fopen(filename,"r+b");
   }
-  if(file==NULL)
+  if(iserror(rc,config))
+    return TRUE;
+  index=newvec(long long,config->ngridcell);
+  check(index);
+  /* serialize cells of this task into one buffer */
+  buffer=serializecells(&len,index,grid,config->ngridcell,ncft,npft,ischeckpoint,config);
+  if(buffer==NULL)
   {
-    printfcreateerr(filename);
-#ifdef USE_MPI
-    iserror=TRUE;
-    if(config->rank<config->ntask-1)
-      MPI_Send(&iserror,1,MPI_INT,config->rank+1,MSGTAG,config->comm);
-#endif
+    printallocerr("buffer");
+    rc=TRUE;
+  }
+  if(iserror(rc,config))
+  {
+    free(buffer);
+    free(index);
     return TRUE;
   }
+  /* calculate offset of cell data of this task in file */
+#ifdef USE_MPI
+  size=len;
+  MPI_Exscan(&size,&start,1,MPI_LONG_LONG,MPI_SUM,config->comm);
   if(isroot(*config))
+    start=0; /* result of MPI_Exscan() is undefined on first task */
+#else
+  start=0;
+#endif
+  offset=headersize(RESTART_HEADER,RESTART_VERSION)+restartsize();
+  start+=offset+sizeof(long long)*config->nall;
+  for(i=0;i<config->ngridcell;i++)
+    index[i]+=start;
+  offset+=sizeof(long long)*(config->startgrid-config->firstgrid);
+#ifdef USE_MPI
+  if(MPI_File_open(config->comm,(char *)filename,MPI_MODE_WRONLY,MPI_INFO_NULL,&fh)!=MPI_SUCCESS)
   {
-    /* set header data */
-    header.order=CELLYEAR;
-    header.firstyear=year;
-    header.nyear=1;
-    header.firstcell=config->startgrid;
-    header.ncell=config->nall;
-    header.nbands=npft+ncft;
-    header.scalar=1;
-    header.cellsize_lat=(float)config->resolution.lat;
-    header.cellsize_lon=(float)config->resolution.lon;
-    header.datatype=(sizeof(Real)==sizeof(float)) ? LPJ_FLOAT : LPJ_DOUBLE;
-    /* write header */
-    fwriteheader(file,&header,RESTART_HEADER,RESTART_VERSION);
-    restartheader.landuse=(config->withlanduse!=NO_LANDUSE);
-    restartheader.sdate_option=config->sdate_option;
-    restartheader.crop_option=config->crop_phu_option==PRESCRIBED_CROP_PHU;
-    restartheader.river_routing=config->river_routing;
-    restartheader.separate_harvests=config->separate_harvests;
-    for(i=0;i<NSEED;i++)
-      restartheader.seed[i]=config->seed[i];
-    fwriterestartheader(file,&restartheader);
-    /* skip index vector */
-    fseek(file,sizeof(long long)*config->nall,SEEK_CUR);
+    if(isroot(*config))
+      printfopenerr(filename);
+    free(buffer);
+    free(index);
+    return TRUE;
   }
-  else
-    fseek(file,0,SEEK_END); /* seek to end of file for append */
-  index=newvec(long long,config->ngridcell);
-  check(index);
-  /* write cell data and get index vector */
-  if(fwritecell(file,index,grid,config->ngridcell,ncft,npft,ischeckpoint,config)!=config->ngridcell)
+  /* write position vector and cell data of all tasks in parallel */
+  rc=writeat(fh,offset,(char *)index,sizeof(long long)*config->ngridcell);
+  if(!rc)
+    rc=writeat(fh,start,buffer,len);
+  /* wait until all data are completely written, MPI_File_sync() is collective */
+  if(MPI_File_sync(fh)!=MPI_SUCCESS)
+    rc=TRUE;
+  MPI_File_close(&fh);
+#else
+  file=fopen(filename,"r+b");
+  if(file==NULL)
   {
-    fprintf(stderr,"ERROR153: Cannot write data in restart file '%s': %s\n",
-            filename,strerror(errno));
+    printfopenerr(filename);
+    free(buffer);
     free(index);
-    fclose(file);
-#ifdef USE_MPI
-    iserror=TRUE;
-    if(config->rank<config->ntask-1)
-      MPI_Send(&iserror,1,MPI_INT,config->rank+1,MSGTAG,config->comm);
-#endif
     return TRUE;
   }
-  /* seek just after header + config->startgrid-config->firstgrid  */
-  fseek(file,headersize(RESTART_HEADER,RESTART_VERSION)+restartsize()+sizeof(long long)*(config->startgrid-config->firstgrid),SEEK_SET);
-  /* write position vector */
-  fwrite(index,sizeof(long long),config->ngridcell,file);
-#ifndef _WIN32
-  if(config->ntask>1)
-    /* wait until all data are completely written */
-    fsync(fileno(file));
-#endif
+  /* write position vector and cell data */
+  rc=fseek(file,offset,SEEK_SET) || fwrite(index,sizeof(long long),config->ngridcell,file)!=config->ngridcell ||
+     fseek(file,start,SEEK_SET) || fwrite(buffer,1,len,file)!=len;
   fclose(file);
-  free(index);
-#ifdef USE_MPI
-  iserror=FALSE;
-  if(config->rank<config->ntask-1)
-    /* send message to next task to write further data */
-    MPI_Send(&iserror,1,MPI_INT,config->rank+1,MSGTAG,config->comm);
 #endif
-  return FALSE;
+  if(rc)
+    fprintf(stderr,"ERROR153: Cannot write data in restart file '%s': %s\n",
+            filename,strerror(errno));
+  free(buffer);
+  free(index);
+  return iserror(rc,config);
 } /* of 'fwriterestart' */
@@ -4,7 +4,7 @@
 /**                                                                                \n**/
 /**     C implementation of LPJmL                                                  \n**/
 /**                                                                                \n**/
-/**     Function determines size of output for one year                            \n**/
+/**     Functions determine size of output for one year and number of cells        \n**/
 /**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
@@ -43,9 +43,21 @@ size_t getsize(int index,           /**< index of output file */
                    config->npft[GRASS]+config->npft[TREE],
                    config->npft[CROP],config);
   size*=typesizes[getoutputtype(config->outputvars[index].id,config->grid_type)];
-  if(config->outputvars[index].id==ADISCHARGE)
-    size*=config->nall;
-  else
-    size*=config->total;
+  size*=outputncell(index,config);
   return size;
 } /* of 'getsize' */
+
+int outputncell(int index,           /**< index of output file */
+                const Config *config /**< LPJ configuration */
+               )                     /** \return number of cells or regions in output */
+{
+  switch(config->outputvars[index].aggregate)
+  {
+    case COUNTRY_AGGREGATION:
+      return config->ncountries;
+    case MASK_AGGREGATION:
+      return config->nmask;
+    default:
+      return (config->outputvars[index].id==ADISCHARGE) ? config->nall : config->total;
+  }
+} /* of 'outputncell' */
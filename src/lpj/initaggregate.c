@@ -0,0 +1,65 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**             i  n  i  t  a  g  g  r  e  g  a  t  e  .  c                        \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function reads region mask for aggregated output and determines            \n**/
+/**     number of regions                                                          \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+Bool initaggregate(Cell grid[],   /**< LPJ grid */
+                   Config *config /**< LPJ configuration */
+                  )               /** \return TRUE on error */
+{
+  int cell,nmask;
+  Bool missing,rc;
+  Infile input;
+  for(cell=0;cell<config->ngridcell;cell++)
+    grid[cell].mask=-1;
+  config->nmask=0;
+  if(config->aggregate_mask_filename.name==NULL)
+    return FALSE;
+  rc=openinputdata(&input,&config->aggregate_mask_filename,"aggregate mask",NULL,LPJ_INT,1,config);
+  if(iserror(rc,config))
+    return TRUE;
+  nmask=0;
+  for(cell=0;cell<config->ngridcell;cell++)
+  {
+    if(readintinputdata(&input,&grid[cell].mask,&missing,&grid[cell].coord,cell+config->startgrid,&config->aggregate_mask_filename))
+    {
+      rc=TRUE;
+      break;
+    }
+    /* cells with missing or negative values are not included in any region */
+    if(missing || grid[cell].mask<0)
+      grid[cell].mask=-1;
+    else if(!grid[cell].skip && grid[cell].mask>=nmask)
+      nmask=grid[cell].mask+1;
+  }
+  closeinput(&input);
+  if(iserror(rc,config))
+    return TRUE;
+#ifdef USE_MPI
+  MPI_Allreduce(&nmask,&config->nmask,1,MPI_INT,MPI_MAX,config->comm);
+#else
+  config->nmask=nmask;
+#endif
+  if(config->nmask==0)
+  {
+    if(isroot(*config))
+      fprintf(stderr,"ERROR279: No region found in aggregation mask '%s'.\n",
+              config->aggregate_mask_filename.name);
+    return TRUE;
+  }
+  return FALSE;
+} /* of 'initaggregate' */
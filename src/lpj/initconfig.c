@@ -22,4 +22,9 @@ void initconfig(Config *config /**< LPJmL configuration */
   /* setup for sequential version */
   config->rank=0;
   config->ntask=1;
+#ifdef USE_OPENMP
+  config->nthreads=omp_get_max_threads();
+#else
+  config->nthreads=1;
+#endif
 } /* of 'initconfig' */
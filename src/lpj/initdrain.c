@@ -30,93 +30,222 @@
 
 #include "lpj.h"
 
-static int *getindex(const Input_netcdf input,const Cell grid[],
-                     const Config *config)
-{
-  int *item=NULL;
 #ifdef USE_MPI
-  int *vec;
-  int *counts;
-  int *offsets;
+
+static int *exchange(const int sendbuf[],    /**< data sorted by destination task */
+                     const int sendcounts[], /**< number of sent items per task */
+                     int recvcounts[],       /**< number of received items per task */
+                     int displs[],           /**< work array of size ntask */
+                     int recvdispls[],       /**< offsets of received items */
+                     MPI_Comm comm,          /**< MPI communicator */
+                     int ntask               /**< number of tasks */
+                    )                        /** \return received data or NULL */
+{
+  int *recvbuf;
+  int i,nrecv;
+  MPI_Alltoall((void *)sendcounts,1,MPI_INT,recvcounts,1,MPI_INT,comm);
+  displs[0]=recvdispls[0]=0;
+  for(i=1;i<ntask;i++)
+  {
+    displs[i]=displs[i-1]+sendcounts[i-1];
+    recvdispls[i]=recvdispls[i-1]+recvcounts[i-1];
+  }
+  nrecv=recvdispls[ntask-1]+recvcounts[ntask-1];
+  recvbuf=newvec(int,max(nrecv,1));
+  if(recvbuf!=NULL)
+    MPI_Alltoallv((void *)sendbuf,(int *)sendcounts,displs,MPI_INT,
+                  recvbuf,recvcounts,recvdispls,MPI_INT,comm);
+  return recvbuf;
+} /* of 'exchange' */
+
 #endif
-  int i,cell,n;
-  int *index;
+
+static Bool getindex(int item[],               /**< NetCDF indices of cells, replaced by cell indices or -1 */
+                     int nitem,                /**< number of indices */
+                     const Input_netcdf input, /**< NetCDF input file */
+                     const Cell grid[],        /**< cell grid */
+                     const char *filename,     /**< filename of input file */
+                     const Config *config      /**< LPJ configuration */
+                    )                          /** \return TRUE on error */
+{
+  /*
+   * The table mapping NetCDF indices to cell indices is distributed in
+   * blocks over all tasks. Each task sends the NetCDF indices of its own
+   * cells to the owners of the table blocks and queries only the indices
+   * of its neighbour cells. No vector of the size of the NetCDF grid is
+   * allocated on a single task.
+   */
+  int *table;
+  int i,cell,n,blocksize;
+  size_t key;
   Bool iserr;
+#ifdef USE_MPI
+  int *sendbuf,*recvbuf,*reply;
+  int *sendcounts,*recvcounts,*displs,*recvdispls,*pos;
+  int owner,nrecv;
+#endif
+  n=getindexsize_netcdf(input);
   iserr=FALSE;
-  if(isroot(*config))
+  for(cell=0;cell<config->ngridcell;cell++)
   {
-    item=newvec(int,config->nall);
-    if(item==NULL)
+    key=getindexinput_netcdf(input,&grid[cell].coord);
+    if(key>=n)
+    {
+      fprintf(stderr,"ERROR202: Invalid index %zu at cell %d in '%s'.\n",
+              key,cell+config->startgrid,filename);
       iserr=TRUE;
+      break;
+    }
   }
 #ifdef USE_MPI
-  counts=newvec(int,config->ntask);
-  if(counts==NULL)
-    iserr=TRUE;
-  offsets=newvec(int,config->ntask);
-  if(offsets==NULL)
-    iserr=TRUE;
-  vec=newvec(int,config->ngridcell);
-  if(vec==NULL)
+  blocksize=max((n+config->ntask-1)/config->ntask,1);
+  table=newvec(int,max(blocksize,1));
+  sendcounts=newvec(int,config->ntask);
+  recvcounts=newvec(int,config->ntask);
+  displs=newvec(int,config->ntask);
+  recvdispls=newvec(int,config->ntask);
+  pos=newvec(int,max(max(config->ngridcell,nitem),1));
+  sendbuf=newvec(int,max(2*max(config->ngridcell,nitem),1));
+  if(table==NULL || sendcounts==NULL || recvcounts==NULL || displs==NULL ||
+     recvdispls==NULL || pos==NULL || sendbuf==NULL)
+  {
+    printallocerr("table");
     iserr=TRUE;
+  }
   if(iserror(iserr,config))
   {
-    if(isroot(*config))
-      free(item);
-    free(vec);
-    free(counts);
-    free(offsets);
-    return NULL;
+    free(table);
+    free(sendcounts);
+    free(recvcounts);
+    free(displs);
+    free(recvdispls);
+    free(pos);
+    free(sendbuf);
+    return TRUE;
   }
-  getcounts(counts,offsets,config->nall,1,config->ntask);
+  for(i=0;i<blocksize;i++)
+    table[i]=-1;
+  /* send pairs of NetCDF index and cell index to owners of table blocks */
+  for(i=0;i<config->ntask;i++)
+    sendcounts[i]=0;
   for(cell=0;cell<config->ngridcell;cell++)
-    vec[cell]=(int)getindexinput_netcdf(input,&grid[cell].coord);
-  MPI_Gatherv(vec,config->ngridcell,MPI_INT,
-              item,counts,offsets,MPI_INT,
-              0,config->comm);
-  free(vec);
-  free(counts);
-  free(offsets);
-#else
-  if(iserr)
-    return NULL;
+    sendcounts[getindexinput_netcdf(input,&grid[cell].coord)/blocksize]+=2;
+  displs[0]=0;
+  for(i=1;i<config->ntask;i++)
+    displs[i]=displs[i-1]+sendcounts[i-1];
   for(cell=0;cell<config->ngridcell;cell++)
-    item[cell]=(int)getindexinput_netcdf(input,&grid[cell].coord);
-#endif
-  n=getindexsize_netcdf(input);
-  index=newvec(int,n);
-  if(index==NULL)
   {
-    printallocerr("index");
+    key=getindexinput_netcdf(input,&grid[cell].coord);
+    owner=key/blocksize;
+    sendbuf[displs[owner]]=key;
+    sendbuf[displs[owner]+1]=cell+config->startgrid-config->firstgrid;
+    displs[owner]+=2;
+  }
+  recvbuf=exchange(sendbuf,sendcounts,recvcounts,displs,recvdispls,
+                   config->comm,config->ntask);
+  if(recvbuf==NULL)
+  {
+    printallocerr("recvbuf");
     iserr=TRUE;
   }
-  else if(isroot(*config))
+  else
   {
-    for(i=0;i<n;i++)
-      index[i]=-1;
-    for(cell=0;cell<config->nall;cell++)
-    {
-      if(item[cell]>=n)
-      {
-        fprintf(stderr,"ERROR202: Invalid index %d at cell %d in '%s'.\n",
-                item[cell],cell+config->startgrid,
-                config->neighb_irrig_filename.name);
-        iserr=TRUE;
-        break;
-      }
-      index[item[cell]]=cell;
-    } 
-    free(item);
+    nrecv=recvdispls[config->ntask-1]+recvcounts[config->ntask-1];
+    for(i=0;i<nrecv;i+=2)
+      table[recvbuf[i]-config->rank*blocksize]=recvbuf[i+1];
+    free(recvbuf);
   }
   if(iserror(iserr,config))
   {
-    free(index);
-    return NULL;
+    free(table);
+    free(sendcounts);
+    free(recvcounts);
+    free(displs);
+    free(recvdispls);
+    free(pos);
+    free(sendbuf);
+    return TRUE;
   }
-#ifdef USE_MPI
-  MPI_Bcast(index,n,MPI_INT,0,config->comm);
+  /* send queried NetCDF indices to owners of table blocks */
+  for(i=0;i<config->ntask;i++)
+    sendcounts[i]=0;
+  for(i=0;i<nitem;i++)
+    sendcounts[item[i]/blocksize]++;
+  displs[0]=0;
+  for(i=1;i<config->ntask;i++)
+    displs[i]=displs[i-1]+sendcounts[i-1];
+  for(i=0;i<nitem;i++)
+  {
+    owner=item[i]/blocksize;
+    pos[i]=displs[owner]++;
+    sendbuf[pos[i]]=item[i];
+  }
+  recvbuf=exchange(sendbuf,sendcounts,recvcounts,displs,recvdispls,
+                   config->comm,config->ntask);
+  if(recvbuf==NULL)
+  {
+    printallocerr("recvbuf");
+    iserr=TRUE;
+  }
+  else
+  {
+    /* replace queried indices by cell indices and send them back */
+    nrecv=recvdispls[config->ntask-1]+recvcounts[config->ntask-1];
+    for(i=0;i<nrecv;i++)
+      recvbuf[i]=table[recvbuf[i]-config->rank*blocksize];
+  }
+  free(table);
+  if(iserror(iserr,config))
+  {
+    free(recvbuf);
+    free(sendcounts);
+    free(recvcounts);
+    free(displs);
+    free(recvdispls);
+    free(pos);
+    free(sendbuf);
+    return TRUE;
+  }
+  reply=exchange(recvbuf,recvcounts,sendcounts,displs,recvdispls,
+                 config->comm,config->ntask);
+  free(recvbuf);
+  if(reply==NULL)
+  {
+    printallocerr("reply");
+    iserr=TRUE;
+  }
+  else
+  {
+    for(i=0;i<nitem;i++)
+      item[i]=reply[pos[i]];
+    free(reply);
+  }
+  free(sendcounts);
+  free(recvcounts);
+  free(displs);
+  free(recvdispls);
+  free(pos);
+  free(sendbuf);
+  return iserror(iserr,config);
+#else
+  if(iserr)
+    return TRUE;
+  blocksize=max(n,1);
+  table=newvec(int,max(blocksize,1));
+  if(table==NULL)
+  {
+    printallocerr("table");
+    return TRUE;
+  }
+  for(i=0;i<blocksize;i++)
+    table[i]=-1;
+  for(cell=0;cell<config->ngridcell;cell++)
+    table[getindexinput_netcdf(input,&grid[cell].coord)]=cell+config->startgrid-config->firstgrid;
+  for(i=0;i<nitem;i++)
+    item[i]=table[item[i]];
+  free(table);
+  return FALSE;
 #endif
-  return index;
 } /* of 'getindex' */
 
 static Bool initirrig(Cell grid[],    /**< Cell grid             */
@@ -125,26 +254,73 @@ static Bool initirrig(Cell grid[],    /**< Cell grid             */
 {
   Infile irrig_file;
   String line;
-  int cell,neighb_irrig,rc,*index=NULL,n=0;
+  int cell,rc,*neighb_irrig,n;
+  Bool iserr;
   /* open neighbour irrigation file */
   irrig_file.fmt=config->neighb_irrig_filename.fmt;
   if(openinputdata(&irrig_file,&config->neighb_irrig_filename,"irrigation",NULL,LPJ_INT,1.0,config))
     return TRUE;
+  neighb_irrig=newvec(int,max(config->ngridcell,1));
+  if(neighb_irrig==NULL)
+  {
+    printallocerr("neighb_irrig");
+    closeinput(&irrig_file);
+    return TRUE;
+  }
+  iserr=FALSE;
+  for(cell=0;cell<config->ngridcell;cell++)
+  {
+    /* read connection from file */
+    if(readintinputdata(&irrig_file,neighb_irrig+cell,NULL,&grid[cell].coord,cell+config->startgrid,&config->neighb_irrig_filename))
+    {
+      iserr=TRUE;
+      break;
+    }
+  }
+  if(!iserr && config->neighb_irrig_filename.fmt==CDF)
+  {
+    n=getindexsize_netcdf(irrig_file.cdf);
+    for(cell=0;cell<config->ngridcell;cell++)
+      if(neighb_irrig[cell]<0 ||  neighb_irrig[cell]>=n)
+      {
+        fprintf(stderr,"ERROR203: Invalid irrigation neighbour %d of cell %d (%s).\n",
+                neighb_irrig[cell],cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
+        iserr=TRUE;
+        break;
+      }
+  }
   if(config->neighb_irrig_filename.fmt==CDF)
   {
-    index=getindex(irrig_file.cdf,grid,config);
-    if(index==NULL)
+    /* getindex() is collective, errors of all tasks have to be checked before */
+    if(iserror(iserr,config) ||
+       getindex(neighb_irrig,config->ngridcell,irrig_file.cdf,grid,config->neighb_irrig_filename.name,config))
     {
+      free(neighb_irrig);
       closeinput(&irrig_file);
       return TRUE;
     }
-    n=getindexsize_netcdf(irrig_file.cdf);
+    for(cell=0;cell<config->ngridcell;cell++)
+      if(neighb_irrig[cell]==-1)
+      {
+        fprintf(stderr,"ERROR203: Invalid irrigation neighbour of cell %d (%s).\n",
+                cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
+        iserr=TRUE;
+        break;
+      }
+  }
+  closeinput(&irrig_file);
+  if(iserr)
+  {
+    free(neighb_irrig);
+    return TRUE;
   }
   /* initialize pnet structure for irrigation network */
 #ifdef USE_MPI
   config->irrig_neighbour=pnet_init(config->comm,
                                     (sizeof(Real)==sizeof(double)) ? MPI_DOUBLE : MPI_FLOAT,
-                                    config->nall);
+                                    config->nall,
+                                    config->startgrid-config->firstgrid,
+                                    config->startgrid-config->firstgrid+config->ngridcell-1);
 #else
   config->irrig_neighbour=pnet_init(sizeof(Real),config->nall);
 #endif
@@ -152,61 +328,80 @@ static Bool initirrig(Cell grid[],    /**< Cell grid             */
   {
     fputs("ERROR140: Cannot initialize irrigation network.\n",stderr);
     fflush(stderr);
-    free(index);
-    closeinput(&irrig_file);
+    free(neighb_irrig);
     return TRUE;
   }
   for(cell=0;cell<config->ngridcell;cell++)
   {
-    /* read connection from file */
-    if(readintinputdata(&irrig_file,&neighb_irrig,NULL,&grid[cell].coord,cell+config->startgrid,&config->neighb_irrig_filename))
-    {
-      free(index);
-      closeinput(&irrig_file);
-      return TRUE;
-    }
-    if(config->neighb_irrig_filename.fmt==CDF)
-    {
-      if(neighb_irrig<0 ||  neighb_irrig>=n)
-      {
-        fprintf(stderr,"ERROR203: Invalid irrigation neighbour %d of cell %d (%s).\n",
-                neighb_irrig,cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
-        closeinput(&irrig_file);
-        free(index);
-        return TRUE;
-      }
-      neighb_irrig=index[neighb_irrig];
-      if(neighb_irrig==-1)
-      {
-        fprintf(stderr,"ERROR203: Invalid irrigation neighbour %d of cell %d (%s).\n",
-                neighb_irrig,cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
-        closeinput(&irrig_file);
-        free(index);
-        return TRUE;
-      }
-    }
     /* add connection to network */
     rc=pnet_addconnect(config->irrig_neighbour,
                        cell+config->startgrid-config->firstgrid,
-                       neighb_irrig-config->firstgrid);
+                       neighb_irrig[cell]-config->firstgrid);
     if(rc)
     {
       fprintf(stderr,"ERROR142: Cannot add irrigation neighbour %d of cell %d: %s.\n",
-              neighb_irrig,
+              neighb_irrig[cell],
               cell+config->startgrid,
               pnet_strerror(rc));
       fflush(stderr);
-      closeinput(&irrig_file);
-      free(index);
+      free(neighb_irrig);
       return TRUE;
     }
   } /* of 'for(cell=...)' */
-  closeinput(&irrig_file);
-  free(index);
+  free(neighb_irrig);
   config->irrig_back=pnet_dup(config->irrig_neighbour); /* copy network */
   return (config->irrig_back==NULL);
 } /* of 'initirrig' */
 
+static Bool packriver(Cell grid[],Config *config)
+{
+  /*
+   * Transfer functions and delay queues of all cells are stored in
+   * contiguous arrays, transfer functions are padded with zeros to a multiple
+   * of QUEUE_BLOCK to allow vectorized convolution in drain()
+   */
+  Queue *queue;
+  Real *tfunct;
+  int cell,size,t,ncoeff;
+  size=0;
+  for(cell=0;cell<config->ngridcell;cell++)
+    size+=padqueuesize(queuesize(grid[cell].discharge.queue));
+  config->tfunct=newvec(Real,max(size,1));
+  if(config->tfunct==NULL)
+  {
+    printallocerr("tfunct");
+    return TRUE;
+  }
+  tfunct=config->tfunct;
+  for(cell=0;cell<config->ngridcell;cell++)
+  {
+    ncoeff=queuesize(grid[cell].discharge.queue);
+    for(t=0;t<ncoeff;t++)
+      tfunct[t]=grid[cell].discharge.tfunct[t];
+    for(t=ncoeff;t<padqueuesize(ncoeff);t++)
+      tfunct[t]=0;
+    free(grid[cell].discharge.tfunct);
+    grid[cell].discharge.tfunct=tfunct;
+    tfunct+=padqueuesize(ncoeff);
+  }
+  queue=newvec(Queue,max(config->ngridcell,1));
+  if(queue==NULL)
+  {
+    printallocerr("queue");
+    return TRUE;
+  }
+  for(cell=0;cell<config->ngridcell;cell++)
+    queue[cell]=grid[cell].discharge.queue;
+  config->queuedata=packqueues(queue,config->ngridcell);
+  free(queue);
+  if(config->queuedata==NULL)
+  {
+    printallocerr("queue");
+    return TRUE;
+  }
+  return FALSE;
+} /* of 'packriver' */
+
 static Bool initriver(Cell grid[],Config *config)
 {
   Infile drainage,river;
@@ -214,9 +409,9 @@ static Bool initriver(Cell grid[],Config *config)
   Routing r;
   Header header;
   String headername,line;
-  int *index=NULL,n=0,version,ncoeff;
+  int *index=NULL,*query,n,nquery,version,ncoeff,i;
   Real len;
-  Bool missing;
+  Bool missing,iserr;
   size_t offset;
   drainage.fmt=config->drainage_filename.fmt;
   if(config->drainage_filename.fmt==CDF)
@@ -231,13 +426,65 @@ static Bool initriver(Cell grid[],Config *config)
       closeinput_netcdf(drainage.cdf);
       return TRUE;
     }
-    index=getindex(drainage.cdf,grid,config);
-    if(index==NULL)
+    /* read NetCDF indices of downstream cells and convert them into cell indices */
+    index=newvec(int,max(config->ngridcell,1));
+    query=newvec(int,max(config->ngridcell,1));
+    iserr=FALSE;
+    nquery=0;
+    if(index==NULL || query==NULL)
+    {
+      printallocerr("index");
+      iserr=TRUE;
+    }
+    else
+    {
+      n=getindexsize_netcdf(drainage.cdf);
+      for(cell=0;cell<config->ngridcell;cell++)
+      {
+        if(readintinput_netcdf(drainage.cdf,index+cell,&grid[cell].coord,&missing) || missing)
+        {
+          fprintf(stderr,"ERROR203: Cannot read drainage of cell %d (%s).\n",
+                 cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
+          iserr=TRUE;
+          break;
+        }
+        if(index[cell]<-1 ||  index[cell]>=n)
+        {
+          fprintf(stderr,"ERROR203: Invalid drainage  %d of cell %d (%s).\n",
+                  index[cell],cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
+          iserr=TRUE;
+          break;
+        }
+        if(index[cell]>0)
+          query[nquery++]=index[cell];
+      }
+    }
+    /* getindex() is collective, errors of all tasks have to be checked before */
+    if(iserror(iserr,config) ||
+       getindex(query,nquery,drainage.cdf,grid,config->drainage_filename.name,config))
     {
       closeinput_netcdf(drainage.cdf);
+      closeinput_netcdf(river.cdf);
+      free(index);
+      free(query);
       return TRUE;
     }
-    n=getindexsize_netcdf(drainage.cdf);
+    for(cell=i=0;cell<config->ngridcell;cell++)
+      if(index[cell]>0)
+      {
+        if(query[i]==-1)
+        {
+          fprintf(stderr,"ERROR203: Invalid drainage %d of cell %d (%s).\n",
+                  index[cell],cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
+          closeinput_netcdf(drainage.cdf);
+          closeinput_netcdf(river.cdf);
+          free(index);
+          free(query);
+          return TRUE;
+        }
+        index[cell]=query[i++];
+      }
+    free(query);
   }
   else
   {
@@ -273,7 +520,9 @@ static Bool initriver(Cell grid[],Config *config)
 #ifdef USE_MPI
   config->route=pnet_init(config->comm,
                           (sizeof(Real)==sizeof(double)) ? MPI_DOUBLE : MPI_FLOAT,
-                          config->nall);
+                          config->nall,
+                          config->startgrid-config->firstgrid,
+                          config->startgrid-config->firstgrid+config->ngridcell-1);
 #else
   config->route=pnet_init(sizeof(Real),config->nall);
 #endif
@@ -289,37 +538,7 @@ static Bool initriver(Cell grid[],Config *config)
   {
     if(config->drainage_filename.fmt==CDF)
     {
-      if(readintinput_netcdf(drainage.cdf,&r.index,&grid[cell].coord,&missing) || missing)
-      {
-        fprintf(stderr,"ERROR203: Cannot read drainage of cell %d (%s).\n",
-               cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
-        closeinput_netcdf(drainage.cdf);
-        closeinput_netcdf(river.cdf);
-        free(index);
-        return TRUE;
-      }
-      if(r.index<-1 ||  r.index>=n)
-      {
-        fprintf(stderr,"ERROR203: Invalid drainage  %d of cell %d (%s).\n",
-                r.index,cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
-        closeinput_netcdf(drainage.cdf);
-        closeinput_netcdf(river.cdf);
-        free(index);
-        return TRUE;
-      }
-      if(r.index>0)
-      {
-        r.index=index[r.index];
-        if(r.index==-1)
-        {
-          fprintf(stderr,"ERROR203: Invalid drainage %d of cell %d (%s).\n",
-                  r.index,cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
-          closeinput_netcdf(drainage.cdf);
-          closeinput_netcdf(river.cdf);
-          free(index);
-          return TRUE;
-        }
-      }
+      r.index=index[cell];
       if(readinput_netcdf(drainage.cdf,&len,&grid[cell].coord))
       {
         closeinput_netcdf(drainage.cdf);
@@ -429,7 +648,7 @@ static Bool initriver(Cell grid[],Config *config)
     closeinput_netcdf(river.cdf);
     free(index);
   }
-  return FALSE;
+  return packriver(grid,config);
 } /* of 'initriver' */
 
 Bool initdrain(Cell grid[],    /**< Cell grid             */
@@ -447,7 +666,29 @@ Bool initdrain(Cell grid[],    /**< Cell grid             */
   if(iserror(initriver(grid,config),config))
     return TRUE;
   pnet_reverse(config->route);
+  config->routeorder=NULL;
+  config->route_sub=NULL;
+  if(config->ordered_routing)
+  {
+    /* network exchanging outflows of all sub-steps at once */
+    config->route_sub=pnet_dup(config->route);
+    if(config->route_sub==NULL)
+    {
+      fputs("ERROR143: Cannot initialize river network.\n",stderr);
+      return TRUE;
+    }
+#ifdef USE_MPI
+    MPI_Type_contiguous((int)(1.0/TSTEP),(sizeof(Real)==sizeof(double)) ? MPI_DOUBLE : MPI_FLOAT,
+                        &config->route_sub->type);
+    MPI_Type_commit(&config->route_sub->type);
+#else
+    config->route_sub->size=sizeof(Real)*(int)(1.0/TSTEP);
+#endif
+    pnet_setup(config->route_sub);
+  }
   pnet_setup(config->route);
+  if(config->ordered_routing && initrouteorder(grid,config))
+    return TRUE;
   return FALSE;
 } /* of 'initdrain' */
 
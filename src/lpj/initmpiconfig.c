@@ -25,6 +25,11 @@ void initmpiconfig(Config *config, /**< LPJ configuration */
   config->comm=comm;
   MPI_Comm_rank(comm,&config->rank); /* get my rank: 0..ntask-1 */
   MPI_Comm_size(comm,&config->ntask); /* get number of tasks */
+#ifdef USE_OPENMP
+  config->nthreads=omp_get_max_threads();
+#else
+  config->nthreads=1;
+#endif
 } /* of 'initmpiconfig' */
 
 #endif
@@ -58,6 +58,7 @@ Bool initoutput(Outputfile *outputfile, /**< Output data */
   /* calculate indices into output storage */
   for(i=FPC;i<NOUT;i++)
   {
+    config->outputused[i]=isopen(outputfile,i);
     if(isopen(outputfile,i))
     {
       config->outputmap[i]=index;
@@ -67,6 +68,8 @@ Bool initoutput(Outputfile *outputfile, /**< Output data */
       config->outputmap[i]=0; /* no output used, point to trash */
 
   }
+  config->outputused[PFT_GCGP_COUNT]=isopen(outputfile,PFT_GCGP);
+  config->outputused[NDAY_MONTH]=isopen(outputfile,CFT_SWC);
   if(isopen(outputfile,PFT_GCGP))
   {
     config->outputmap[PFT_GCGP_COUNT]=index;
@@ -0,0 +1,248 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                 i  n  i  t  r  o  u  t  e  o  r  d  e  r  .  c                 \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function calculates the order of cells for river routing from              \n**/
+/**     upstream to downstream. Cells are sorted into rounds separated by          \n**/
+/**     data exchange with other tasks and into groups of cells within a           \n**/
+/**     round which do not depend on each other.                                   \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+typedef struct
+{
+  int round,depth,cell;
+} Key;
+
+static int compare(const Key *a,const Key *b)
+{
+  if(a->round!=b->round)
+    return a->round-b->round;
+  if(a->depth!=b->depth)
+    return a->depth-b->depth;
+  return a->cell-b->cell;
+} /* of 'compare' */
+
+static int getlocal(const Pnet *route,int src)
+{
+  /* returns local cell index if input index src is from own task, otherwise -1 */
+  int self;
+  self=pnet_taskid(route);
+  if(src>=route->indisp[self] && src<route->indisp[self]+route->inlen[self])
+    return route->outindex[route->outdisp[self]+src-route->indisp[self]]-pnet_lo(route);
+  return -1;
+} /* of 'getlocal' */
+
+Bool initrouteorder(const Cell grid[], /**< LPJ grid */
+                    Config *config     /**< LPJ configuration */
+                   )                   /** \return TRUE on error */
+{
+  Routeorder *order;
+  Pnet *route;
+  Key *key;
+  Real *in,*out;
+  int *topo,*indeg,*round,*depth;
+  int n,insize,cell,down,head,tail,i,j,k,g,r,src,local,pass,nround;
+  Bool changed;
+  route=config->route;
+  n=config->ngridcell;
+  topo=newvec(int,n);
+  check(topo);
+  indeg=newvec(int,n);
+  check(indeg);
+  round=newvec(int,n);
+  check(round);
+  depth=newvec(int,n);
+  check(depth);
+  /* sort cells of task topologically by Kahn's algorithm */
+  for(cell=0;cell<n;cell++)
+    indeg[cell]=0;
+  for(cell=0;cell<n;cell++)
+  {
+    down=grid[cell].discharge.next-config->startgrid;
+    if(grid[cell].discharge.next>=0 && down>=0 && down<n)
+      indeg[down]++;
+  }
+  tail=0;
+  for(cell=0;cell<n;cell++)
+    if(indeg[cell]==0)
+      topo[tail++]=cell;
+  for(head=0;head<tail;head++)
+  {
+    down=grid[topo[head]].discharge.next-config->startgrid;
+    if(grid[topo[head]].discharge.next>=0 && down>=0 && down<n && --indeg[down]==0)
+      topo[tail++]=down;
+  }
+  if(iserror(tail<n,config))
+  {
+    if(tail<n)
+    {
+      /* cells with remaining inflow are on a cycle or downstream of it */
+      for(cell=0;indeg[cell]==0;cell++);
+      fprintf(stderr,"ERROR268: Drainage network contains cycle at cell %d.\n",
+              cell+config->startgrid);
+    }
+    free(indeg);
+    free(topo);
+    free(round);
+    free(depth);
+    return TRUE;
+  }
+  free(indeg);
+  /* calculate round of each cell, round is increased by inflow from other tasks */
+  in=(Real *)pnet_input(route);
+  out=(Real *)pnet_output(route);
+  insize=route->indisp[route->ntask-1]+route->inlen[route->ntask-1];
+  for(i=0;i<insize;i++)
+    in[i]=0;
+  for(cell=0;cell<n;cell++)
+    round[cell]=0;
+  pass=0;
+  do
+  {
+    changed=FALSE;
+    for(k=0;k<n;k++)
+    {
+      cell=topo[k];
+      r=0;
+      for(j=0;j<pnet_inlen(route,cell+pnet_lo(route));j++)
+      {
+        src=pnet_inindex(route,cell+pnet_lo(route),j);
+        local=getlocal(route,src);
+        r=max(r,(local==-1) ? (int)in[src]+1 : round[local]);
+      }
+      if(r!=round[cell])
+      {
+        round[cell]=r;
+        changed=TRUE;
+      }
+    }
+    for(i=0;i<pnet_outlen(route);i++)
+      out[i]=round[pnet_outindex(route,i)-pnet_lo(route)];
+    pnet_exchg(route);
+#ifdef USE_MPI
+    MPI_Allreduce(MPI_IN_PLACE,&changed,1,MPI_INT,MPI_LOR,config->comm);
+#endif
+  }while(changed && ++pass<=config->nall);
+  if(changed)
+  {
+    if(isroot(*config))
+      fputs("ERROR268: Drainage network contains cycle between tasks.\n",stderr);
+    free(topo);
+    free(round);
+    free(depth);
+    return TRUE;
+  }
+  nround=0;
+  for(cell=0;cell<n;cell++)
+    nround=max(nround,round[cell]+1);
+#ifdef USE_MPI
+  MPI_Allreduce(MPI_IN_PLACE,&nround,1,MPI_INT,MPI_MAX,config->comm);
+#endif
+  if(nround>(int)(1.0/TSTEP))
+  {
+    /* more data exchanges needed than for default routing */
+    if(isroot(*config))
+      fprintf(stderr,"WARNING046: Ordered river routing requires %d data exchanges per day, default routing used.\n",nround-1);
+    free(topo);
+    free(round);
+    free(depth);
+    return FALSE;
+  }
+  /* cells within a round are grouped by their distance from the first cell
+     of the round, cells in a group are independent from each other */
+  for(k=0;k<n;k++)
+  {
+    cell=topo[k];
+    depth[cell]=0;
+    for(j=0;j<pnet_inlen(route,cell+pnet_lo(route));j++)
+    {
+      local=getlocal(route,pnet_inindex(route,cell+pnet_lo(route),j));
+      if(local!=-1 && round[local]==round[cell])
+        depth[cell]=max(depth[cell],depth[local]+1);
+    }
+  }
+  free(topo);
+  key=newvec(Key,n);
+  check(key);
+  for(cell=0;cell<n;cell++)
+  {
+    key[cell].round=round[cell];
+    key[cell].depth=depth[cell];
+    key[cell].cell=cell;
+  }
+  free(round);
+  free(depth);
+  qsort(key,n,sizeof(Key),(int (*)(const void *,const void *))compare);
+  order=new(Routeorder);
+  check(order);
+  order->nround=nround;
+  order->order=newvec(int,n);
+  check(order->order);
+  order->start=newvec(int,n+1);
+  check(order->start);
+  order->roundstart=newvec(int,nround+1);
+  check(order->roundstart);
+  order->fout=newvec(Real,n*(int)(1.0/TSTEP));
+  check(order->fout);
+  g=0;
+  for(k=0;k<n;k++)
+  {
+    order->order[k]=key[k].cell;
+    if(k==0 || key[k].round!=key[k-1].round || key[k].depth!=key[k-1].depth)
+      order->start[g++]=k;
+  }
+  order->start[g]=n;
+  order->ngroup=g;
+  /* find first group of each round */
+  i=0;
+  for(r=0;r<=nround;r++)
+  {
+    while(i<order->ngroup && key[order->start[i]].round<r)
+      i++;
+    order->roundstart[r]=i;
+  }
+  free(key);
+  /* store sources of inflow, outflow of cells of own task is accessed directly */
+  order->instart=newvec(int,n+1);
+  check(order->instart);
+  order->instart[0]=0;
+  for(cell=0;cell<n;cell++)
+    order->instart[cell+1]=order->instart[cell]+pnet_inlen(route,cell+pnet_lo(route));
+  order->inindex=newvec(int,max(1,order->instart[n]));
+  check(order->inindex);
+  for(cell=0;cell<n;cell++)
+    for(j=0;j<pnet_inlen(route,cell+pnet_lo(route));j++)
+    {
+      src=pnet_inindex(route,cell+pnet_lo(route),j);
+      local=getlocal(route,src);
+      order->inindex[order->instart[cell]+j]=(local==-1) ? src : -local-1;
+    }
+  config->routeorder=order;
+  return FALSE;
+} /* of 'initrouteorder' */
+
+void freerouteorder(Routeorder *order /**< order of cells or NULL */
+                   )
+{
+  if(order!=NULL)
+  {
+    free(order->roundstart);
+    free(order->start);
+    free(order->order);
+    free(order->instart);
+    free(order->inindex);
+    free(order->fout);
+    free(order);
+  }
+} /* of 'freerouteorder' */
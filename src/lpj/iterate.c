@@ -43,6 +43,49 @@ static void handler(int UNUSED(num))
   ischeckpoint=TRUE; /* SIGTERM received, set global flag to TRUE */
 } /* of 'handler' */
 
+static int getclimateyear(int year,            /**< simulation year (AD) */
+                          int firstspinupyear, /**< first year of spinup climate (AD) */
+                          int firstyear,       /**< first year of climate data (AD) */
+                          Seed seed,           /**< random seed for shuffling */
+                          const Config *config /**< LPJ configuration */
+                         )                     /** \return year of climate data (AD) */
+{
+  int climate_year;
+  if(year<firstyear) /* are we in spinup phase? */
+  {
+    if(config->shuffle_spinup_climate)
+    {
+      if(isroot(*config))
+        climate_year=(int)(erand48(seed)*config->nspinyear);
+#ifdef USE_MPI
+      MPI_Bcast(&climate_year,1,MPI_INT,0,config->comm);
+#endif
+    }
+    else
+      climate_year=(year-config->firstyear+config->nspinup) % config->nspinyear;
+    return firstspinupyear+climate_year;
+  }
+  climate_year=year;
+#if defined IMAGE && defined COUPLED
+  if(year>=config->start_coupling)
+    return climate_year;
+#endif
+  if(config->fix_climate && year>config->fix_climate_year)
+  {
+    if(config->fix_climate_shuffle)
+    {
+      if(isroot(*config))
+        climate_year=config->fix_climate_interval[0]+(int)((config->fix_climate_interval[1]-config->fix_climate_interval[0]+1)*erand48(seed));
+#ifdef USE_MPI
+      MPI_Bcast(&climate_year,1,MPI_INT,0,config->comm);
+#endif
+    }
+    else
+      climate_year=config->fix_climate_interval[0]+(year-config->fix_climate_year) % (config->fix_climate_interval[1]-config->fix_climate_interval[0]+1);
+  }
+  return climate_year;
+} /* of 'getclimateyear' */
+
 int iterate(Outputfile *output, /**< Output file data */
             Cell grid[],        /**< cell grid array */
             Input input,        /**< input data: climate, land use, water use */
@@ -53,12 +96,16 @@ int iterate(Outputfile *output, /**< Output file data */
 {
   Real co2,cflux_total;
   Flux flux;
-  int year,landuse_year,startyear,firstspinupyear,spinup_year,climate_year,year_co2,depos_year;
+  int year,landuse_year,startyear,firstspinupyear,data_year,climate_year,year_co2,depos_year;
 #ifndef COUPLED
   int wateruse_year;
 #endif
   Bool rc;
-  Climatedata store,data_save;
+  Climatestore store;
+  Prefetch prefetch;
+  Seed seed_prefetch;
+  int nfrozen;
+  double frozen_years;
 
 
   firstspinupyear=(config->isfirstspinupyear) ?  config->firstspinupyear : input.climate->firstyear;
@@ -70,25 +117,37 @@ int iterate(Outputfile *output, /**< Output file data */
        to avoid reading repeatedly from disk */
     rc=storeclimate(&store,input.climate, grid,firstspinupyear,config->nspinyear,config);
     failonerror(config,rc,STORE_CLIMATE_ERR,"Storage of climate failed, re-run with \"store_climate\" : false setting");
-
-    data_save=input.climate->data;
   }
   if(config->initsoiltemp)
   {
     rc=initsoiltemp(input.climate,grid,config);
     failonerror(config,rc,INITSOILTEMP_ERR,"Initialization of soil temperature failed");
   }
+  rc=initscratch(npft,ncft,config);
+  failonerror(config,rc,ALLOC_MEMORY_ERR,"Cannot allocate scratch buffers");
+  rc=initprefetch(&prefetch,input.climate,config);
+  failonerror(config,rc,PREFETCH_CLIMATE_ERR,"Initialization of climate prefetch failed");
   ischeckpoint=FALSE;
 #ifndef _WIN32
   if(ischeckpointrestart(config))
     signal(SIGTERM,handler); /* enable checkpointing by setting signal handler */
 #endif
   startyear=(config->ischeckpoint) ? config->checkpointyear+1 : config->firstyear-config->nspinup;
+  if(istiming(config))
+    inittimers();
+  nfrozen=0;
+  frozen_years=0;
+  if(config->spinup_tolerance>0 && startyear<config->firstyear)
+  {
+    rc=initconvergence(grid,config);
+    failonerror(config,rc,ALLOC_MEMORY_ERR,"Cannot allocate stocks for spinup convergence");
+  }
   /* main loop over spinup + simulation years  */
   if(isroot(*config) && config->ischeckpoint)
     printf("Starting from checkpoint file '%s'.\n",config->checkpoint_restart_filename);
   for(year=startyear;year<=config->lastyear;year++)
   {
+    starttimer(TIMER_YEAR,config);
 #if defined IMAGE && defined COUPLED
     if(year>=config->start_coupling)
       co2=receive_image_co2(config);
@@ -100,33 +159,30 @@ int iterate(Outputfile *output, /**< Output file data */
       year_co2=year;
     if(getco2(input.climate,&co2,year_co2,config)) /* get atmospheric CO2 concentration */
       break;
+    if(prefetch.isrunning)
+    {
+      /* year of climate data was already determined in previous year */
+      data_year=prefetch.year;
+      memcpy(config->seed,seed_prefetch,sizeof(Seed));
+    }
+    else
+      data_year=getclimateyear(year,firstspinupyear,input.climate->firstyear,config->seed,config);
     climate_year=year;
+    starttimer(TIMER_CLIMATE,config);
     if(year<input.climate->firstyear) /* are we in spinup phase? */
     {
       /* yes, let climate data point to stored data */
-      if(config->shuffle_spinup_climate)
-      {
-        if(isroot(*config))
-          spinup_year=(int)(erand48(config->seed)*config->nspinyear);
-#ifdef USE_MPI
-        MPI_Bcast(&spinup_year,1,MPI_INT,0,config->comm);
-#endif
-      }
-      else
-        spinup_year=(year-config->firstyear+config->nspinup) % config->nspinyear;
       if(config->storeclimate)
-        moveclimate(input.climate,&store,spinup_year);
+        moveclimate(input.climate,&store,data_year-firstspinupyear);
+      else if(prefetch.isrunning)
+        waitprefetch(&prefetch);
       else
-        getclimate(input.climate,grid,firstspinupyear+spinup_year,config);
+        getclimate(input.climate,grid,data_year,config);
     }
     else
     {
       if(config->storeclimate && year==input.climate->firstyear && config->nspinup)
-      {
-        /* restore climate data pointers to initial data */
-        input.climate->data=data_save;
-        freeclimatedata(&store); /* free data not used anymore */
-      }
+        freeclimatestore(&store); /* free data not used anymore */
       /* read climate from files */
 #if defined IMAGE && defined COUPLED
       if(year>=config->start_coupling)
@@ -141,21 +197,11 @@ int iterate(Outputfile *output, /**< Output file data */
       else
 #endif
       {
-        if(config->fix_climate && year>config->fix_climate_year)
-        {
-          if(config->fix_climate_shuffle)
-          {
-            if(isroot(*config))
-              climate_year=config->fix_climate_interval[0]+(int)((config->fix_climate_interval[1]-config->fix_climate_interval[0]+1)*erand48(config->seed));
-#ifdef USE_MPI
-            MPI_Bcast(&climate_year,1,MPI_INT,0,config->comm);
-#endif
-          }
-          else
-            climate_year=config->fix_climate_interval[0]+(year-config->fix_climate_year) % (config->fix_climate_interval[1]-config->fix_climate_interval[0]+1);
-        }
-
-        rc=getclimate(input.climate,grid,climate_year,config);
+        climate_year=data_year;
+        if(prefetch.isrunning)
+          rc=waitprefetch(&prefetch);
+        else
+          rc=getclimate(input.climate,grid,climate_year,config);
         if(iserror(rc,config))
         {
           if(isroot(*config))
@@ -167,6 +213,7 @@ int iterate(Outputfile *output, /**< Output file data */
         }
       }
     }
+    stoptimer(TIMER_CLIMATE,config);
     if(config->fix_deposition)
     {
       if(config->fix_deposition_with_climate)
@@ -229,8 +276,12 @@ int iterate(Outputfile *output, /**< Output file data */
       }
       else
 #endif
-      /* read landuse pattern from file */
-      rc=getlanduse(input.landuse,grid,landuse_year,year,ncft,config);
+      {
+        /* read landuse pattern from file */
+        starttimer(TIMER_LANDUSE,config);
+        rc=getlanduse(input.landuse,grid,landuse_year,year,ncft,config);
+        stoptimer(TIMER_LANDUSE,config);
+      }
       if(iserror(rc,config))
       {
         if(isroot(*config))
@@ -314,12 +365,38 @@ int iterate(Outputfile *output, /**< Output file data */
         break; /* leave time loop */
       }
     }
+    if(prefetch.isenabled && year<config->lastyear &&
+       (year+1>=input.climate->firstyear || !config->storeclimate)
+#if defined IMAGE && defined COUPLED
+       && year+1<config->start_coupling
+#endif
+      )
+    {
+      /* read climate data of next year while current year is simulated,
+         year is drawn from copy of random seed to keep sequence of
+         random numbers unchanged */
+      memcpy(seed_prefetch,config->seed,sizeof(Seed));
+      prefetchclimate(&prefetch,grid,getclimateyear(year+1,firstspinupyear,input.climate->firstyear,seed_prefetch,config));
+    }
     /* perform iteration for one year */
     if(year>=config->outputyear)
       openoutput_yearly(output,year,config);
+    starttimer(TIMER_ITERATEYEAR,config);
     iterateyear(output,grid,input,co2,npft,ncft,year,config);
+    stoptimer(TIMER_ITERATEYEAR,config);
     if(year>=config->outputyear)
       closeoutput_yearly(output,config);
+    if(config->write_cellcost_filename!=NULL && year==startyear)
+    {
+      /* write cost of cells measured in first simulation year */
+      if(fwritecellcost(config->write_cellcost_filename,grid,year,config))
+      {
+        if(isroot(*config))
+          fprintf(stderr,"ERROR266: Cannot write cell cost file '%s'.\n",config->write_cellcost_filename);
+      }
+      else if(isroot(*config))
+        printf("Cell cost file '%s' written.\n",config->write_cellcost_filename);
+    }
     /* calculating total carbon and water fluxes collected from all tasks */
     cflux_total=flux_sum(&flux,grid,config);
     if(isroot(*config))
@@ -336,6 +413,15 @@ int iterate(Outputfile *output, /**< Output file data */
       check_balance(flux,year,config);
 #endif
     }
+    if(config->spinup_tolerance>0 && year<config->firstyear)
+    {
+      /* cells converged in spinup are frozen until end of spinup */
+      frozen_years+=nfrozen;
+      if(year<config->firstyear-1)
+        nfrozen=checkconvergence(grid,year,config);
+      else
+        freeconvergence(grid,frozen_years,config);
+    }
 #if defined IMAGE && defined COUPLED
     if(year>=config->start_coupling)
     {
@@ -354,7 +440,22 @@ int iterate(Outputfile *output, /**< Output file data */
     }
 #endif
     if(iswriterestart(config) && year==config->restartyear)
+    {
+      starttimer(TIMER_RESTART,config);
       fwriterestart(grid,npft,ncft,year,config->write_restart_filename,FALSE,config); /* write restart file */
+      stoptimer(TIMER_RESTART,config);
+    }
+    if(istiming(config))
+    {
+      stoptimer(TIMER_YEAR,config);
+      if(config->print_timing)
+      {
+        fprinttimers(stdout,year,config);
+        if(isroot(*config))
+          fflush(stdout);
+      }
+      sumtimers();
+    }
     if(year<config->lastyear && ischeckpointrestart(config))
     {
 #ifdef USE_MPI
@@ -365,6 +466,7 @@ int iterate(Outputfile *output, /**< Output file data */
         if(isroot(*config))
           printf("SIGTERM catched, checkpoint file '%s' written.\n",config->checkpoint_restart_filename);
         fwriterestart(grid,npft,ncft,year,config->checkpoint_restart_filename,TRUE,config); /* write checkpoint file */
+        freeprefetch(&prefetch);
         fcloseoutput(output,config);
 #ifdef USE_MPI
         MPI_Finalize();
@@ -373,12 +475,22 @@ int iterate(Outputfile *output, /**< Output file data */
       }
     }
   } /* of 'for(year=...)' */
-  if(config->storeclimate && config->nspinup && (config->lastyear<input.climate->firstyear || year<input.climate->firstyear))
+  freeprefetch(&prefetch);
+  freescratch();
+  if(config->timing_filename!=NULL)
   {
-    /* restore climate data pointers to initial data */
-    input.climate->data=data_save;
-    freeclimatedata(&store); /* free data not used anymore */
+    if(fwritetimers(config->timing_filename,year-startyear,config))
+    {
+      if(isroot(*config))
+        fprintf(stderr,"ERROR274: Cannot write timer file '%s'.\n",config->timing_filename);
+    }
+    else if(isroot(*config))
+      printf("Timer file '%s' written.\n",config->timing_filename);
   }
+  if(config->spinup_tolerance>0 && year<config->firstyear)
+    freeconvergence(grid,frozen_years,config);
+  if(config->storeclimate && config->nspinup && (config->lastyear<input.climate->firstyear || year<input.climate->firstyear))
+    freeclimatestore(&store); /* free data not used anymore */
   if(year>config->lastyear && config->ischeckpoint)
     unlink(config->checkpoint_restart_filename); /* delete checkpoint file */
 
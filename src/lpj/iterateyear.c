@@ -28,6 +28,10 @@
 /**             check_fluxes();                                                    \n**/
 /**           }                                                                    \n**/
 /**                                                                                \n**/
+/**     If compiled with -DUSE_OPENMP the loops over cells are distributed         \n**/
+/**     on the threads of each task. drain(), wateruse() and fwriteoutput()        \n**/
+/**     are called by the master thread only and act as barriers.                  \n**/
+/**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
 /** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
@@ -49,20 +53,26 @@ void iterateyear(Outputfile *output,  /**< Output file data */
                 )
 {
   Dailyclimate daily;
-  Bool intercrop;
+  Bool intercrop,isdailytemp;
   int month,dayofmonth,day;
   int cell, s;
   Stand *stand;
   Real popdens=0; /* population density (capita/km2) */
+  double tstart=0; /* start time for measuring cost of cell (sec) */
   Real norg_soil_agr,nmin_soil_agr,nveg_soil_agr;
   intercrop=getintercrop(input.landuse);
+  isdailytemp=(input.climate->file_temp.fmt==FMS) || isdaily(input.climate->file_temp);
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic) private(stand,s,norg_soil_agr,nmin_soil_agr,nveg_soil_agr)
+#endif
   for(cell=0;cell<config->ngridcell;cell++)
   {
     initoutputdata(&grid[cell].output,ANNUAL,year,config);
     grid[cell].balance.surface_storage=grid[cell].balance.adischarge=0;
     grid[cell].discharge.afin_ext=0;
-    if(!grid[cell].skip)
+    if(!grid[cell].skip && !grid[cell].isconverged)
     {
+      grid[cell].arunoff=0;
       init_annual(grid+cell,ncft,config);
       if(config->withlanduse)
       {
@@ -93,6 +103,9 @@ void iterateyear(Outputfile *output,  /**< Output file data */
   day=1;
   foreachmonth(month)
   {
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
     for(cell=0;cell<config->ngridcell;cell++)
     {
       grid[cell].discharge.mfin=grid[cell].discharge.mfout=grid[cell].ml.mdemand=0.0;
@@ -100,7 +113,7 @@ void iterateyear(Outputfile *output,  /**< Output file data */
       if(grid[cell].ml.dam)
         grid[cell].ml.resdata->mprec_res=0;
       initoutputdata(&((grid+cell)->output),MONTHLY,year,config);
-      if(!grid[cell].skip)
+      if(!grid[cell].skip && !grid[cell].isconverged)
       {
         initclimate_monthly(input.climate,&grid[cell].climbuf,cell,month,grid[cell].seed);
 
@@ -131,9 +144,17 @@ void iterateyear(Outputfile *output,  /**< Output file data */
     } /* of 'for(cell=...)' */
     foreachdayofmonth(dayofmonth,month)
     {
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic) firstprivate(popdens,tstart) private(daily)
+#endif
       for(cell=0;cell<config->ngridcell;cell++)
       {
-        if(!grid[cell].skip)
+        if(grid[cell].isconverged)
+        {
+          /* cell frozen in spinup, route mean runoff of last simulated year */
+          grid[cell].discharge.drunoff=grid[cell].arunoff/NDAYYEAR;
+        }
+        else if(!grid[cell].skip)
         {
           if(config->ispopulation)
             popdens=getpopdens(input.popdens,cell);
@@ -173,8 +194,13 @@ void iterateyear(Outputfile *output,  /**< Output file data */
           printf("day=%d cell=%d\n",day,cell);
           fflush(stdout);
 #endif
+          if(config->write_cellcost_filename!=NULL)
+            tstart=mrun();
           update_daily(grid+cell,co2,popdens,daily,day,npft,
                        ncft,year,month,intercrop,config);
+          grid[cell].arunoff+=grid[cell].discharge.drunoff;
+          if(config->write_cellcost_filename!=NULL)
+            grid[cell].cost+=mrun()-tstart;
         }
       }
 
@@ -187,39 +213,64 @@ void iterateyear(Outputfile *output,  /**< Output file data */
           if(getextflow(input.extflow,grid,day-1,year))
              fail(INVALID_EXTFLOW_ERR,FALSE,"Cannot read external flow data");
         }
+        starttimer(TIMER_DRAIN,config);
         drain(grid,month,config);
+        stoptimer(TIMER_DRAIN,config);
 
         if(config->withlanduse)
+        {
+          starttimer(TIMER_WATERUSE,config);
           wateruse(grid,npft,ncft,month,config);
+          stoptimer(TIMER_WATERUSE,config);
+        }
       }
 
       if(config->withdailyoutput && day<NDAYYEAR && year>=config->outputyear)
+      {
         /* postpone last timestep until after annual processes */
+        starttimer(TIMER_FWRITEOUTPUT,config);
         fwriteoutput(output,grid,year,day-1,DAILY,npft,ncft,config);
+        stoptimer(TIMER_FWRITEOUTPUT,config);
+      }
 
       day++;
     } /* of 'foreachdayofmonth */
     /* Calculate resdata->mdemand as sum of ddemand to reservoir, instead of the sum of evaporation deficits per cell*/
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
     for(cell=0;cell<config->ngridcell;cell++)
     {
-      if(!grid[cell].skip)
+      if(!grid[cell].skip && !grid[cell].isconverged)
         update_monthly(grid+cell,getmtemp(input.climate,&grid[cell].climbuf,
                        cell,month),getmprec(input.climate,&grid[cell].climbuf,
                        cell,month),month,config);
     } /* of 'for(cell=0;...)' */
 
     if(year>=config->outputyear && month<NMONTH-1)
+    {
       /* write out monthly output, postpone last timestep until after annual processes */
+      starttimer(TIMER_FWRITEOUTPUT,config);
       fwriteoutput(output,grid,year,month,MONTHLY,npft,ncft,config);
+      stoptimer(TIMER_FWRITEOUTPUT,config);
+    }
 
   } /* of 'foreachmonth */
 
+  starttimer(TIMER_UPDATE_ANNUAL,config);
+#ifdef USE_OPENMP
+#pragma omp parallel for schedule(dynamic) firstprivate(tstart) private(stand,s,norg_soil_agr,nmin_soil_agr,nveg_soil_agr)
+#endif
   for(cell=0;cell<config->ngridcell;cell++)
   {
-    if(!grid[cell].skip)
+    if(!grid[cell].skip && !grid[cell].isconverged)
     {
       grid[cell].landcover=(config->prescribe_landcover!=NO_LANDCOVER) ? getlandcover(input.landcover,cell) : NULL;
-      update_annual(grid+cell,npft,ncft,year,daily.isdailytemp,intercrop,config);
+      if(config->write_cellcost_filename!=NULL)
+        tstart=mrun();
+      update_annual(grid+cell,npft,ncft,year,isdailytemp,intercrop,config);
+      if(config->write_cellcost_filename!=NULL)
+        grid[cell].cost+=mrun()-tstart;
 #ifdef SAFE
       check_fluxes(grid+cell,year,cell,config);
 #endif
@@ -279,14 +330,17 @@ void iterateyear(Outputfile *output,  /**< Output file data */
         grid[cell].balance.surface_storage+=reservoir_surface_storage(grid[cell].ml.resdata);
     }
   } /* of for(cell=0,...) */
+  stoptimer(TIMER_UPDATE_ANNUAL,config);
 
   if(year>=config->outputyear)
   {
+    starttimer(TIMER_FWRITEOUTPUT,config);
     /* write last monthly/daily output timestep after annual processes */
     fwriteoutput(output,grid,year,NMONTH-1,MONTHLY,npft,ncft,config);
     if(config->withdailyoutput)
       fwriteoutput(output,grid,year,NDAYYEAR-1,DAILY,npft,ncft,config);
     /* write out annual output */
     fwriteoutput(output,grid,year,0,ANNUAL,npft,ncft,config);
+    stoptimer(TIMER_FWRITEOUTPUT,config);
   }
 } /* of 'iterateyear' */
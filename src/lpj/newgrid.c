@@ -51,12 +51,23 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
 #endif
   int code;
   FILE *file_restart;
+  char *buffer_restart;
   Infile countrycode;
+  Bool rc;
+#ifdef USE_MPI
+  MPI_Comm node;
+  FILE *file;
+#endif
 
   /* Open coordinate and soil file */
   celldata=opencelldata(config);
-  if(celldata==NULL)
+  /* files are checked on all tasks, because they are read collectively */
+  if(iserror(celldata==NULL,config))
+  {
+    if(celldata!=NULL)
+      closecelldata(celldata,config);
     return NULL;
+  }
 #if defined IMAGE && defined COUPLED
   if(config->sim_id==LPJML_IMAGE)
   {
@@ -68,7 +79,7 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
     }
   }
 #endif
-  if(seekcelldata(celldata,config->startgrid))
+  if(iserror(seekcelldata(celldata,config->startgrid),config))
   {
     closecelldata(celldata,config);
     return NULL;
@@ -79,47 +90,82 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
     if(config->countrycode_filename.fmt==CDF)
     {
       countrycode.cdf=openinput_netcdf(&config->countrycode_filename,NULL,0,config);
-      if(countrycode.cdf==NULL)
-      {
-        closecelldata(celldata,config);
-        return NULL;
-      }
+      rc=(countrycode.cdf==NULL);
     }
     else
     {
       /* Open countrycode file */
       countrycode.file=opencountrycode(&config->countrycode_filename,
                                        &countrycode.swap,&isregion,&countrycode.type,&offset,isroot(*config));
-      if(countrycode.file==NULL)
-      {
-        closecelldata(celldata,config);
-        return NULL;
-      }
-      if(seekcountrycode(countrycode.file,config->startgrid,(isregion) ? 2 : 1,countrycode.type,offset))
+      rc=(countrycode.file==NULL);
+      if(!rc && seekcountrycode(countrycode.file,config->startgrid,(isregion) ? 2 : 1,countrycode.type,offset))
       {
         /* seeking to position of first grid cell failed */
         fprintf(stderr,
                 "ERROR106: Cannot seek in countrycode file to position %d.\n",
                 config->startgrid);
-        closecelldata(celldata,config);
         fclose(countrycode.file);
-        return NULL;
+        rc=TRUE;
       }
     }
+    if(iserror(rc,config))
+    {
+      if(!rc)
+        closeinput(&countrycode);
+      closecelldata(celldata,config);
+      return NULL;
+    }
     if(config->grassharvest_filename.name!=NULL)
     {
       // SR, grass management options: here choosing the grass harvest regime on the managed grassland
-      if(openinputdata(&grassharvest_file,&config->grassharvest_filename,"grass harvest",NULL,LPJ_BYTE,1.0,config))
+      rc=openinputdata(&grassharvest_file,&config->grassharvest_filename,"grass harvest",NULL,LPJ_BYTE,1.0,config);
+      if(iserror(rc,config))
       {
+        if(!rc)
+          closeinput(&grassharvest_file);
         closecelldata(celldata,config);
-        if(config->countrypar!=NULL)
-        {
-          closeinput(&countrycode);
-        }
+        closeinput(&countrycode);
         return NULL;
       }
     }
   }
+#ifdef USE_MPI
+  if(config->ntask>1)
+  {
+    /* static cell data of all tasks on a node are read by one task */
+#if MPI_VERSION>=3
+    MPI_Comm_split_type(config->comm,MPI_COMM_TYPE_SHARED,0,MPI_INFO_NULL,&node);
+#else
+    MPI_Comm_dup(MPI_COMM_SELF,&node);
+#endif
+    rc=readslicecelldata(celldata,config,node);
+    if(!rc && config->countrypar!=NULL)
+    {
+      if(config->countrycode_filename.fmt!=CDF)
+      {
+        file=freadslice(countrycode.file,(size_t)config->ngridcell*typesizes[countrycode.type]*((isregion) ? 2 : 1),node);
+        if(file==NULL)
+          rc=TRUE;
+        else
+          countrycode.file=file;
+      }
+      if(!rc && config->grassharvest_filename.name!=NULL)
+        rc=readsliceinput(&grassharvest_file,config->ngridcell,node);
+    }
+    MPI_Comm_free(&node);
+    if(iserror(rc,config))
+    {
+      closecelldata(celldata,config);
+      if(config->countrypar!=NULL)
+      {
+        closeinput(&countrycode);
+        if(config->grassharvest_filename.name!=NULL)
+          closeinput(&grassharvest_file);
+      }
+      return NULL;
+    }
+  }
+#endif
 
 #if defined IMAGE
   if(config->aquifer_irrig)
@@ -187,7 +233,7 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
   }
   else
   {
-    file_restart=openrestart((config->ischeckpoint) ? config->checkpoint_restart_filename : config->restart_filename,config,npft+ncft,&swap_restart);
+    file_restart=openrestart((config->ischeckpoint) ? config->checkpoint_restart_filename : config->restart_filename,config,npft+ncft,&swap_restart,&buffer_restart);
     if(file_restart==NULL)
     {
       free(grid);
@@ -304,6 +350,10 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
     grid[i].ignition.nesterov_day=0;
     grid[i].landcover=NULL;
     grid[i].output.data=NULL;
+    grid[i].cost=0;
+    grid[i].isconverged=FALSE;
+    grid[i].arunoff=0;
+    grid[i].spinup_stocks=NULL;
 #ifdef COUPLING_WITH_FMS
     grid[i].laketemp=0;
 #endif
@@ -451,7 +501,10 @@ static Cell *newgrid2(Config *config,          /* Pointer to LPJ configuration *
     }
   } /* of for(i=0;...) */
   if(file_restart!=NULL)
+  {
     fclose(file_restart);
+    free(buffer_restart);
+  }
   closecelldata(celldata,config);
   if(config->grassharvest_filename.name!=NULL)
     closeinput(&grassharvest_file);
@@ -533,5 +586,7 @@ Cell *newgrid(Config *config,          /**< Pointer to LPJ configuration */
     if(readcottondays(grid,config))
      return NULL;
   }
+  if(initaggregate(grid,config))
+    return NULL;
   return grid;
 } /* of 'newgrid' */
@@ -7,6 +7,8 @@
 /**     Function opens LPJ configuration file                                      \n**/
 /**     Input is prepocessed by cpp or by program defined in the                   \n**/
 /**     LPJPREP environment variable                                               \n**/
+/**     In parallel mode file is only opened by the root task, NULL is             \n**/
+/**     returned for all other tasks                                               \n**/
 /**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
@@ -90,6 +92,53 @@ FILE *openconfig(Config *config,      /**< configuration struct */
   }
   else
     config->wait=DEFAULT_WAIT;
+  config->shm=NULL;
+  pos=getenv(LPJCOUPLERSHM);
+  if(pos!=NULL)
+  {
+    config->shm_size=strtol(pos,&endptr,10);
+    if(*endptr!='\0')
+    {
+      if(isroot(*config))
+        fprintf(stderr,"ERROR193: Invalid number '%s' for shared memory size in environment variable.\n",pos);
+      return NULL;
+    }
+    if(config->shm_size<0 || config->shm_size>=2048)
+    {
+      if(isroot(*config))
+        fprintf(stderr,"ERROR193: Invalid number %d for shared memory size in environment variable, must be in [0,2047].\n",config->shm_size);
+      return NULL;
+    }
+  }
+  else
+    config->shm_size=0;
+  pos=getenv(LPJCOUPLERBATCH);
+  if(pos!=NULL)
+  {
+    config->coupler_batch=strtol(pos,&endptr,10);
+    if(*endptr!='\0' || config->coupler_batch<0 || config->coupler_batch>1)
+    {
+      if(isroot(*config))
+        fprintf(stderr,"ERROR193: Invalid value '%s' for batched output in environment variable, must be 0 or 1.\n",pos);
+      return NULL;
+    }
+  }
+  else
+    config->coupler_batch=FALSE;
+  pos=getenv(LPJCOUPLERVERSION);
+  if(pos!=NULL)
+  {
+    config->coupler_version=strtol(pos,&endptr,10);
+    if(*endptr!='\0' || config->coupler_version<COUPLER_VERSION_MIN || config->coupler_version>COUPLER_VERSION)
+    {
+      if(isroot(*config))
+        fprintf(stderr,"ERROR193: Invalid value '%s' for coupler version in environment variable, must be in [%d,%d].\n",
+                pos,COUPLER_VERSION_MIN,COUPLER_VERSION);
+      return NULL;
+    }
+  }
+  else /* version 3 is kept as default for existing coupled models */
+    config->coupler_version=(config->shm_size || config->coupler_batch) ? COUPLER_VERSION_SHM : COUPLER_VERSION_MIN;
 
 #if defined IMAGE && defined COUPLED
   config->image_inport=DEFAULT_IMAGE_INPORT;
@@ -407,6 +456,20 @@ FILE *openconfig(Config *config,      /**< configuration struct */
     return NULL;
   }
   config->filename=(*argv)[i++];
+#ifdef USE_MPI
+  if(!isroot(*config))
+  {
+    /* configuration file is only preprocessed and parsed by root task */
+    if(!config->nopp)
+    {
+      *argv+=i;
+      *argc-=i;
+    }
+    free(options);
+    initscan(config->filename);
+    return NULL;
+  }
+#endif
   /* check whether config file exists */
   if(getfilesize(config->filename)==-1)
   {
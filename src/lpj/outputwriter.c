@@ -0,0 +1,185 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                   o  u  t  p  u  t  w  r  i  t  e  r  .  c                     \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Functions write binary output in a separate thread. Output data            \n**/
+/**     are put into a bounded queue and written by the writer thread while        \n**/
+/**     the simulation continues. If the queue is full, putwriter() waits          \n**/
+/**     until enough data have been written.                                       \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#ifdef USE_PTHREAD
+
+typedef struct item
+{
+  FILE *file;        /**< file pointer */
+  void *data;        /**< data to be written, freed after write */
+  size_t size;       /**< size of data (bytes) */
+  struct item *next; /**< pointer to next item in queue */
+} Item;
+
+struct writer
+{
+  pthread_t thread;        /**< writer thread */
+  pthread_mutex_t mutex;   /**< mutex protecting queue */
+  pthread_cond_t notempty; /**< signalled if item was added */
+  pthread_cond_t notfull;  /**< signalled if item was written */
+  Item *first,*last;       /**< first and last item in queue */
+  size_t size;             /**< total size of queued data (bytes) */
+  size_t maxsize;          /**< maximum size of queued data (bytes) */
+  Bool isbusy;             /**< writer thread is writing an item */
+  Bool isdone;             /**< writer thread has to terminate */
+};
+
+static void *writethread(void *arg)
+{
+  Writer *writer;
+  Item *item;
+  writer=arg;
+  pthread_mutex_lock(&writer->mutex);
+  for(;;)
+  {
+    while(writer->first==NULL && !writer->isdone)
+      pthread_cond_wait(&writer->notempty,&writer->mutex);
+    if(writer->first==NULL)
+      break; /* queue is empty and writer has to terminate */
+    item=writer->first;
+    writer->first=item->next;
+    if(writer->first==NULL)
+      writer->last=NULL;
+    writer->isbusy=TRUE;
+    pthread_mutex_unlock(&writer->mutex);
+    if(fwrite(item->data,1,item->size,item->file)!=item->size)
+      fprintf(stderr,"ERROR204: Cannot write output: %s.\n",strerror(errno));
+    free(item->data);
+    pthread_mutex_lock(&writer->mutex);
+    writer->size-=item->size;
+    writer->isbusy=FALSE;
+    free(item);
+    pthread_cond_broadcast(&writer->notfull);
+  }
+  pthread_mutex_unlock(&writer->mutex);
+  return NULL;
+} /* of 'writethread' */
+
+#endif
+
+Writer *initwriter(size_t maxsize /**< maximum size of queued data (bytes) */
+                  )               /** \return pointer to writer or NULL */
+{
+#ifdef USE_PTHREAD
+  Writer *writer;
+  writer=new(Writer);
+  if(writer==NULL)
+  {
+    printallocerr("writer");
+    return NULL;
+  }
+  writer->first=writer->last=NULL;
+  writer->size=0;
+  writer->maxsize=maxsize;
+  writer->isbusy=writer->isdone=FALSE;
+  pthread_mutex_init(&writer->mutex,NULL);
+  pthread_cond_init(&writer->notempty,NULL);
+  pthread_cond_init(&writer->notfull,NULL);
+  if(pthread_create(&writer->thread,NULL,writethread,writer))
+  {
+    fprintf(stderr,"ERROR204: Cannot create output writer thread: %s.\n",strerror(errno));
+    pthread_mutex_destroy(&writer->mutex);
+    pthread_cond_destroy(&writer->notempty);
+    pthread_cond_destroy(&writer->notfull);
+    free(writer);
+    return NULL;
+  }
+  return writer;
+#else
+  return NULL;
+#endif
+} /* of 'initwriter' */
+
+Bool putwriter(Writer *writer,  /**< pointer to writer */
+               FILE *file,      /**< file pointer */
+               const void *data,/**< data to be written */
+               size_t size      /**< size of data (bytes) */
+              )                 /** \return TRUE on error */
+{
+#ifdef USE_PTHREAD
+  Item *item;
+  item=new(Item);
+  if(item==NULL)
+  {
+    printallocerr("item");
+    return TRUE;
+  }
+  item->data=malloc(size);
+  if(item->data==NULL)
+  {
+    printallocerr("data");
+    free(item);
+    return TRUE;
+  }
+  memcpy(item->data,data,size);
+  item->file=file;
+  item->size=size;
+  item->next=NULL;
+  pthread_mutex_lock(&writer->mutex);
+  /* wait until enough data have been written */
+  while(writer->size>0 && writer->size+size>writer->maxsize)
+    pthread_cond_wait(&writer->notfull,&writer->mutex);
+  if(writer->last==NULL)
+    writer->first=item;
+  else
+    writer->last->next=item;
+  writer->last=item;
+  writer->size+=size;
+  pthread_cond_signal(&writer->notempty);
+  pthread_mutex_unlock(&writer->mutex);
+  return FALSE;
+#else
+  return fwrite(data,1,size,file)!=size;
+#endif
+} /* of 'putwriter' */
+
+void flushwriter(Writer *writer /**< pointer to writer or NULL */
+                )
+{
+  /* wait until all queued data have been written */
+#ifdef USE_PTHREAD
+  if(writer==NULL)
+    return;
+  pthread_mutex_lock(&writer->mutex);
+  while(writer->first!=NULL || writer->isbusy)
+    pthread_cond_wait(&writer->notfull,&writer->mutex);
+  pthread_mutex_unlock(&writer->mutex);
+#endif
+} /* of 'flushwriter' */
+
+void freewriter(Writer *writer /**< pointer to writer or NULL */
+               )
+{
+#ifdef USE_PTHREAD
+  if(writer==NULL)
+    return;
+  /* remaining data are written before writer thread terminates */
+  pthread_mutex_lock(&writer->mutex);
+  writer->isdone=TRUE;
+  pthread_cond_signal(&writer->notempty);
+  pthread_mutex_unlock(&writer->mutex);
+  pthread_join(writer->thread,NULL);
+  pthread_mutex_destroy(&writer->mutex);
+  pthread_cond_destroy(&writer->notempty);
+  pthread_cond_destroy(&writer->notfull);
+  free(writer);
+#endif
+} /* of 'freewriter' */
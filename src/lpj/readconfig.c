@@ -6,6 +6,8 @@
 /**                                                                                \n**/
 /**     Function reads LPJ configuration file                                      \n**/
 /**     Input is prepocessed by cpp                                                \n**/
+/**     In parallel mode only the root task reads the file, parsed                 \n**/
+/**     configuration is broadcast by bcastconfig()                                \n**/
 /**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
@@ -35,14 +37,21 @@ Bool readconfig(Config *config,        /**< LPJ configuration */
   config->arglist=catstrvec(*argv,*argc); /* store command line in arglist */
   config->coupled_model=NULL;
   file=openconfig(config,argc,argv,usage);
-  if(file==NULL)
-    return TRUE;
   verbosity=(isroot(*config)) ? config->scan_verbose : NO_ERR;
-  lpjfile=parse_json(file,verbosity);
-  if(config->nopp)
-    fclose(file);
+  if(file==NULL)
+    lpjfile=NULL;
   else
-    pclose(file);
+  {
+    lpjfile=parse_json(file,verbosity);
+    if(config->nopp)
+      fclose(file);
+    else
+      pclose(file);
+  }
+#ifdef USE_MPI
+  if(config->ntask>1)
+    lpjfile=bcastconfig(lpjfile,config);
+#endif
   if(lpjfile==NULL)
     return TRUE;
   s=fscanstring(lpjfile,NULL,"sim_name",verbosity);
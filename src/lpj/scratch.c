@@ -0,0 +1,81 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                   s  c  r  a  t  c  h  .  c                                    \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Functions for scratch buffers of stand daily functions                     \n**/
+/**                                                                                \n**/
+/**     Buffers are allocated once per thread and reused by the daily              \n**/
+/**     functions of all stand types to avoid allocation of temporary              \n**/
+/**     vectors for every stand and day                                            \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+static Scratch *scratch=NULL; /* scratch buffers, one for each thread */
+static int nscratch=0;        /* number of scratch buffers */
+
+Bool initscratch(int npft,            /**< number of natural PFTs */
+                 int ncft,            /**< number of crop PFTs */
+                 const Config *config /**< LPJ configuration */
+                )                     /** \return TRUE on error */
+{
+  int i;
+  scratch=newvec(Scratch,config->nthreads);
+  if(scratch==NULL)
+  {
+    printallocerr("scratch");
+    return TRUE;
+  }
+  nscratch=config->nthreads;
+  for(i=0;i<nscratch;i++)
+  {
+    /* number of PFTs in stand cannot exceed npft+ncft */
+    scratch[i].wet=newvec(Real,npft+ncft);
+    scratch[i].gp_pft=newvec(Real,npft+ncft);
+    scratch[i].fpc_inc=newvec(Real,npft+ncft);
+    scratch[i].fpc_type=newvec(Real,config->ntypes);
+    scratch[i].pvec=newvec(int,npft+ncft);
+    if(scratch[i].wet==NULL || scratch[i].gp_pft==NULL || scratch[i].fpc_inc==NULL ||
+       scratch[i].fpc_type==NULL || scratch[i].pvec==NULL)
+    {
+      printallocerr("scratch");
+      nscratch=i+1;
+      return TRUE;
+    }
+  }
+  return FALSE;
+} /* of 'initscratch' */
+
+Scratch *getscratch(void)
+{
+#ifdef USE_OPENMP
+  return scratch+omp_get_thread_num();
+#else
+  return scratch;
+#endif
+} /* of 'getscratch' */
+
+void freescratch(void)
+{
+  int i;
+  for(i=0;i<nscratch;i++)
+  {
+    free(scratch[i].wet);
+    free(scratch[i].gp_pft);
+    free(scratch[i].fpc_inc);
+    free(scratch[i].fpc_type);
+    free(scratch[i].pvec);
+  }
+  free(scratch);
+  scratch=NULL;
+  nscratch=0;
+} /* of 'freescratch' */
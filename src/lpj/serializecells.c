@@ -0,0 +1,69 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                 s  e  r  i  a  l  i  z  e  c  e  l  l  s  .  c                 \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function serializes cell data of the local task into one contiguous        \n**/
+/**     memory buffer using the same layout as in restart files. The buffer        \n**/
+/**     can be written to file with a single call or sent to other tasks.          \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+char *serializecells(size_t *size,       /**< size of buffer (bytes) */
+                     long long index[],  /**< index vector to be calculated */
+                     const Cell grid[],  /**< cell data array */
+                     int ncell,          /**< number of cells */
+                     int ncft,           /**< number of crop PFTs */
+                     int npft,           /**< number of PFTs */
+                     Bool ischeckpoint,  /**< checkpoint data are written */
+                     const Config *config /**< LPJmL configuration */
+                    )                    /** \return pointer to buffer or NULL on error */
+{
+  FILE *file;
+  char *buffer;
+  Bool rc;
+#ifdef _WIN32
+  /* no memory streams available, use temporary file instead */
+  file=tmpfile();
+  if(file==NULL)
+    return NULL;
+  rc=fwritecell(file,index,grid,ncell,ncft,npft,ischeckpoint,config)!=ncell;
+  *size=ftell(file);
+  buffer=(rc) ? NULL : malloc(*size);
+  if(buffer!=NULL)
+  {
+    rewind(file);
+    if(fread(buffer,1,*size,file)!=*size)
+    {
+      free(buffer);
+      buffer=NULL;
+    }
+  }
+  fclose(file);
+  return buffer;
+#else
+  buffer=NULL;
+  *size=0;
+  file=open_memstream(&buffer,size);
+  if(file==NULL)
+    return NULL;
+  rc=fwritecell(file,index,grid,ncell,ncft,npft,ischeckpoint,config)!=ncell;
+  /* buffer and size are updated by fclose() */
+  fclose(file);
+  if(rc)
+  {
+    free(buffer);
+    return NULL;
+  }
+  return buffer;
+#endif
+} /* of 'serializecells' */
@@ -0,0 +1,148 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**            s  p  i  n  u  p  c  o  n  v  e  r  g  e  n  c  e  .  c             \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Functions detect convergence of carbon and nitrogen stocks of cells        \n**/
+/**     during spinup. Stocks are stored for the last spinup_window years.         \n**/
+/**     Cells with a relative change of stocks less than spinup_tolerance          \n**/
+/**     over this window are frozen and not simulated until the end of             \n**/
+/**     spinup. Fluxes of the last simulated year are kept for flux_sum()          \n**/
+/**     and the mean daily runoff is routed by drain(). Cells with lakes or        \n**/
+/**     reservoirs are not frozen, because they take inflow from upstream.         \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+static Stocks cellstocks(const Cell *cell)
+{
+  Stocks tot={0,0},stocks;
+  const Stand *stand;
+  int s;
+  foreachstand(stand,s,cell->standlist)
+  {
+    stocks=standstocks(stand);
+    tot.carbon+=stocks.carbon*stand->frac;
+    tot.nitrogen+=stocks.nitrogen*stand->frac;
+  }
+  return tot;
+} /* of 'cellstocks' */
+
+static Bool isirrigated(const Cell *cell)
+{
+  const Stand *stand;
+  const Irrigation *data;
+  int s;
+  foreachstand(stand,s,cell->standlist)
+    if(stand->type->landusetype==AGRICULTURE ||
+       stand->type->landusetype==GRASSLAND ||
+       stand->type->landusetype==OTHERS ||
+       stand->type->landusetype==BIOMASS_GRASS ||
+       stand->type->landusetype==BIOMASS_TREE ||
+       stand->type->landusetype==AGRICULTURE_GRASS ||
+       stand->type->landusetype==AGRICULTURE_TREE ||
+       stand->type->landusetype==WOODPLANTATION)
+    {
+      data=stand->data;
+      if(data->irrigation)
+        return TRUE;
+    }
+  return FALSE;
+} /* of 'isirrigated' */
+
+static Bool isconverged(Real now,Real old,Real tolerance)
+{
+  return fabs(now-old)<=tolerance*fabs(now);
+} /* of 'isconverged' */
+
+Bool initconvergence(Cell grid[],          /**< LPJ grid */
+                     const Config *config  /**< LPJ configuration */
+                    )                      /** \return TRUE on error */
+{
+  int cell,i;
+  for(cell=0;cell<config->ngridcell;cell++)
+  {
+    grid[cell].isconverged=FALSE;
+    if(!grid[cell].skip)
+    {
+      grid[cell].spinup_stocks=newvec(Stocks,config->spinup_window);
+      if(grid[cell].spinup_stocks==NULL)
+      {
+        printallocerr("spinup_stocks");
+        return TRUE;
+      }
+      /* negative carbon marks year without stored stocks */
+      for(i=0;i<config->spinup_window;i++)
+        grid[cell].spinup_stocks[i].carbon=grid[cell].spinup_stocks[i].nitrogen=-1;
+    }
+  }
+  return FALSE;
+} /* of 'initconvergence' */
+
+int checkconvergence(Cell grid[],         /**< LPJ grid */
+                     int year,            /**< simulation year (AD) */
+                     const Config *config /**< LPJ configuration */
+                    )                     /** \return number of frozen cells of task */
+{
+  Stocks stocks,*old;
+  int cell,nfrozen,firstcheck;
+  /* stocks must not be changed by equilsom() and equilveg() within window */
+  firstcheck=config->firstyear-config->nspinup+config->spinup_window;
+  if(config->equilsoil)
+    firstcheck+=param.veg_equil_year+param.nequilsoil*param.equisoil_interval+param.equisoil_fadeout;
+  nfrozen=0;
+  for(cell=0;cell<config->ngridcell;cell++)
+  {
+    if(grid[cell].skip)
+      continue;
+    if(grid[cell].isconverged)
+    {
+      nfrozen++;
+      continue;
+    }
+    stocks=cellstocks(grid+cell);
+    old=grid[cell].spinup_stocks+(year-config->firstyear+config->nspinup) % config->spinup_window;
+    if(year>=firstcheck && old->carbon>=0 && !grid[cell].ml.dam && grid[cell].lakefrac==0 &&
+       grid[cell].discharge.wateruse==0 && !isirrigated(grid+cell) &&
+       isconverged(stocks.carbon,old->carbon,config->spinup_tolerance) &&
+       (!config->with_nitrogen || isconverged(stocks.nitrogen,old->nitrogen,config->spinup_tolerance)))
+    {
+      grid[cell].isconverged=TRUE;
+      nfrozen++;
+    }
+    *old=stocks;
+  }
+  return nfrozen;
+} /* of 'checkconvergence' */
+
+void freeconvergence(Cell grid[],         /**< LPJ grid */
+                     double frozen_years, /**< sum of years cells of task were frozen */
+                     const Config *config /**< LPJ configuration */
+                    )
+{
+  int cell,nfrozen;
+  nfrozen=0;
+  for(cell=0;cell<config->ngridcell;cell++)
+  {
+    if(grid[cell].isconverged)
+      nfrozen++;
+    grid[cell].isconverged=FALSE;
+    free(grid[cell].spinup_stocks);
+    grid[cell].spinup_stocks=NULL;
+  }
+#ifdef USE_MPI
+  MPI_Reduce((isroot(*config)) ? MPI_IN_PLACE : &nfrozen,&nfrozen,1,MPI_INT,MPI_SUM,0,config->comm);
+  MPI_Reduce((isroot(*config)) ? MPI_IN_PLACE : &frozen_years,&frozen_years,1,MPI_DOUBLE,MPI_SUM,0,config->comm);
+#endif
+  if(isroot(*config))
+    printf("%d of %d cells converged in spinup, %.1f%% of cell years not simulated.\n",
+           nfrozen,config->total,100*frozen_years/config->total/config->nspinup);
+} /* of 'freeconvergence' */
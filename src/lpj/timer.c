@@ -0,0 +1,213 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                      t  i  m  e  r  .  c                                       \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Functions print and write phase timers of the main time loop.              \n**/
+/**     Timers are reduced across all tasks, minimum, mean, maximum and            \n**/
+/**     imbalance (maximum/mean) are reported.                                     \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+double timer[NTIMER];
+double timer_total[NTIMER];
+double timer_start[NTIMER];
+
+static const char *landusenames[KILL]=
+{
+  "natural","setaside_rf","setaside_ir","agriculture","managedforest",
+  "grassland","others","biomass_tree","biomass_grass","agriculture_tree",
+  "agriculture_grass","woodplantation"
+};
+
+static int getparent(int t)
+{
+  if(t==TIMER_YEAR)
+    return -1;
+  if(t==TIMER_CLIMATE || t==TIMER_LANDUSE || t==TIMER_ITERATEYEAR || t==TIMER_RESTART)
+    return TIMER_YEAR;
+  return TIMER_ITERATEYEAR;
+} /* of 'getparent' */
+
+static void getname(char *name,int t)
+{
+  const char *s;
+  switch(t)
+  {
+    case TIMER_YEAR:
+      s="year";
+      break;
+    case TIMER_CLIMATE:
+      s="climate";
+      break;
+    case TIMER_LANDUSE:
+      s="landuse";
+      break;
+    case TIMER_ITERATEYEAR:
+      s="iterateyear";
+      break;
+    case TIMER_DRAIN:
+      s="drain";
+      break;
+    case TIMER_WATERUSE:
+      s="wateruse";
+      break;
+    case TIMER_UPDATE_ANNUAL:
+      s="update_annual";
+      break;
+    case TIMER_FWRITEOUTPUT:
+      s="fwriteoutput";
+      break;
+    case TIMER_RESTART:
+      s="restart";
+      break;
+    default:
+      snprintf(name,STRING_LEN,"daily_stand/%s",landusenames[t-TIMER_DAILY_STAND]);
+      return;
+  }
+  strcpy(name,s);
+} /* of 'getname' */
+
+static int gettimerpath(char *path,int t)
+{
+  /* get full name of timer including names of parent timers */
+  char name[STRING_LEN+1];
+  int depth;
+  if(getparent(t)==-1)
+  {
+    getname(path,t);
+    return 0;
+  }
+  depth=gettimerpath(path,getparent(t));
+  getname(name,t);
+  strcat(path,"/");
+  strcat(path,name);
+  return depth+1;
+} /* of 'gettimerpath' */
+
+static void reducetimers(double min[],double mean[],double max[],
+                         const double vec[],const Config *config)
+{
+  int t;
+#ifdef USE_MPI
+  MPI_Reduce((void *)vec,min,NTIMER,MPI_DOUBLE,MPI_MIN,0,config->comm);
+  MPI_Reduce((void *)vec,max,NTIMER,MPI_DOUBLE,MPI_MAX,0,config->comm);
+  MPI_Reduce((void *)vec,mean,NTIMER,MPI_DOUBLE,MPI_SUM,0,config->comm);
+#else
+  for(t=0;t<NTIMER;t++)
+    min[t]=max[t]=mean[t]=vec[t];
+#endif
+  if(isroot(*config))
+    for(t=0;t<NTIMER;t++)
+      mean[t]/=config->ntask;
+} /* of 'reducetimers' */
+
+void inittimers(void)
+{
+  int t;
+  for(t=0;t<NTIMER;t++)
+    timer[t]=timer_total[t]=0;
+} /* of 'inittimers' */
+
+void sumtimers(void)
+{
+  /* add timers of current year to total time */
+  int t;
+  for(t=0;t<NTIMER;t++)
+  {
+    timer_total[t]+=timer[t];
+    timer[t]=0;
+  }
+} /* of 'sumtimers' */
+
+void fprinttimers(FILE *file,          /**< pointer to text file */
+                  int year,            /**< simulation year (AD) */
+                  const Config *config /**< LPJmL configuration */
+                 )
+{
+  double min[NTIMER],mean[NTIMER],max[NTIMER];
+  char path[STRING_LEN+1],name[STRING_LEN+1];
+  int t,depth;
+  reducetimers(min,mean,max,timer,config);
+  if(isroot(*config))
+  {
+    snprintf(name,STRING_LEN,"Timer year %d",year);
+    fprintf(file,"%-40s %10s %10s %10s %9s\n",
+            name,"min (sec)","mean (sec)","max (sec)","imbalance");
+    for(t=0;t<NTIMER;t++)
+      if(max[t]>0)
+      {
+        depth=gettimerpath(path,t);
+        getname(name,t);
+        fprintf(file,"%*s%-*s %10.3f %10.3f %10.3f %9.2f\n",
+                2*depth,"",40-2*depth,name,min[t],mean[t],max[t],
+                (mean[t]>0) ? max[t]/mean[t] : 1);
+      }
+    if(config->nthreads>1)
+      fprintf(file,"Time of daily_stand summed over %d threads.\n",config->nthreads);
+  }
+} /* of 'fprinttimers' */
+
+Bool fwritetimers(const char *filename, /**< filename of JSON file */
+                  int nyear,            /**< number of simulated years */
+                  const Config *config  /**< LPJmL configuration */
+                 )                      /** \return TRUE on error */
+{
+  FILE *file;
+  double min[NTIMER],mean[NTIMER],max[NTIMER];
+  char path[STRING_LEN+1];
+  int t,depth;
+  Bool rc;
+  reducetimers(min,mean,max,timer_total,config);
+  rc=FALSE;
+  if(isroot(*config))
+  {
+    file=fopen(filename,"w");
+    if(file==NULL)
+    {
+      printfcreateerr(filename);
+      rc=TRUE;
+    }
+    else
+    {
+      fprintf(file,"{\n"
+              "  \"sim_name\" : \"%s\",\n"
+              "  \"ntask\" : %d,\n"
+              "  \"nthreads\" : %d,\n"
+              "  \"ncell\" : %d,\n"
+              "  \"nyear\" : %d,\n"
+              "  \"timers\" :\n"
+              "  [\n",
+              config->sim_name,config->ntask,config->nthreads,config->total,nyear);
+      for(t=0;t<NTIMER;t++)
+      {
+        depth=gettimerpath(path,t);
+        fprintf(file,"    { \"name\" : \"%s\", \"depth\" : %d, \"min\" : %g, \"mean\" : %g, "
+                "\"max\" : %g, \"imbalance\" : %g }%s\n",
+                path,depth,min[t],mean[t],max[t],(mean[t]>0) ? max[t]/mean[t] : 1,
+                (t<NTIMER-1) ? "," : "");
+      }
+      fputs("  ]\n}\n",file);
+      if(ferror(file))
+      {
+        fprintf(stderr,"ERROR273: Cannot write timer file '%s': %s.\n",
+                filename,strerror(errno));
+        rc=TRUE;
+      }
+      fclose(file);
+    }
+  }
+#ifdef USE_MPI
+  MPI_Bcast(&rc,1,MPI_INT,0,config->comm);
+#endif
+  return rc;
+} /* of 'fwritetimers' */
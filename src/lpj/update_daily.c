@@ -59,7 +59,11 @@ void update_daily(Cell *cell,            /**< cell pointer           */
   Real agrfrac;
   Real litsum_old_nv[2]={0,0},litsum_new_nv[2]={0,0};
   Real litsum_old_agr[2]={0,0},litsum_new_agr[2]={0,0};
+  /* litter sums are only needed for decay outputs */
+  const Bool isdecay_nv=isoutput(DECAY_LEAF_NV,config) || isoutput(DECAY_WOOD_NV,config);
+  const Bool isdecay_agr=isoutput(DECAY_LEAF_AGR,config) || isoutput(DECAY_WOOD_AGR,config);
   Irrigation *data;
+  double tstart=0; /* start time for measuring daily_stand() (sec) */
 
   updategdd(cell->gdd,config->pftpar,npft,climate.temp);
   cell->balance.aprec+=climate.prec;
@@ -137,22 +141,23 @@ void update_daily(Cell *cell,            /**< cell pointer           */
     getoutput(&cell->output,SOILTEMP4,config)+=stand->soil.temp[3]*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
     getoutput(&cell->output,SOILTEMP5,config)+=stand->soil.temp[4]*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
     getoutput(&cell->output,SOILTEMP6,config)+=stand->soil.temp[5]*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
-    foreachsoillayer(l)
-      getoutputindex(&cell->output,SOILTEMP,l,config)+=stand->soil.temp[l]*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
+    if(isoutput(SOILTEMP,config))
+      foreachsoillayer(l)
+        getoutputindex(&cell->output,SOILTEMP,l,config)+=stand->soil.temp[l]*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
     getoutput(&cell->output,TWS,config)+=stand->soil.litter.agtop_moist*stand->frac;
     /* update soil and litter properties to account for all changes since last call of littersom */
     if(config->soilpar_option==NO_FIXED_SOILPAR || (config->soilpar_option==FIXED_SOILPAR && year<config->soilpar_fixyear))
       pedotransfer(stand,NULL,NULL,stand->frac);
     updatelitterproperties(stand,stand->frac);
 
-    if(stand->type->landusetype==NATURAL)
+    if(isdecay_nv && stand->type->landusetype==NATURAL)
       for(l=0;l<stand->soil.litter.n;l++)
       {
         litsum_old_nv[LEAF]+=stand->soil.litter.item[l].agtop.leaf.carbon+stand->soil.litter.item[l].agsub.leaf.carbon+stand->soil.litter.item[l].bg.carbon;
         for(i=0;i<NFUELCLASS;i++)
           litsum_old_nv[WOOD]+=stand->soil.litter.item[l].agtop.wood[i].carbon+stand->soil.litter.item[l].agsub.wood[i].carbon;
       }
-    if(isagriculture(stand->type->landusetype))
+    if(isdecay_agr && isagriculture(stand->type->landusetype))
       for(l=0;l<stand->soil.litter.n;l++)
       {
         litsum_old_agr[LEAF]+=stand->soil.litter.item[l].agtop.leaf.carbon+stand->soil.litter.item[l].agsub.leaf.carbon+stand->soil.litter.item[l].bg.carbon;
@@ -166,14 +171,14 @@ void update_daily(Cell *cell,            /**< cell pointer           */
     getoutput(&cell->output,N2O_NIT,config)+=hetres.nitrogen*stand->frac;
     cell->balance.n_outflux+=hetres.nitrogen*stand->frac;
 
-    if(stand->type->landusetype==NATURAL)
+    if(isdecay_nv && stand->type->landusetype==NATURAL)
       for(l=0;l<stand->soil.litter.n;l++)
       {
         litsum_new_nv[LEAF]+=stand->soil.litter.item[l].agtop.leaf.carbon+stand->soil.litter.item[l].agsub.leaf.carbon+stand->soil.litter.item[l].bg.carbon;
         for(i=0;i<NFUELCLASS;i++)
           litsum_new_nv[WOOD]+=stand->soil.litter.item[l].agtop.wood[i].carbon+stand->soil.litter.item[l].agsub.wood[i].carbon;
       }
-    if(isagriculture(stand->type->landusetype))
+    if(isdecay_agr && isagriculture(stand->type->landusetype))
       for(l=0;l<stand->soil.litter.n;l++)
       {
         litsum_new_agr[LEAF]+=stand->soil.litter.item[l].agtop.leaf.carbon+stand->soil.litter.item[l].agsub.leaf.carbon+stand->soil.litter.item[l].bg.carbon;
@@ -289,9 +294,19 @@ void update_daily(Cell *cell,            /**< cell pointer           */
       cell->balance.influx.nitrogen+=bnf*stand->frac;
     }
 
+    if(istiming(config))
+      tstart=mrun();
     runoff=daily_stand(stand,co2,&climate,day,month,daylength,
                        gtemp_air,gtemp_soil[0],eeq,par,
                        melt,npft,ncft,year,intercrop,agrfrac,config);
+    if(istiming(config))
+    {
+      tstart=mrun()-tstart;
+#ifdef USE_OPENMP
+#pragma omp atomic
+#endif
+      timer[TIMER_DAILY_STAND+stand->type->landusetype]+=tstart;
+    }
     if(config->with_nitrogen)
     {
       denitrification(stand,npft,ncft,config);
@@ -312,8 +327,9 @@ void update_daily(Cell *cell,            /**< cell pointer           */
 
     cell->discharge.drunoff+=runoff*stand->frac;
     climate.prec=prec_save;
-    foreachpft(pft, p, &stand->pftlist)
-      getoutput(&cell->output,VEGC_AVG,config)+=vegc_sum(pft)*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
+    if(isoutput(VEGC_AVG,config))
+      foreachpft(pft, p, &stand->pftlist)
+        getoutput(&cell->output,VEGC_AVG,config)+=vegc_sum(pft)*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
     getoutput(&cell->output,SWC1,config)+=(stand->soil.w[0]*stand->soil.whcs[0]+stand->soil.w_fw[0]+stand->soil.wpwps[0]+
               stand->soil.ice_depth[0]+stand->soil.ice_fw[0])/stand->soil.wsats[0]*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
     getoutput(&cell->output,SWC2,config)+=(stand->soil.w[1]*stand->soil.whcs[1]+stand->soil.w_fw[1]+stand->soil.wpwps[1]+
@@ -324,15 +340,17 @@ void update_daily(Cell *cell,            /**< cell pointer           */
               stand->soil.ice_depth[3]+stand->soil.ice_fw[3])/stand->soil.wsats[3]*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
     getoutput(&cell->output,SWC5,config)+=(stand->soil.w[4]*stand->soil.whcs[4]+stand->soil.w_fw[4]+stand->soil.wpwps[4]+
               stand->soil.ice_depth[4]+stand->soil.ice_fw[4])/stand->soil.wsats[4]*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
-    foreachsoillayer(l)
-    {
-      getoutputindex(&cell->output,SWC,l,config)+=(stand->soil.w[l]*stand->soil.whcs[l]+stand->soil.w_fw[l]+stand->soil.wpwps[l]+
-                     stand->soil.ice_depth[l]+stand->soil.ice_fw[l])/stand->soil.wsats[l]*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
-      getoutput(&cell->output,TWS,config)+=(stand->soil.w[l]*stand->soil.whcs[l]+stand->soil.w_fw[l]+stand->soil.wpwps[l]+
-                     stand->soil.ice_depth[l]+stand->soil.ice_fw[l])*stand->frac;
-    }
-    forrootmoist(l)
-      getoutput(&cell->output,ROOTMOIST,config)+=stand->soil.w[l]*stand->soil.whcs[l]*stand->frac; /* absolute soil water content between wilting point and field capacity (mm) */
+    if(isoutput(SWC,config))
+      foreachsoillayer(l)
+        getoutputindex(&cell->output,SWC,l,config)+=(stand->soil.w[l]*stand->soil.whcs[l]+stand->soil.w_fw[l]+stand->soil.wpwps[l]+
+                       stand->soil.ice_depth[l]+stand->soil.ice_fw[l])/stand->soil.wsats[l]*stand->frac*(1.0/(1-cell->lakefrac-cell->ml.reservoirfrac));
+    if(isoutput(TWS,config))
+      foreachsoillayer(l)
+        getoutput(&cell->output,TWS,config)+=(stand->soil.w[l]*stand->soil.whcs[l]+stand->soil.w_fw[l]+stand->soil.wpwps[l]+
+                       stand->soil.ice_depth[l]+stand->soil.ice_fw[l])*stand->frac;
+    if(isoutput(ROOTMOIST,config))
+      forrootmoist(l)
+        getoutput(&cell->output,ROOTMOIST,config)+=stand->soil.w[l]*stand->soil.whcs[l]*stand->frac; /* absolute soil water content between wilting point and field capacity (mm) */
     if(stand->type->landusetype==GRASSLAND || stand->type->landusetype==OTHERS ||
        stand->type->landusetype==AGRICULTURE || stand->type->landusetype==AGRICULTURE_GRASS || stand->type->landusetype==AGRICULTURE_TREE ||
        stand->type->landusetype==BIOMASS_TREE || stand->type->landusetype==BIOMASS_GRASS || stand->type->landusetype==WOODPLANTATION)
@@ -345,11 +363,12 @@ void update_daily(Cell *cell,            /**< cell pointer           */
       }
     }
     /* only first 5 layers for SWC_VOL output */
-    forrootsoillayer(l)
-    {
-      getoutputindex(&cell->output,SWC_VOL,l,config)+=(stand->soil.w[l]*stand->soil.whcs[l]+stand->soil.w_fw[l]+stand->soil.wpwps[l]+
-                     stand->soil.ice_depth[l]+stand->soil.ice_fw[l])*stand->frac*cell->coord.area;
-    }
+    if(isoutput(SWC_VOL,config))
+      forrootsoillayer(l)
+      {
+        getoutputindex(&cell->output,SWC_VOL,l,config)+=(stand->soil.w[l]*stand->soil.whcs[l]+stand->soil.w_fw[l]+stand->soil.wpwps[l]+
+                       stand->soil.ice_depth[l]+stand->soil.ice_fw[l])*stand->frac*cell->coord.area;
+      }
   } /* of foreachstand */
 
   getoutput(&cell->output,CELLFRAC_AGR,config)+=agrfrac;
@@ -74,7 +74,8 @@ static Real co2,cflux_total;
 static Flux flux;
 static int year, landuse_year, wateruse_year;
 #ifdef STORECLIMATE
-static Climatedata store,data_save;
+static Climatestore store;
+static Climatedata data_save;
 #endif
 
 static double glon_min, glon_max, glat_min, glat_max;
@@ -539,6 +540,9 @@ void lpj_init_
 #endif
   if(config.initsoiltemp)
     initsoiltemp(input.climate,grid,&config);
+  /* scratch buffers used by the daily stand functions called in update_daily() */
+  rc=initscratch(npft,ncft,&config);
+  failonerror(&config,rc,ALLOC_MEMORY_ERR,"Cannot allocate scratch buffers");
 
 
   /* main loop over spinup + simulation years  */
@@ -1312,7 +1316,7 @@ void lpj_update_
         {
           /* restore climate data pointers to initial data */
           input.climate->data=data_save;
-          freeclimatedata(&store); /* free data not used anymore */
+          freeclimatestore(&store); /* free data not used anymore */
         }
 #endif
         /* read climate from files */
@@ -1869,7 +1873,7 @@ void lpj_update_
   {
     /* restore climate data pointers to initial data */
     input.climate->data=data_save;
-    freeclimatedata(&store); /* free data not used anymore */
+    freeclimatestore(&store); /* free data not used anymore */
   }
 #endif
   return /*year*/;
@@ -1886,6 +1890,7 @@ void lpj_end_() {
   if(isroot(config))
     puts((year>config.lastyear) ? "Simulation ended." : "Simulation stopped.");
   /* free memory */
+  freescratch();
   freeinput(input,&config);
   freegrid(grid,config.npft[GRASS]+config.npft[TREE],&config);
   if(isroot(config))
@@ -0,0 +1,683 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                   l  p  j  b  e  n  c  h  .  c                                 \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Program times the numerical hot spots of LPJmL on synthetic cells          \n**/
+/**     and writes calls, ns/call and throughput of each kernel as JSON.           \n**/
+/**     Parameters of soils and PFTs are taken from the configuration file,        \n**/
+/**     grid, climate, litter and river network are generated.                     \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <unistd.h>
+#include "lpj.h"
+#include "grass.h"
+#include "tree.h"
+#include "crop.h"
+#include "natural.h"
+
+#define NTYPES 3 /* number of plant functional types: grass, tree, annual_crop */
+#define DEFAULT_NCELL 1000 /* default number of synthetic cells */
+#define DEFAULT_NDAY 365   /* default number of simulated days */
+#define DEFAULT_FILENAME "lpjbench.json" /* default name of JSON result file */
+#define BASINSIZE 255      /* number of cells in synthetic river basin */
+#define RIVERLEN 50000     /* length of river in cell (m) */
+#define NBENCH 8           /* number of kernels */
+#define DEFAULT_BENCHPATH "." /* default directory of redirected output files */
+#define BENCH_PREFIX "lpjbench_" /* prefix of redirected output files */
+#define USAGE "Usage: %s [-h] [-v] [-ncell n] [-nday n] [-o file] [-benchpath dir]\n"\
+              "       [-outpath dir] [-inpath dir] [-restartpath dir]\n"\
+              "       [-nopp] [-pp cmd] [[-Dmacro[=value]] [-Idir] ...] filename\n"
+
+typedef struct
+{
+  const char *name;  /**< name of kernel */
+  const char *unit;  /**< unit of throughput */
+  long long ncall;   /**< number of calls */
+  double nitem;      /**< number of items processed */
+  double time;       /**< wall clock time (sec) */
+} Bench;
+
+static double sink=0; /* results of kernels are summed up to prevent elimination */
+
+static Real synthtemp(const Cell *cell,int day)
+{
+  /* seasonal cycle of air temperature depending on latitude (deg C) */
+  return 27-0.55*fabs(cell->coord.lat)
+         -0.2*cell->coord.lat*cos(2*M_PI*(day+10)/NDAYYEAR);
+} /* of 'synthtemp' */
+
+static Real synthprec(const Cell *cell,int day)
+{
+  /* precipitation events every few days (mm) */
+  Real prec;
+  prec=12*sin(2*M_PI*day*11/NDAYYEAR+cell->coord.lon)-4;
+  return (prec>0) ? prec : 0;
+} /* of 'synthprec' */
+
+static void setup_heatgrid(Real h[NHEATGRIDP])
+{
+  /* distances between gridpoints of heat conduction grid (m), see update_soil_thermal_state() */
+  int l,j;
+  Real nodes[NHEATGRIDP];
+  Real border=0;
+  for(l=0;l<NSOILLAYER;l++)
+  {
+    for(j=0;j<GPLHEAT;j++)
+      nodes[l*GPLHEAT+j]=border+soildepth[l]/1000/(GPLHEAT*2)+(soildepth[l]/1000/GPLHEAT)*j;
+    border+=soildepth[l]/1000;
+  }
+  for(l=0;l<NHEATGRIDP;l++)
+    h[l]=nodes[l]-(l>0 ? nodes[l-1] : 0);
+} /* of 'setup_heatgrid' */
+
+static void initsoilstate(Stand *stand,Real temp,const Config *config)
+{
+  /* set soil water, temperature, enthalpy and litter */
+  Soil_thermal_prop therm;
+  Soil *soil;
+  int l,i,p;
+  soil=&stand->soil;
+  foreachsoillayer(l)
+  {
+    soil->w[l]=0.6;
+    soil->temp[l]=temp;
+  }
+  forrootsoillayer(l)
+  {
+    soil->pool[l].slow.carbon=4000*soildepth[l]/layerbound[BOTTOMLAYER];
+    soil->pool[l].fast.carbon=400*soildepth[l]/layerbound[BOTTOMLAYER];
+    if(config->with_nitrogen)
+    {
+      soil->pool[l].slow.nitrogen=soil->pool[l].slow.carbon/soil->par->cn_ratio;
+      soil->pool[l].fast.nitrogen=soil->pool[l].fast.carbon/soil->par->cn_ratio;
+      soil->NH4[l]=soil->NO3[l]=soil->pool[l].slow.nitrogen/10;
+    }
+  }
+  for(p=0;p<soil->litter.n;p++)
+  {
+    soil->litter.item[p].agtop.leaf.carbon=60;
+    soil->litter.item[p].agtop.leaf.nitrogen=1;
+    for(i=0;i<NFUELCLASS;i++)
+    {
+      soil->litter.item[p].agtop.wood[i].carbon=40;
+      soil->litter.item[p].agtop.wood[i].nitrogen=0.2;
+    }
+    soil->litter.item[p].bg.carbon=80;
+    soil->litter.item[p].bg.nitrogen=1.5;
+  }
+  updatelitterproperties(stand,stand->frac);
+  /* enthalpy corresponding to temperature, see initsoiltemp() */
+  calc_soil_thermal_props(UNKNOWN,&therm,soil,NULL,NULL,config->johansen,FALSE);
+  foreachsoillayer(l)
+  {
+    for(i=0;i<GPLHEAT;i++)
+      soil->enth[GPLHEAT*l+i]=(temp<0) ? temp*therm.c_frozen[GPLHEAT*l+i] :
+                              temp*therm.c_unfrozen[GPLHEAT*l+i]+therm.latent_heat[GPLHEAT*l+i];
+    soil->wi_abs_enth_adj[l]=allwater(soil,l)+allice(soil,l);
+    soil->sol_abs_enth_adj[l]=soildepth[l]-soil->wsats[l];
+  }
+} /* of 'initsoilstate' */
+
+static Bool initbenchgrid(Cell grid[],int ncell,int npft,int ncft,Config *config)
+{
+  /* create cells with natural stand and established PFTs */
+  Stand *stand;
+  Pft *pft;
+  int i,p,s,n,*soil_id,nsoil;
+  int n_est[NTYPES];
+  soil_id=newvec(int,config->nsoil);
+  if(soil_id==NULL)
+  {
+    printallocerr("soil_id");
+    return TRUE;
+  }
+  /* only vegetated soil types are used */
+  nsoil=0;
+  for(s=0;s<config->nsoil;s++)
+    if(config->soilpar[s].type!=ROCK && config->soilpar[s].type!=ICE)
+      soil_id[nsoil++]=s;
+  if(nsoil==0)
+  {
+    fputs("ERROR271: No vegetated soil type found in configuration.\n",stderr);
+    free(soil_id);
+    return TRUE;
+  }
+  for(i=0;i<ncell;i++)
+  {
+    memset(grid+i,0,sizeof(Cell));
+    grid[i].coord.lat=-55+125.0*i/ncell;
+    grid[i].coord.lon=-180+fmod(i*config->resolution.lon,360);
+    grid[i].coord.area=cellarea(&grid[i].coord,&config->resolution);
+    setseed(grid[i].seed,config->seed_start+i*36363);
+    grid[i].standlist=newlist(0);
+    grid[i].gdd=newgdd(npft);
+    if(grid[i].standlist==NULL || grid[i].gdd==NULL)
+    {
+      printallocerr("grid");
+      free(soil_id);
+      return TRUE;
+    }
+    for(p=0;p<npft;p++)
+      grid[i].gdd[p]=0;
+    n=addstand(&natural_stand,grid+i);
+    stand=getstand(grid[i].standlist,n-1);
+    stand->frac=1;
+    for(p=0;p<FRACGLAYER;p++)
+      stand->frac_g[p]=1.0;
+    if(initsoil(stand,config->soilpar+soil_id[i%nsoil],npft+ncft,config))
+    {
+      free(soil_id);
+      return TRUE;
+    }
+    for(p=0;p<NTYPES;p++)
+      n_est[p]=0;
+    for(p=0;p<npft;p++)
+      if(config->pftpar[p].cultivation_type==NONE)
+      {
+        addpft(stand,config->pftpar+p,config->firstyear,0,config);
+        n_est[config->pftpar[p].type]++;
+      }
+    foreachpft(pft,p,&stand->pftlist)
+    {
+      establishment(pft,0,0,n_est[pft->par->type]);
+      pft->phen=1;
+    }
+    foreachpft(pft,p,&stand->pftlist)
+      if(pft->par->type==GRASS)
+        fpc_grass(pft);
+    initsoilstate(stand,synthtemp(grid+i,0),config);
+  }
+  free(soil_id);
+  return FALSE;
+} /* of 'initbenchgrid' */
+
+static Bool initbenchdrain(Cell grid[],int ncell,Config *config)
+{
+  /* write synthetic river network of binary trees into raw drainage file */
+  FILE *file;
+  Routing r;
+  int i,k,fd,withlanduse;
+  Bool rc;
+  char filename[]="/tmp/lpjbenchXXXXXX";
+  fd=mkstemp(filename);
+  if(fd==-1 || (file=fdopen(fd,"wb"))==NULL)
+  {
+    printfcreateerr(filename);
+    return TRUE;
+  }
+  for(i=0;i<ncell;i++)
+  {
+    k=i%BASINSIZE;
+    r.index=(k==0) ? -1 : i-k+(k-1)/2;
+    r.len=RIVERLEN;
+    fwrite(&r,sizeof(Routing),1,file);
+  }
+  fclose(file);
+  config->drainage_filename.fmt=RAW;
+  config->drainage_filename.name=filename;
+  /* irrigation neighbours are not needed for routing */
+  withlanduse=config->withlanduse;
+  config->withlanduse=NO_LANDUSE;
+  rc=initdrain(grid,config);
+  config->withlanduse=withlanduse;
+  config->drainage_filename.name=NULL;
+  unlink(filename);
+  return rc;
+} /* of 'initbenchdrain' */
+
+static void bench_heatconduction(Bench *bench,Cell grid[],int ncell,int nday,
+                                 const Config *config)
+{
+  Real h[NHEATGRIDP],*enth,temp;
+  Soil_thermal_prop *therm;
+  Uniform_temp_sign *sign;
+  Soil *soil;
+  int cell,day,l,nabove,nbelow;
+  double tstart;
+  setup_heatgrid(h);
+  enth=newvec(Real,(size_t)ncell*NHEATGRIDP);
+  check(enth);
+  therm=newvec(Soil_thermal_prop,ncell);
+  check(therm);
+  sign=newvec(Uniform_temp_sign,ncell);
+  check(sign);
+  for(cell=0;cell<ncell;cell++)
+  {
+    soil=&getstand(grid[cell].standlist,0)->soil;
+    for(l=0;l<NHEATGRIDP;l++)
+      enth[cell*NHEATGRIDP+l]=soil->enth[l];
+    nabove=nbelow=0;
+    foreachsoillayer(l)
+      if(soil->temp[l]>0)
+        nabove++;
+      else if(soil->temp[l]<0)
+        nbelow++;
+    sign[cell]=(nabove==NSOILLAYER) ? ALL_ABOVE_0 : ((nbelow==NSOILLAYER) ? ALL_BELOW_0 : MIXED_SIGN);
+    calc_soil_thermal_props(sign[cell],therm+cell,soil,NULL,NULL,config->johansen,TRUE);
+  }
+  tstart=mrun();
+  for(day=0;day<nday;day++)
+    for(cell=0;cell<ncell;cell++)
+    {
+      temp=synthtemp(grid+cell,day);
+      apply_heatconduction_of_a_day((sign[cell]==ALL_ABOVE_0 && temp<=0) || (sign[cell]==ALL_BELOW_0 && temp>=0) ? MIXED_SIGN : sign[cell],
+                                    enth+cell*NHEATGRIDP,h,temp,therm+cell);
+    }
+  bench->time=mrun()-tstart;
+  for(cell=0;cell<ncell;cell++)
+    sink+=enth[cell*NHEATGRIDP];
+  bench->name="apply_heatconduction_of_a_day";
+  bench->unit="cell days/s";
+  bench->ncall=(long long)ncell*nday;
+  bench->nitem=(double)ncell*nday;
+  free(enth);
+  free(therm);
+  free(sign);
+} /* of 'bench_heatconduction' */
+
+static void bench_soilthermal(Bench *bench,Cell grid[],int ncell,int nday,
+                              const Config *config)
+{
+  int cell,day;
+  double tstart;
+  tstart=mrun();
+  for(day=0;day<nday;day++)
+    for(cell=0;cell<ncell;cell++)
+      update_soil_thermal_state(&getstand(grid[cell].standlist,0)->soil,
+                                synthtemp(grid+cell,day),config);
+  bench->time=mrun()-tstart;
+  for(cell=0;cell<ncell;cell++)
+    sink+=getstand(grid[cell].standlist,0)->soil.temp[0];
+  bench->name="update_soil_thermal_state";
+  bench->unit="cell days/s";
+  bench->ncall=(long long)ncell*nday;
+  bench->nitem=(double)ncell*nday;
+} /* of 'bench_soilthermal' */
+
+static void bench_photosynthesis(Bench *bench,Cell grid[],int ncell,int nday)
+{
+  Real agd,rd,vm,temp,daylength,par,eeq,swdown;
+  int cell,day,path;
+  double tstart;
+  tstart=mrun();
+  for(day=0;day<nday;day++)
+    for(cell=0;cell<ncell;cell++)
+      for(path=C3;path<=C4;path++)
+      {
+        temp=synthtemp(grid+cell,day);
+        petpar(&daylength,&par,&eeq,&swdown,grid[cell].coord.lat,day+1,temp,50,0.17);
+        sink+=photosynthesis(&agd,&rd,&vm,path,0.7,1,0.015,ppm2Pa(380),temp,
+                             par*0.5,daylength,TRUE);
+      }
+  bench->time=mrun()-tstart;
+  bench->name="photosynthesis";
+  bench->unit="calls/s";
+  bench->ncall=(long long)ncell*nday*2;
+  bench->nitem=(double)bench->ncall;
+} /* of 'bench_photosynthesis' */
+
+static void bench_waterstressed(Bench *bench,Cell grid[],int ncell,int nday,
+                                int npft,int ncft,const Config *config)
+{
+  Stand *stand;
+  Pft *pft;
+  Real *gp_pft,aet_stand[LASTLAYER];
+  Real gp_stand,gp_stand_leafon,fpc_total,gc_pft,rd,wet,wdf,temp,daylength,par,eeq,swdown;
+  int cell,day,p,l;
+  double time;
+  long long ncall;
+  gp_pft=newvec(Real,npft+ncft);
+  check(gp_pft);
+  time=0;
+  ncall=0;
+  for(day=0;day<nday;day++)
+    for(cell=0;cell<ncell;cell++)
+    {
+      stand=getstand(grid[cell].standlist,0);
+      temp=synthtemp(grid+cell,day);
+      petpar(&daylength,&par,&eeq,&swdown,grid[cell].coord.lat,day+1,temp,50,0.17);
+      gp_stand=gp_sum(&stand->pftlist,380,temp,par,daylength,
+                      &gp_stand_leafon,gp_pft,&fpc_total,config);
+      for(l=0;l<LASTLAYER;l++)
+        aet_stand[l]=0;
+      /* only calls of water_stressed() are timed */
+      time-=mrun();
+      foreachpft(pft,p,&stand->pftlist)
+      {
+        wet=0;
+        sink+=water_stressed(pft,aet_stand,gp_stand,gp_stand_leafon,
+                             gp_pft[getpftpar(pft,id)],&gc_pft,&rd,
+                             &wet,eeq,380,temp,par,daylength,&wdf,pft->par->id,npft,ncft,config);
+      }
+      time+=mrun();
+      ncall+=getnpft(&stand->pftlist);
+    }
+  bench->time=time;
+  bench->name="water_stressed";
+  bench->unit="PFT days/s";
+  bench->ncall=ncall;
+  bench->nitem=(double)ncall;
+  free(gp_pft);
+} /* of 'bench_waterstressed' */
+
+static void bench_littersom(Bench *bench,Cell grid[],int ncell,int nday,
+                            int npft,int ncft,const Config *config)
+{
+  Stocks hetres;
+  Real gtemp_soil[NSOILLAYER];
+  Stand *stand;
+  int cell,day,l;
+  double time;
+  time=0;
+  for(day=0;day<nday;day++)
+    for(cell=0;cell<ncell;cell++)
+    {
+      stand=getstand(grid[cell].standlist,0);
+      foreachsoillayer(l)
+        gtemp_soil[l]=temp_response(stand->soil.temp[l]);
+      time-=mrun();
+      hetres=littersom(stand,gtemp_soil,0,npft,ncft,config);
+      time+=mrun();
+      sink+=hetres.carbon;
+    }
+  bench->time=time;
+  bench->name="littersom";
+  bench->unit="cell days/s";
+  bench->ncall=(long long)ncell*nday;
+  bench->nitem=(double)ncell*nday;
+} /* of 'bench_littersom' */
+
+static void bench_infil(Bench *bench,Cell grid[],int ncell,int nday,
+                        int npft,int ncft,const Config *config)
+{
+  Real prec,temp,return_flow_b;
+  int cell,day;
+  double tstart;
+  tstart=mrun();
+  for(day=0;day<nday;day++)
+    for(cell=0;cell<ncell;cell++)
+    {
+      prec=synthprec(grid+cell,day);
+      temp=synthtemp(grid+cell,day);
+      return_flow_b=0;
+      sink+=infil_perc_rain(getstand(grid[cell].standlist,0),prec,
+                            (prec>0) ? temp*c_water+c_water2ice : 0,
+                            &return_flow_b,npft,ncft,config);
+    }
+  bench->time=mrun()-tstart;
+  bench->name="infil_perc_rain";
+  bench->unit="cell days/s";
+  bench->ncall=(long long)ncell*nday;
+  bench->nitem=(double)ncell*nday;
+} /* of 'bench_infil' */
+
+static void bench_drain(Bench *bench,Cell grid[],int ncell,int nday,
+                        const Config *config)
+{
+  int cell,day,month,dayofmonth;
+  double time;
+  time=0;
+  day=0;
+  for(month=0;month<NMONTH && day<nday;month++)
+    for(dayofmonth=0;dayofmonth<ndaymonth[month] && day<nday;dayofmonth++)
+    {
+      for(cell=0;cell<ncell;cell++)
+        grid[cell].discharge.drunoff=0.3*synthprec(grid+cell,day);
+      time-=mrun();
+      drain(grid,month,config);
+      time+=mrun();
+      day++;
+    }
+  for(cell=0;cell<ncell;cell++)
+    sink+=grid[cell].discharge.dfout;
+  bench->time=time;
+  bench->name="drain";
+  bench->unit="cell days/s";
+  bench->ncall=day;
+  bench->nitem=(double)ncell*day;
+} /* of 'bench_drain' */
+
+static void bench_fwriteoutput(Bench *bench,Outputfile *output,Cell grid[],
+                               int ncell,int nday,int npft,int ncft,
+                               const Config *config)
+{
+  int day,month,dayofmonth;
+  double tstart;
+  long long ncall;
+  tstart=mrun();
+  ncall=0;
+  day=0;
+  for(month=0;month<NMONTH && day<nday;month++)
+  {
+    for(dayofmonth=0;dayofmonth<ndaymonth[month] && day<nday;dayofmonth++)
+    {
+      fwriteoutput(output,grid,config->firstyear,day,DAILY,npft,ncft,config);
+      ncall++;
+      day++;
+    }
+    fwriteoutput(output,grid,config->firstyear,month,MONTHLY,npft,ncft,config);
+    ncall++;
+  }
+  fwriteoutput(output,grid,config->firstyear,0,ANNUAL,npft,ncft,config);
+  ncall++;
+  bench->time=mrun()-tstart;
+  bench->name="fwriteoutput";
+  bench->unit="cells/s";
+  bench->ncall=ncall;
+  bench->nitem=(double)ncell*ncall;
+} /* of 'bench_fwriteoutput' */
+
+static Bool redirectoutput(Config *config,const char *path)
+{
+  /* outputs of the configuration are written with prefixed names into
+     path, so that the benchmark never overwrites outputs of a simulation */
+  int i;
+  char *name;
+  for(i=0;i<config->n_out;i++)
+  {
+    if(config->outputvars[i].filename.fmt==SOCK)
+      continue;
+    name=malloc(strlen(BENCH_PREFIX)+strlen(strippath(config->outputvars[i].filename.name))+1);
+    if(name==NULL)
+    {
+      printallocerr("name");
+      return TRUE;
+    }
+    strcat(strcpy(name,BENCH_PREFIX),strippath(config->outputvars[i].filename.name));
+    free(config->outputvars[i].filename.name);
+    config->outputvars[i].filename.name=addpath(name,path);
+    free(name);
+    if(config->outputvars[i].filename.name==NULL)
+    {
+      printallocerr("name");
+      return TRUE;
+    }
+    config->outputvars[i].filename.issocket=FALSE;
+  }
+  return FALSE;
+} /* of 'redirectoutput' */
+
+static int finish(int rc)
+{
+#ifdef USE_MPI
+  MPI_Finalize();
+#endif
+  return rc;
+} /* of 'finish' */
+
+static void fprintbench(FILE *file,const Bench bench[],int n,int ncell,int nday)
+{
+  int i;
+  fprintf(file,"{\n"
+          "  \"version\" : \"%s\",\n"
+          "  \"ncell\" : %d,\n"
+          "  \"nday\" : %d,\n"
+          "  \"kernels\" :\n"
+          "  [\n",LPJ_VERSION,ncell,nday);
+  for(i=0;i<n;i++)
+    fprintf(file,"    { \"name\" : \"%s\", \"calls\" : %lld, \"time\" : %g, "
+            "\"ns_per_call\" : %g, \"throughput\" : %g, \"unit\" : \"%s\" }%s\n",
+            bench[i].name,bench[i].ncall,bench[i].time,
+            (bench[i].ncall>0) ? bench[i].time*1e9/bench[i].ncall : 0,
+            (bench[i].time>0) ? bench[i].nitem/bench[i].time : 0,
+            bench[i].unit,(i<n-1) ? "," : "");
+  fprintf(file,"  ]\n}\n");
+} /* of 'fprintbench' */
+
+int main(int argc,char **argv)
+{
+  Pfttype scanfcn[NTYPES]=
+  {
+    {name_grass,fscanpft_grass},
+    {name_tree,fscanpft_tree},
+    {name_crop,fscanpft_crop}
+  };
+  Config config;
+  Cell *grid;
+  Outputfile *output;
+  Bench bench[NBENCH];
+  const char *progname,*filename,*benchpath;
+  char *endptr;
+  FILE *file;
+  int ncell,nday,npft,ncft,rc;
+#ifdef USE_MPI
+  MPI_Init(&argc,&argv);
+  initmpiconfig(&config,MPI_COMM_WORLD);
+#else
+  initconfig(&config);
+#endif
+  progname=strippath(argv[0]);
+  ncell=DEFAULT_NCELL;
+  nday=DEFAULT_NDAY;
+  filename=DEFAULT_FILENAME;
+  benchpath=DEFAULT_BENCHPATH;
+  /* parse options of lpjbench, remaining options are processed by readconfig() */
+  while(argc>1 && argv[1][0]=='-')
+  {
+    if(!strcmp(argv[1],"-h") || !strcmp(argv[1],"--help"))
+    {
+      printf("Times numerical kernels of LPJmL version " LPJ_VERSION " on synthetic cells\n\n");
+      printf(USAGE,progname);
+      printf("\nArguments:\n"
+             "-h,--help       print this help text\n"
+             "-v,--version    print LPJmL version\n"
+             "-ncell n        number of synthetic cells, default is %d\n"
+             "-nday n         number of simulated days, default is %d\n"
+             "-o file         filename of JSON result file, default is '%s'\n"
+             "-benchpath dir  directory of output files, names of output files are\n"
+             "                prefixed by '" BENCH_PREFIX "', default is '%s'\n"
+             "filename        configuration filename, soil and PFT parameters and\n"
+             "                outputs are taken from the configuration\n\n"
+             "(C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file\n",
+             DEFAULT_NCELL,DEFAULT_NDAY,DEFAULT_FILENAME,DEFAULT_BENCHPATH);
+      return finish(EXIT_SUCCESS);
+    }
+    else if(!strcmp(argv[1],"-v") || !strcmp(argv[1],"--version"))
+    {
+      puts(LPJ_VERSION);
+      return finish(EXIT_SUCCESS);
+    }
+    else if(!strcmp(argv[1],"-ncell") || !strcmp(argv[1],"-nday"))
+    {
+      if(argc==2)
+      {
+        fprintf(stderr,"Missing argument after option '%s'.\n"
+                USAGE,argv[1],progname);
+        return finish(EXIT_FAILURE);
+      }
+      rc=(int)strtol(argv[2],&endptr,10);
+      if(*endptr!='\0' || rc<1)
+      {
+        fprintf(stderr,"Invalid number '%s' for option '%s'.\n",argv[2],argv[1]);
+        return finish(EXIT_FAILURE);
+      }
+      if(!strcmp(argv[1],"-ncell"))
+        ncell=rc;
+      else if(rc>NDAYYEAR)
+      {
+        fprintf(stderr,"Number of days %d for option '-nday' greater than %d.\n",rc,NDAYYEAR);
+        return finish(EXIT_FAILURE);
+      }
+      else
+        nday=rc;
+      argc-=2;
+      argv+=2;
+    }
+    else if(!strcmp(argv[1],"-o") || !strcmp(argv[1],"-benchpath"))
+    {
+      if(argc==2)
+      {
+        fprintf(stderr,"Missing argument after option '%s'.\n"
+                USAGE,argv[1],progname);
+        return finish(EXIT_FAILURE);
+      }
+      if(!strcmp(argv[1],"-o"))
+        filename=argv[2];
+      else
+        benchpath=argv[2];
+      argc-=2;
+      argv+=2;
+    }
+    else
+      break;
+  }
+  rc=readconfig(&config,scanfcn,NTYPES,NOUT,&argc,&argv,USAGE);
+  failonerror(&config,rc,READ_CONFIG_ERR,"Cannot read configuration");
+  if(config.ntask>1)
+  {
+    if(isroot(config))
+      fprintf(stderr,"ERROR272: %s must be run on one task only.\n",progname);
+    return finish(EXIT_FAILURE);
+  }
+  rc=redirectoutput(&config,benchpath);
+  failonerror(&config,rc,READ_CONFIG_ERR,"Cannot redirect output files");
+  npft=config.npft[GRASS]+config.npft[TREE];
+  ncft=config.npft[CROP];
+  /* replace grid of configuration by synthetic cells */
+  config.nall=config.total=config.ngridcell=config.count=ncell;
+  config.startgrid=config.firstgrid=0;
+  grid=newvec(Cell,ncell);
+  check(grid);
+  rc=initbenchgrid(grid,ncell,npft,ncft,&config);
+  failonerror(&config,rc,INIT_GRID_ERR,"Initialization of benchmark grid failed");
+  output=fopenoutput(grid,NOUT,&config);
+  rc=(output==NULL);
+  failonerror(&config,rc,INIT_OUTPUT_ERR,"Initialization of output data failed");
+  rc=initoutput(output,grid,npft,ncft,&config);
+  failonerror(&config,rc,INIT_OUTPUT_ERR,"Initialization of output data failed");
+  rc=initbenchdrain(grid,ncell,&config);
+  failonerror(&config,rc,INIT_GRID_ERR,"Initialization of river network failed");
+  bench_heatconduction(bench,grid,ncell,nday,&config);
+  bench_soilthermal(bench+1,grid,ncell,nday,&config);
+  bench_photosynthesis(bench+2,grid,ncell,nday);
+  bench_waterstressed(bench+3,grid,ncell,nday,npft,ncft,&config);
+  bench_littersom(bench+4,grid,ncell,nday,npft,ncft,&config);
+  bench_infil(bench+5,grid,ncell,nday,npft,ncft,&config);
+  bench_drain(bench+6,grid,ncell,nday,&config);
+  bench_fwriteoutput(bench+7,output,grid,ncell,nday,npft,ncft,&config);
+  fcloseoutput(output,&config);
+  file=fopen(filename,"w");
+  if(file==NULL)
+  {
+    printfcreateerr(filename);
+    rc=EXIT_FAILURE;
+  }
+  else
+  {
+    fprintbench(file,bench,NBENCH,ncell,nday);
+    fclose(file);
+    printf("Results of %d kernels written to '%s', checksum %g.\n",NBENCH,filename,sink);
+    rc=EXIT_SUCCESS;
+  }
+  /* memory of grid is released at program exit */
+  return finish(rc);
+} /* of 'main' */
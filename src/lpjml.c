@@ -108,7 +108,15 @@ int main(int argc,char **argv)
   };
   time(&tbegin);         /* Start timing for total wall clock time */
 #ifdef USE_MPI
+#if defined USE_PTHREAD
+  /* thread prefetching climate data calls MPI functions concurrently */
+  MPI_Init_thread(&argc,&argv,MPI_THREAD_MULTIPLE,&rc); /* Initialize MPI */
+#elif defined USE_OPENMP
+  /* only the master thread calls MPI functions outside the threaded cell loops */
+  MPI_Init_thread(&argc,&argv,MPI_THREAD_FUNNELED,&rc); /* Initialize MPI */
+#else
   MPI_Init(&argc,&argv); /* Initialize MPI */
+#endif
 /*
  * Use default communicator containing all processors. In defining your own
  * communicator it is possible to run LPJ on a subset of processors
@@ -216,6 +224,8 @@ int main(int argc,char **argv)
     rc=open_coupler(&config);
     snprintf(s,STRING_LEN,"Cannot couple to %s model",config.coupled_model);
     failonerror(&config,rc,OPEN_COUPLER_ERR,s);
+    rc=openshm_coupler(&config);
+    failonerror(&config,rc,OPEN_COUPLER_ERR,"Cannot open shared memory for coupler");
   }
   rc=initinput(&input,grid,config.npft[GRASS]+config.npft[TREE],&config);
   failonerror(&config,rc,INIT_INPUT_ERR,
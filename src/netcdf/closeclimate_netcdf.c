@@ -20,9 +20,11 @@ void closeclimate_netcdf(Climatefile *file,Bool isroot)
 {
 #if defined(USE_NETCDF) || defined(USE_NETCDF4)
   file->isopen=FALSE;
+  free(file->index);
+  file->index=NULL;
   if(file->oneyear)
     free(file->filename);
-  else if(isroot)
+  else if(isroot || file->isdistributed)
     free_netcdf(file->ncid);
 #endif
 } /* of 'closeclimate_netcdf' */
@@ -0,0 +1,111 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**              i  n  i  t  i  n  d  e  x  _  n  e  t  c  d  f  .  c              \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function calculates index of cells in NetCDF data read. Index              \n**/
+/**     is calculated once for each file and is used for all subsequent            \n**/
+/**     reads                                                                      \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#if defined(USE_NETCDF) || defined(USE_NETCDF4)
+
+static void getlatlonindex(size_t index[2],const Coord *coord,
+                           const Climatefile *file)
+{
+  if(file->offset)
+    index[0]=file->offset-(int)((coord->lat-file->lat_min)/file->lat_res+0.5);
+  else
+    index[0]=(int)((coord->lat-file->lat_min)/file->lat_res+0.5);
+  if(file->is360 && coord->lon<0)
+    index[1]=(int)((360+coord->lon-file->lon_min)/file->lon_res+0.5);
+  else
+    index[1]=(int)((coord->lon-file->lon_min)/file->lon_res+0.5);
+} /* of 'getlatlonindex' */
+
+#endif
+
+Bool initindex_netcdf(Climatefile *file,   /**< climate data file */
+                      const Cell grid[],   /**< LPJ grid */
+                      const Config *config /**< LPJ configuration */
+                     )                     /** \return TRUE on error */
+{
+#if defined(USE_NETCDF) || defined(USE_NETCDF4)
+  int cell;
+  Bool rc;
+  size_t index[2],lat_last,lon_last;
+  file->index=newvec(size_t,config->ngridcell);
+  if(file->index==NULL)
+  {
+    printallocerr("index");
+    return TRUE;
+  }
+  /* check coordinates and set lat/lon hyperslab to be read */
+  rc=FALSE;
+  file->slab_offsets[0]=file->nlat;
+  file->slab_offsets[1]=file->nlon;
+  lat_last=lon_last=0;
+  for(cell=0;cell<config->ngridcell;cell++)
+    if(!grid[cell].skip)
+    {
+      getlatlonindex(index,&grid[cell].coord,file);
+      if(checkcoord(index,cell+config->startgrid,&grid[cell].coord,file))
+        rc=TRUE;
+      else
+      {
+        file->slab_offsets[0]=min(file->slab_offsets[0],index[0]);
+        file->slab_offsets[1]=min(file->slab_offsets[1],index[1]);
+        lat_last=max(lat_last,index[0]);
+        lon_last=max(lon_last,index[1]);
+      }
+    }
+  if(rc)
+  {
+    free(file->index);
+    file->index=NULL;
+    return TRUE;
+  }
+  if(!file->isdistributed)
+  {
+    /* whole grid is read by root task */
+    file->slab_offsets[0]=file->slab_offsets[1]=0;
+    file->slab_counts[0]=file->nlat;
+    file->slab_counts[1]=file->nlon;
+  }
+  else if(file->slab_offsets[0]>lat_last)
+  {
+    /* no valid cell on task, read single value */
+    file->slab_offsets[0]=file->slab_offsets[1]=0;
+    file->slab_counts[0]=file->slab_counts[1]=1;
+  }
+  else
+  {
+    /* bounding box of all cells of task */
+    file->slab_counts[0]=lat_last-file->slab_offsets[0]+1;
+    file->slab_counts[1]=lon_last-file->slab_offsets[1]+1;
+  }
+  /* linear index of cell in lat/lon hyperslab */
+  for(cell=0;cell<config->ngridcell;cell++)
+  {
+    getlatlonindex(index,&grid[cell].coord,file);
+    if(index[0]>=file->slab_offsets[0] && index[0]<file->slab_offsets[0]+file->slab_counts[0] &&
+       index[1]>=file->slab_offsets[1] && index[1]<file->slab_offsets[1]+file->slab_counts[1])
+      file->index[cell]=file->slab_counts[1]*(index[0]-file->slab_offsets[0])+index[1]-file->slab_offsets[1];
+    else
+      file->index[cell]=0; /* skipped cell outside data read */
+  }
+  return FALSE;
+#else
+  return TRUE;
+#endif
+} /* of 'initindex_netcdf' */
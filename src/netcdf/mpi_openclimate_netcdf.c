@@ -5,7 +5,8 @@
 /**     C implementation of LPJmL                                                  \n**/
 /**                                                                                \n**/
 /**     Function opens climate data file in NetCDF format on one task              \n**/
-/**     and broadcasts information to all other tasks                              \n**/
+/**     and broadcasts information to all other tasks. If distributed input        \n**/
+/**     is enabled, file is opened on all tasks                                    \n**/
 /**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
@@ -21,7 +22,7 @@
 #include <netcdf.h>
 #endif
 
-Bool mpi_openclimate_netcdf(Climatefile *file,    /**< climate data file */
+Bool mpi_openclimate_netcdf(Climatefile *file,    /**< climate data file, isdistributed has to be set */
                             const Filename *filename, /**< filename */
                             const char *units,    /**< units or NULL */
                             const Config *config  /**< LPJ configuration */
@@ -29,6 +30,9 @@ Bool mpi_openclimate_netcdf(Climatefile *file,    /**< climate data file */
 {
 #if defined(USE_NETCDF) || defined(USE_NETCDF4)
   int rc;
+#ifdef USE_MPI
+  Bool isopen;
+#endif
   if(isroot(*config))
     rc=openclimate_netcdf(file,filename->name,filename->time,filename->var,filename->unit,units,config);
 #ifdef USE_MPI
@@ -59,6 +63,24 @@ Bool mpi_openclimate_netcdf(Climatefile *file,    /**< climate data file */
   MPI_Bcast(&file->offset,sizeof(size_t),MPI_BYTE,0,config->comm);
   MPI_Bcast(&file->missing_value,sizeof(file->missing_value),MPI_BYTE,0,
             config->comm);
+  if(file->isdistributed)
+  {
+    /* open file on all other tasks, variable id is the same */
+    MPI_Bcast(&file->varid,1,MPI_INT,0,config->comm);
+    if(!isroot(*config))
+    {
+      rc=open_netcdf(filename->name,&file->ncid,&isopen);
+      if(rc)
+        fprintf(stderr,"ERROR409: Cannot open '%s' on task %d: %s.\n",
+                filename->name,config->rank,nc_strerror(rc));
+    }
+    if(iserror(rc,config))
+    {
+      if(!rc)
+        free_netcdf(file->ncid);
+      return TRUE;
+    }
+  }
 #endif
   return FALSE;
 #else
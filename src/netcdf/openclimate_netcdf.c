@@ -42,6 +42,7 @@ Bool openclimate_netcdf(Climatefile *file,    /**< climate data file */
   file->isopen=FALSE;
   if(filename==NULL || file==NULL)
     return TRUE;
+  file->index=NULL;
   rc=open_netcdf(filename,&file->ncid,&isopen);
   if(rc)
   {
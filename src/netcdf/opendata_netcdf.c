@@ -22,6 +22,8 @@ Bool opendata_netcdf(Climatefile *file,    /**< data file */
                      const Config *config  /**< LPJ configuration */
                     )                      /** \return TRUE on error */
 {
+  file->isdistributed=FALSE;
+  file->index=NULL;
   if(mpi_openclimate_netcdf(file,filename,units,config))
     return TRUE;
   file->oneyear=FALSE;
@@ -68,6 +68,19 @@ static Bool openfile(Climatefile *file,int year,const Config *config)
 {
   int rc;
   file->isopen=FALSE;
+  if(file->isdistributed)
+  {
+    /* every task opens the file for its own cells */
+    rc=myopen_netcdf(file,year,config);
+    if(iserror(rc,config))
+    {
+      if(!rc)
+        nc_close(file->ncid);
+      return TRUE;
+    }
+    file->isopen=TRUE;
+    return FALSE;
+  }
   if(isroot(*config))
     rc=myopen_netcdf(file,year,config);
 #ifdef USE_MPI
@@ -94,6 +107,12 @@ static Bool openfile(Climatefile *file,int year,const Config *config)
   return FALSE;
 } /* of 'openfile' */
 
+static void closefile(const Climatefile *file,const Config *config)
+{
+  if(file->oneyear && (isroot(*config) || file->isdistributed))
+    nc_close(file->ncid);
+} /* of 'closefile' */
+
 #endif
 
 Bool readclimate_netcdf(Climatefile *file,   /**< climate data file */
@@ -109,8 +128,10 @@ Bool readclimate_netcdf(Climatefile *file,   /**< climate data file */
   double *d;
   short *s;
   int size;
+  Bool ischeck;
   size_t offsets[3];
   size_t counts[3];
+  size_t index,n;
   String line;
   size=isdaily(*file) ? NDAYYEAR : NMONTH;
   if(file->oneyear)
@@ -125,223 +146,193 @@ Bool readclimate_netcdf(Climatefile *file,   /**< climate data file */
     if(isdaily(*file) && file->isleap)
       offsets[0]+=nleapyears(file->firstyear,year+file->firstyear);
   }
-  offsets[1]=offsets[2]=0;
+  if(file->index==NULL)
+  {
+    /* index of cells is calculated only once for each file */
+    if(iserror(initindex_netcdf(file,grid,config),config))
+    {
+      closefile(file,config);
+      return TRUE;
+    }
+    ischeck=(config->check_netcdf_input!=NO_CHECK);
+  }
+  else
+    ischeck=(config->check_netcdf_input==CHECK_ALWAYS);
+  offsets[1]=file->slab_offsets[0];
+  offsets[2]=file->slab_offsets[1];
   counts[0]=size;
-  counts[1]=file->nlat;
-  counts[2]=file->nlon;
+  counts[1]=file->slab_counts[0];
+  counts[2]=file->slab_counts[1];
+  n=counts[1]*counts[2];
   switch(file->datatype)
   {
     case LPJ_FLOAT:
-      f=newvec(float,size*file->nlon*file->nlat);
+      f=newvec(float,size*n);
       if(f==NULL)
       {
         printallocerr("data");
         rc=TRUE;
       }
-      else if(isroot(*config))
+      else if(isroot(*config) || file->isdistributed)
       {
         if((rc=nc_get_vara_float(file->ncid,file->varid,offsets,counts,f)))
-        {
           fprintf(stderr,"ERROR421: Cannot read float data: %s.\n",
-                  nc_strerror(rc)); 
-        }
+                  nc_strerror(rc));
       }
       else
         rc=FALSE;
       if(iserror(rc,config))
       {
         free(f);
-        if(file->oneyear && isroot(*config))
-          nc_close(file->ncid);
+        closefile(file,config);
         return TRUE;
       }
 #ifdef USE_MPI
-      MPI_Bcast(f,size*file->nlon*file->nlat,MPI_FLOAT,0,config->comm);
+      if(!file->isdistributed)
+        MPI_Bcast(f,size*n,MPI_FLOAT,0,config->comm);
 #endif
+      if(ischeck)
+        for(cell=0;cell<config->ngridcell;cell++)
+          if(!grid[cell].skip)
+            for(i=0;i<size;i++)
+            {
+              if(f[file->index[cell]+i*n]==file->missing_value.f)
+              {
+                fprintf(stderr,"ERROR423: Missing value for cell=%d (%s) at %s %d.\n",
+                        cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
+                free(f);
+                closefile(file,config);
+                return TRUE;
+              }
+              else if(isnan(f[file->index[cell]+i*n]))
+              {
+                fprintf(stderr,"ERROR434: Invalid value for cell=%d (%s) at %s %d.\n",
+                        cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
+                free(f);
+                closefile(file,config);
+                return TRUE;
+              }
+            }
       for(cell=0;cell<config->ngridcell;cell++)
         if(!grid[cell].skip)
         {
-          if(file->offset)
-            offsets[1]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          else
-            offsets[1]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          if(file->is360 && grid[cell].coord.lon<0)
-            offsets[2]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          else
-            offsets[2]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          if(checkcoord(offsets+1,cell+config->startgrid,&grid[cell].coord,file))
-          {
-            free(f);
-            if(file->oneyear)
-              nc_close(file->ncid);
-            return TRUE;
-          }
+          index=file->index[cell];
           for(i=0;i<size;i++)
-          {
-            if(f[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]==file->missing_value.f)
-            {
-              fprintf(stderr,"ERROR423: Missing value for cell=%d (%s) at %s %d.\n",
-                      cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
-              free(f);
-              if(file->oneyear && isroot(*config))
-                nc_close(file->ncid);
-              return TRUE;
-            }
-            else if(isnan(f[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]))
-            {
-              fprintf(stderr,"ERROR434: Invalid value for cell=%d (%s) at %s %d.\n",
-                      cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
-              free(f);
-              if(file->oneyear && isroot(*config))
-                nc_close(file->ncid);
-              return TRUE;
-            }
-
-            data[cell*size+i]=file->slope*f[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]+file->intercept;
-          }
+            data[cell*size+i]=file->slope*f[index+i*n]+file->intercept;
         }
       free(f);
       break;
     case LPJ_DOUBLE:
-      d=newvec(double,size*file->nlon*file->nlat);
+      d=newvec(double,size*n);
       if(d==NULL)
       {
         printallocerr("data");
         rc=TRUE;
       }
-      else if(isroot(*config))
+      else if(isroot(*config) || file->isdistributed)
       {
         if((rc=nc_get_vara_double(file->ncid,file->varid,offsets,counts,d)))
-        {
           fprintf(stderr,"ERROR421: Cannot read float data: %s.\n",
                   nc_strerror(rc));
-        }
       }
       else
         rc=FALSE;
       if(iserror(rc,config))
       {
         free(d);
-        if(file->oneyear && isroot(*config))
-          nc_close(file->ncid);
+        closefile(file,config);
         return TRUE;
       }
 #ifdef USE_MPI
-      MPI_Bcast(d,size*file->nlon*file->nlat,MPI_DOUBLE,0,config->comm);
+      if(!file->isdistributed)
+        MPI_Bcast(d,size*n,MPI_DOUBLE,0,config->comm);
 #endif
+      if(ischeck)
+        for(cell=0;cell<config->ngridcell;cell++)
+          if(!grid[cell].skip)
+            for(i=0;i<size;i++)
+            {
+              if(d[file->index[cell]+i*n]==file->missing_value.d)
+              {
+                fprintf(stderr,"ERROR423: Missing value for cell=%d (%s) at %s %d.\n",
+                        cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
+                free(d);
+                closefile(file,config);
+                return TRUE;
+              }
+              else if(isnan(d[file->index[cell]+i*n]))
+              {
+                fprintf(stderr,"ERROR434: Invalid value for cell=%d (%s) at %s %d.\n",
+                        cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
+                free(d);
+                closefile(file,config);
+                return TRUE;
+              }
+            }
       for(cell=0;cell<config->ngridcell;cell++)
         if(!grid[cell].skip)
         {
-          if(file->offset)
-            offsets[1]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          else
-            offsets[1]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          if(file->is360 && grid[cell].coord.lon<0)
-            offsets[2]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          else
-            offsets[2]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          if(checkcoord(offsets+1,cell+config->startgrid,&grid[cell].coord,file))
-          {
-            free(d);
-            if(file->oneyear)
-              nc_close(file->ncid);
-            return TRUE;
-          }
+          index=file->index[cell];
           for(i=0;i<size;i++)
-          {
-            if(d[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]==file->missing_value.d)
-            {
-              fprintf(stderr,"ERROR423: Missing value for cell=%d (%s) at %s %d.\n",
-                      cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
-              free(d);
-              if(file->oneyear && isroot(*config))
-                nc_close(file->ncid);
-              return TRUE;
-            }
-            else if(isnan(d[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]))
-            {
-              fprintf(stderr,"ERROR434: Invalid value for cell=%d (%s) at %s %d.\n",
-                      cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
-              free(d);
-              if(file->oneyear && isroot(*config))
-                nc_close(file->ncid);
-              return TRUE;
-            }
-            data[cell*size+i]=file->slope*d[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]+file->intercept;
-          }
+            data[cell*size+i]=file->slope*d[index+i*n]+file->intercept;
         }
       free(d);
       break;
     case LPJ_SHORT:
-      s=newvec(short,size*file->nlon*file->nlat);
+      s=newvec(short,size*n);
       if(s==NULL)
       {
         printallocerr("data");
         rc=TRUE;
       }
-      else if(isroot(*config))
+      else if(isroot(*config) || file->isdistributed)
       {
         if((rc=nc_get_vara_short(file->ncid,file->varid,offsets,counts,s)))
-        {
           fprintf(stderr,"ERROR421: Cannot read short data: %s.\n",
                   nc_strerror(rc));
-        }
       }
       else
         rc=FALSE;
       if(iserror(rc,config))
       {
         free(s);
-        if(file->oneyear && isroot(*config))
-          nc_close(file->ncid);
+        closefile(file,config);
         return TRUE;
       }
 #ifdef USE_MPI
-      MPI_Bcast(s,size*file->nlon*file->nlat,MPI_SHORT,0,config->comm);
+      if(!file->isdistributed)
+        MPI_Bcast(s,size*n,MPI_SHORT,0,config->comm);
 #endif
+      if(ischeck)
+        for(cell=0;cell<config->ngridcell;cell++)
+          if(!grid[cell].skip)
+            for(i=0;i<size;i++)
+            {
+              if(s[file->index[cell]+i*n]==file->missing_value.s)
+              {
+                fprintf(stderr,"ERROR423: Missing value for cell=%d (%s) at %s %d.\n",
+                        cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
+                free(s);
+                closefile(file,config);
+                return TRUE;
+              }
+            }
       for(cell=0;cell<config->ngridcell;cell++)
         if(!grid[cell].skip)
         {
-          if(file->offset)
-            offsets[1]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          else
-            offsets[1]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          if(file->is360 && grid[cell].coord.lon<0)
-            offsets[2]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          else
-            offsets[2]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          if(checkcoord(offsets+1,cell+config->startgrid,&grid[cell].coord,file))
-          {
-            free(s);
-            if(file->oneyear && isroot(*config))
-              nc_close(file->ncid);
-            return TRUE;
-          }
+          index=file->index[cell];
           for(i=0;i<size;i++)
-          {
-            if(s[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]==file->missing_value.s)
-            {
-              fprintf(stderr,"ERROR423: Missing value for cell=%d (%s) at %s %d.\n",
-                      cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
-              free(s);
-              if(file->oneyear && isroot(*config))
-                nc_close(file->ncid);
-              return TRUE;
-            }
-            data[cell*size+i]=file->slope*s[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]+file->intercept;
-          }
+            data[cell*size+i]=file->slope*s[index+i*n]+file->intercept;
         }
       free(s);
       break;
     default:
       if(isroot(*config))
         fputs("ERROR428: Invalid data type in NetCDF file.\n",stderr);
-      if(file->oneyear && isroot(*config))
-        nc_close(file->ncid);
+      closefile(file,config);
       return TRUE;
   }
-  if(file->oneyear && isroot(*config))
-    nc_close(file->ncid);
+  closefile(file,config);
   return FALSE;
 #else
   if(isroot(*config))
@@ -362,8 +353,10 @@ Bool readintclimate_netcdf(Climatefile *file,   /* climate data file */
   int *f;
   short *s;
   int size;
+  Bool ischeck;
   size_t offsets[3];
   size_t counts[3];
+  size_t index,n;
   String line;
   size=isdaily(*file) ? NDAYYEAR : NMONTH;
   if(file->oneyear)
@@ -378,143 +371,129 @@ Bool readintclimate_netcdf(Climatefile *file,   /* climate data file */
     if(isdaily(*file) && file->isleap)
       offsets[0]+=nleapyears(file->firstyear,year+file->firstyear);
   }
-  offsets[1]=offsets[2]=0;
+  if(file->index==NULL)
+  {
+    /* index of cells is calculated only once for each file */
+    if(iserror(initindex_netcdf(file,grid,config),config))
+    {
+      closefile(file,config);
+      return TRUE;
+    }
+    ischeck=(config->check_netcdf_input!=NO_CHECK);
+  }
+  else
+    ischeck=(config->check_netcdf_input==CHECK_ALWAYS);
+  offsets[1]=file->slab_offsets[0];
+  offsets[2]=file->slab_offsets[1];
   counts[0]=size;
-  counts[1]=file->nlat;
-  counts[2]=file->nlon;
+  counts[1]=file->slab_counts[0];
+  counts[2]=file->slab_counts[1];
+  n=counts[1]*counts[2];
   switch(file->datatype)
   {
     case LPJ_INT:
-      f=newvec(int,size*file->nlon*file->nlat);
+      f=newvec(int,size*n);
       if(f==NULL)
       {
         printallocerr("data");
         rc=TRUE;
       }
-      else if(isroot(*config))
+      else if(isroot(*config) || file->isdistributed)
       {
         if((rc=nc_get_vara_int(file->ncid,file->varid,offsets,counts,f)))
-        {
-          fprintf(stderr,"ERROR421: Cannot read float data: %s.\n",
-                nc_strerror(rc)); 
-        }
+          fprintf(stderr,"ERROR421: Cannot read int data: %s.\n",
+                  nc_strerror(rc));
       }
-      else 
+      else
         rc=FALSE;
       if(iserror(rc,config))
       {
         free(f);
-        if(file->oneyear)
-          nc_close(file->ncid);
+        closefile(file,config);
         return TRUE;
       }
 #ifdef USE_MPI
-      MPI_Bcast(f,size*file->nlon*file->nlat,MPI_INT,0,config->comm);
+      if(!file->isdistributed)
+        MPI_Bcast(f,size*n,MPI_INT,0,config->comm);
 #endif
+      if(ischeck)
+        for(cell=0;cell<config->ngridcell;cell++)
+          if(!grid[cell].skip)
+            for(i=0;i<size;i++)
+            {
+              if(f[file->index[cell]+i*n]==file->missing_value.i)
+              {
+                fprintf(stderr,"ERROR423: Missing value for cell=%d (%s) at %s %d.\n",
+                        cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
+                free(f);
+                closefile(file,config);
+                return TRUE;
+              }
+            }
       for(cell=0;cell<config->ngridcell;cell++)
         if(!grid[cell].skip)
         {
-          if(file->offset)
-            offsets[1]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          else
-            offsets[1]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          if(file->is360 && grid[cell].coord.lon<0)
-            offsets[2]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          else
-          offsets[2]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          if(checkcoord(offsets+1,cell+config->startgrid,&grid[cell].coord,file))
-          {
-            free(f);
-            if(file->oneyear && isroot(*config))
-              nc_close(file->ncid);
-            return TRUE;
-          }
+          index=file->index[cell];
           for(i=0;i<size;i++)
-          {
-            if(f[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]==file->missing_value.i)
-            {
-              fprintf(stderr,"ERROR423: Missing value for cell=%d (%s) at %s %d.\n",
-                      cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
-              free(f);
-              if(file->oneyear && isroot(*config))
-                nc_close(file->ncid);
-              return TRUE;
-            }
-            data[cell*size+i]=f[file->nlon*(i*file->nlat+offsets[1])+offsets[2]];
-          }
+            data[cell*size+i]=f[index+i*n];
         }
       free(f);
       break;
     case LPJ_SHORT:
-      s=newvec(short,size*file->nlon*file->nlat);
+      s=newvec(short,size*n);
       if(s==NULL)
       {
         printallocerr("data");
         rc=TRUE;
       }
-      else if(isroot(*config))
+      else if(isroot(*config) || file->isdistributed)
       {
         if((rc=nc_get_vara_short(file->ncid,file->varid,offsets,counts,s)))
-        {
           fprintf(stderr,"ERROR421: Cannot read short data: %s.\n",
-                  nc_strerror(rc)); 
-        }
+                  nc_strerror(rc));
       }
       else
         rc=FALSE;
       if(iserror(rc,config))
       {
         free(s);
-        if(file->oneyear && isroot(*config))
-          nc_close(file->ncid);
+        closefile(file,config);
         return TRUE;
       }
 #ifdef USE_MPI
-      MPI_Bcast(s,size*file->nlon*file->nlat,MPI_SHORT,0,config->comm);
+      if(!file->isdistributed)
+        MPI_Bcast(s,size*n,MPI_SHORT,0,config->comm);
 #endif
+      if(ischeck)
+        for(cell=0;cell<config->ngridcell;cell++)
+          if(!grid[cell].skip)
+            for(i=0;i<size;i++)
+            {
+              if(s[file->index[cell]+i*n]==file->missing_value.s)
+              {
+                fprintf(stderr,"ERROR423: Missing value for cell=%d (%s) at %s %d.\n",
+                        cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
+                free(s);
+                closefile(file,config);
+                return TRUE;
+              }
+            }
       for(cell=0;cell<config->ngridcell;cell++)
         if(!grid[cell].skip)
         {
-          if(file->offset)
-            offsets[1]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          else
-            offsets[1]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          if(file->is360 && grid[cell].coord.lon<0)
-            offsets[2]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          else
-            offsets[2]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          if(checkcoord(offsets+1,cell+config->startgrid,&grid[cell].coord,file))
-          {
-            free(s);
-            if(file->oneyear && isroot(*config))
-              nc_close(file->ncid);
-            return TRUE;
-          }
+          index=file->index[cell];
           for(i=0;i<size;i++)
-          {
-            if(s[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]==file->missing_value.s)
-            {
-              fprintf(stderr,"ERROR423: Missing value for cell=%d (%s) at %s %d.\n",
-                      cell+config->startgrid,sprintcoord(line,&grid[cell].coord),isdaily(*file) ? "day" : "month",i+1);
-              free(s);
-              if(file->oneyear && isroot(*config))
-                nc_close(file->ncid);
-              return TRUE;
-            }
-            data[cell*size+i]=s[file->nlon*(i*file->nlat+offsets[1])+offsets[2]];
-          }
+            data[cell*size+i]=s[index+i*n];
         }
       free(s);
       break;
     default:
       if(isroot(*config))
         fputs("ERROR428: Invalid data type in NetCDF file.\n",stderr);
-      if(file->oneyear && isroot(*config))
-        nc_close(file->ncid);
+      closefile(file,config);
       return TRUE;
   }
-  if(file->oneyear && isroot(*config))
-    nc_close(file->ncid);
+  closefile(file,config);
   return FALSE;
 #else
   if(isroot(*config))
@@ -537,6 +516,7 @@ int checkvalidclimate_netcdf(Climatefile *file,   /* climate data file */
   int size,count;
   size_t offsets[3];
   size_t counts[3];
+  size_t n;
   size=isdaily(*file) ? NDAYYEAR : NMONTH;
   if(file->oneyear)
   {
@@ -550,76 +530,68 @@ int checkvalidclimate_netcdf(Climatefile *file,   /* climate data file */
     if(isdaily(*file) && file->isleap)
       offsets[0]+=nleapyears(file->firstyear,year+file->firstyear);
   }
-  offsets[1]=offsets[2]=0;
+  if(file->index==NULL)
+  {
+    /* index of cells is calculated only once for each file */
+    if(iserror(initindex_netcdf(file,grid,config),config))
+    {
+      closefile(file,config);
+      return -1;
+    }
+  }
+  offsets[1]=file->slab_offsets[0];
+  offsets[2]=file->slab_offsets[1];
   counts[0]=size;
-  counts[1]=file->nlat;
-  counts[2]=file->nlon;
+  counts[1]=file->slab_counts[0];
+  counts[2]=file->slab_counts[1];
+  n=counts[1]*counts[2];
   count=0;
   switch(file->datatype)
   {
     case LPJ_FLOAT:
-      f=newvec(float,size*file->nlon*file->nlat);
+      f=newvec(float,size*n);
       if(f==NULL)
       {
         printallocerr("data");
         rc=TRUE;
       }
-      else if(isroot(*config))
+      else if(isroot(*config) || file->isdistributed)
       {
         if((rc=nc_get_vara_float(file->ncid,file->varid,offsets,counts,f)))
           fprintf(stderr,"ERROR421: Cannot read float data: %s.\n",
-                  nc_strerror(rc)); 
+                  nc_strerror(rc));
       }
       else
         rc=FALSE;
       if(iserror(rc,config))
       {
         free(f);
-        if(file->oneyear && isroot(*config))
-          nc_close(file->ncid);
+        closefile(file,config);
         return -1;
       }
 #ifdef USE_MPI
-      MPI_Bcast(f,size*file->nlon*file->nlat,MPI_FLOAT,0,config->comm);
+      if(!file->isdistributed)
+        MPI_Bcast(f,size*n,MPI_FLOAT,0,config->comm);
 #endif
       for(cell=0;cell<config->ngridcell;cell++)
         if(!grid[cell].skip)
-        {
-          if(file->offset)
-            offsets[1]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          else
-            offsets[1]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          if(file->is360 && grid[cell].coord.lon<0)
-            offsets[2]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          else
-            offsets[2]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          if(checkcoord(offsets+1,cell+config->startgrid,&grid[cell].coord,file))
-          {
-            free(f);
-            if(file->oneyear && isroot(*config))
-              nc_close(file->ncid);
-            return -1;
-          }
           for(i=0;i<size;i++)
-          {
-            if(f[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]==file->missing_value.f)
+            if(f[file->index[cell]+i*n]==file->missing_value.f)
             {
               count++;
               grid[cell].skip=TRUE;
               break;
             }
-          }
-        }
       free(f);
       break;
     case LPJ_DOUBLE:
-      d=newvec(double,size*file->nlon*file->nlat);
+      d=newvec(double,size*n);
       if(d==NULL)
       {
         printallocerr("data");
         rc=TRUE;
       }
-      else if(isroot(*config))
+      else if(isroot(*config) || file->isdistributed)
       {
         if((rc=nc_get_vara_double(file->ncid,file->varid,offsets,counts,d)))
           fprintf(stderr,"ERROR421: Cannot read float data: %s.\n",
@@ -630,107 +602,67 @@ int checkvalidclimate_netcdf(Climatefile *file,   /* climate data file */
       if(iserror(rc,config))
       {
         free(d);
-        if(file->oneyear && isroot(*config))
-          nc_close(file->ncid);
+        closefile(file,config);
         return -1;
       }
 #ifdef USE_MPI
-      MPI_Bcast(d,size*file->nlon*file->nlat,MPI_DOUBLE,0,config->comm);
+      if(!file->isdistributed)
+        MPI_Bcast(d,size*n,MPI_DOUBLE,0,config->comm);
 #endif
       for(cell=0;cell<config->ngridcell;cell++)
         if(!grid[cell].skip)
-        {
-          if(file->offset)
-            offsets[1]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          else
-            offsets[1]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          if(file->is360 && grid[cell].coord.lon<0)
-            offsets[2]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          else
-            offsets[2]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          if(checkcoord(offsets+1,cell+config->startgrid,&grid[cell].coord,file))
-          {
-            free(d);
-            if(file->oneyear && isroot(*config))
-              nc_close(file->ncid);
-            return -1;
-          }
           for(i=0;i<size;i++)
-          {
-            if(d[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]==file->missing_value.d)
+            if(d[file->index[cell]+i*n]==file->missing_value.d)
             {
               count++;
               grid[cell].skip=TRUE;
               break;
             }
-          }
-        }
       free(d);
       break;
     case LPJ_SHORT:
-      s=newvec(short,size*file->nlon*file->nlat);
+      s=newvec(short,size*n);
       if(s==NULL)
       {
         printallocerr("data");
         rc=TRUE;
       }
-      else if(isroot(*config))
+      else if(isroot(*config) || file->isdistributed)
       {
         if((rc=nc_get_vara_short(file->ncid,file->varid,offsets,counts,s)))
           fprintf(stderr,"ERROR421: Cannot read short data: %s.\n",
-                  nc_strerror(rc)); 
+                  nc_strerror(rc));
       }
       else
         rc=FALSE;
       if(iserror(rc,config))
       {
         free(s);
-        if(file->oneyear && isroot(*config))
-          nc_close(file->ncid);
+        closefile(file,config);
         return -1;
       }
 #ifdef USE_MPI
-      MPI_Bcast(s,size*file->nlon*file->nlat,MPI_SHORT,0,config->comm);
+      if(!file->isdistributed)
+        MPI_Bcast(s,size*n,MPI_SHORT,0,config->comm);
 #endif
       for(cell=0;cell<config->ngridcell;cell++)
         if(!grid[cell].skip)
-        {
-          if(file->offset)
-            offsets[1]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          else
-            offsets[1]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-          if(file->is360 && grid[cell].coord.lon<0)
-            offsets[2]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          else
-            offsets[2]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-          if(checkcoord(offsets+1,cell+config->startgrid,&grid[cell].coord,file))
-          {
-            free(s);
-            if(file->oneyear && isroot(*config))
-              nc_close(file->ncid);
-            return -1;
-          }
           for(i=0;i<size;i++)
-          {
-            if(s[file->nlon*(i*file->nlat+offsets[1])+offsets[2]]==file->missing_value.s)
+            if(s[file->index[cell]+i*n]==file->missing_value.s)
             {
               count++;
               grid[cell].skip=TRUE;
               break;
             }
-          }
-        }
       free(s);
       break;
     default:
       if(isroot(*config))
         fputs("ERROR428: Invalid data type in NetCDF file.\n",stderr);
-      if(file->oneyear && isroot(*config))
-        nc_close(file->ncid);
+      closefile(file,config);
       return -1;
   }
-  if(file->oneyear && isroot(*config))
-    nc_close(file->ncid);
+  closefile(file,config);
   return count;
 #else
   if(isroot(*config))
@@ -20,23 +20,33 @@
 #include <netcdf.h>
 #endif
 
-Bool readdata_netcdf(const Climatefile *file, /**< climate data file */
-                     Real data[],             /**< data to read */
-                     const Cell grid[],       /**< LPJ grid */
-                     int year,                /**< simulation year (0..nyear-1) */
-                     const Config *config     /**< LPJmL configuration */
-                    )                         /** \return TRUE on error */
+Bool readdata_netcdf(Climatefile *file,   /**< climate data file */
+                     Real data[],         /**< data to read */
+                     const Cell grid[],   /**< LPJ grid */
+                     int year,            /**< simulation year (0..nyear-1) */
+                     const Config *config /**< LPJmL configuration */
+                    )                     /** \return TRUE on error */
 {
 #if defined(USE_NETCDF) || defined(USE_NETCDF4)
   int cell,rc,start;
-  size_t i;
+  size_t i,index,n;
   float *f;
   short *s;
+  Bool ischeck;
   size_t offsets[4];
   size_t counts[4];
   String line;
+  if(file->index==NULL)
+  {
+    /* index of cells is calculated only once for each file */
+    if(iserror(initindex_netcdf(file,grid,config),config))
+      return TRUE;
+    ischeck=(config->check_netcdf_input!=NO_CHECK);
+  }
+  else
+    ischeck=(config->check_netcdf_input==CHECK_ALWAYS);
   offsets[0]=year;
-  offsets[1]=offsets[2]=offsets[3]=0;
+  offsets[1]=0;
   counts[0]=1;
   if(file->var_len>1)
   {
@@ -45,12 +55,15 @@ Bool readdata_netcdf(const Climatefile *file, /**< climate data file */
   }
   else
     start=1;
-  counts[start]=file->nlat;
-  counts[start+1]=file->nlon;
+  offsets[start]=file->slab_offsets[0];
+  offsets[start+1]=file->slab_offsets[1];
+  counts[start]=file->slab_counts[0];
+  counts[start+1]=file->slab_counts[1];
+  n=counts[start]*counts[start+1];
   switch(file->datatype)
   {
     case LPJ_FLOAT:
-      f=newvec(float,file->nlon*file->nlat*file->var_len);
+      f=newvec(float,n*file->var_len);
       if(f==NULL)
       {
         printallocerr("data");
@@ -70,48 +83,38 @@ Bool readdata_netcdf(const Climatefile *file, /**< climate data file */
         return TRUE;
       }
 #ifdef USE_MPI
-      MPI_Bcast(f,file->nlon*file->nlat*file->var_len,MPI_FLOAT,0,config->comm);
+      MPI_Bcast(f,n*file->var_len,MPI_FLOAT,0,config->comm);
 #endif
+      if(ischeck)
+        for(cell=0;cell<config->ngridcell;cell++)
+          if(!grid[cell].skip)
+            for(i=0;i<file->var_len;i++)
+            {
+              if(f[file->index[cell]+n*i]==file->missing_value.f)
+              {
+                fprintf(stderr,"ERROR423: Missing value for cell=%d (%s).\n",
+                        cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
+                free(f);
+                return TRUE;
+              }
+              else if(isnan(f[file->index[cell]+n*i]))
+              {
+                fprintf(stderr,"ERROR434: Invalid value for cell=%d (%s).\n",
+                        cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
+                free(f);
+                return TRUE;
+              }
+            }
       for(cell=0;cell<config->ngridcell;cell++)
       {
-        if(file->offset)
-          offsets[start]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-        else
-          offsets[start]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-        if(file->is360 && grid[cell].coord.lon<0)
-          offsets[start+1]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-        else
-          offsets[start+1]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-        if(checkcoord(offsets+start,cell+config->startgrid,&grid[cell].coord,file))
-        {
-          free(f);
-          return TRUE;
-        }
-
+        index=file->index[cell];
         for(i=0;i<file->var_len;i++)
-        {
-          if(!grid[cell].skip && f[file->nlon*file->nlat*i+file->nlon*offsets[start]+offsets[start+1]]==file->missing_value.f)
-          {
-            fprintf(stderr,"ERROR423: Missing value for cell=%d (%s).\n",
-                    cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
-            free(f);
-            return TRUE;
-          }
-          else if(!grid[cell].skip && isnan(f[file->nlon*file->nlat*i+file->nlon*offsets[start]+offsets[start+1]]))
-          {
-            fprintf(stderr,"ERROR434: Invalid value for cell=%d (%s).\n",
-                   cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
-            free(f);
-            return TRUE;
-          }
-
-          data[cell*file->var_len+i]=file->slope*f[file->nlon*file->nlat*i+file->nlon*offsets[start]+offsets[start+1]]+file->intercept;
-        }
+          data[cell*file->var_len+i]=file->slope*f[index+n*i]+file->intercept;
       }
       free(f);
       break;
     case LPJ_SHORT:
-      s=newvec(short,file->nlon*file->nlat*file->var_len);
+      s=newvec(short,n*file->var_len);
       if(s==NULL)
       {
         printallocerr("data");
@@ -131,35 +134,24 @@ Bool readdata_netcdf(const Climatefile *file, /**< climate data file */
         return TRUE;
       }
 #ifdef USE_MPI
-      MPI_Bcast(s,file->nlon*file->nlat*file->var_len,MPI_SHORT,0,config->comm);
+      MPI_Bcast(s,n*file->var_len,MPI_SHORT,0,config->comm);
 #endif
+      if(ischeck)
+        for(cell=0;cell<config->ngridcell;cell++)
+          if(!grid[cell].skip)
+            for(i=0;i<file->var_len;i++)
+              if(s[file->index[cell]+n*i]==file->missing_value.s)
+              {
+                fprintf(stderr,"ERROR423: Missing value for cell=%d (%s).\n",
+                        cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
+                free(s);
+                return TRUE;
+              }
       for(cell=0;cell<config->ngridcell;cell++)
       {
-        if(file->offset)
-          offsets[start]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-        else
-          offsets[start]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-        if(file->is360 && grid[cell].coord.lon<0)
-          offsets[start+1]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-        else
-          offsets[start+1]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-        if(checkcoord(offsets+start,cell+config->startgrid,&grid[cell].coord,file))
-        {
-          free(s);
-          return TRUE;
-        }
-
+        index=file->index[cell];
         for(i=0;i<file->var_len;i++)
-        {
-          if(!grid[cell].skip && s[file->nlon*file->nlat*i+file->nlon*offsets[start]+offsets[start+1]]==file->missing_value.s)
-          {
-            fprintf(stderr,"ERROR423: Missing value for cell=%d (%s).\n",
-                    cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
-            free(s);
-            return TRUE;
-          }
-          data[cell*file->var_len+i]=file->slope*s[file->nlon*file->nlat*i+file->nlon*offsets[1]+offsets[2]]+file->intercept;
-        }
+          data[cell*file->var_len+i]=file->slope*s[index+n*i]+file->intercept;
       }
       free(s);
       break;
@@ -20,7 +20,7 @@
 #include <netcdf.h>
 #endif
 
-Bool readintdata_netcdf(const Climatefile *file, /**< climate data file */
+Bool readintdata_netcdf(Climatefile *file,       /**< climate data file */
                         int data[],              /**< data to read */
                         const Cell grid[],       /**< LPJ grid */
                         int year,                /**< simulation year (0..nyear-1) */
@@ -33,17 +33,29 @@ Bool readintdata_netcdf(const Climatefile *file, /**< climate data file */
   short *s;
   size_t offsets[4];
   size_t counts[4];
+  Bool ischeck;
   String line;
+  if(file->index==NULL)
+  {
+    /* index of cells is calculated only once for each file */
+    if(iserror(initindex_netcdf(file,grid,config),config))
+      return TRUE;
+    ischeck=(config->check_netcdf_input!=NO_CHECK);
+  }
+  else
+    ischeck=(config->check_netcdf_input==CHECK_ALWAYS);
   offsets[0]=year-file->firstyear;
-  offsets[1]=offsets[2]=offsets[3]=0;
+  offsets[1]=file->slab_offsets[0];
+  offsets[2]=file->slab_offsets[1];
+  offsets[3]=0;
   counts[0]=1;
-  counts[1]=file->nlat;
-  counts[2]=file->nlon;
+  counts[1]=file->slab_counts[0];
+  counts[2]=file->slab_counts[1];
   counts[3]=file->var_len;
   switch(file->datatype)
   {
     case LPJ_INT:
-      f=newvec(int,file->nlon*file->nlat*file->var_len);
+      f=newvec(int,counts[1]*counts[2]*file->var_len);
       if(f==NULL)
       {
         printallocerr("data");
@@ -63,37 +75,23 @@ Bool readintdata_netcdf(const Climatefile *file, /**< climate data file */
         return TRUE;
       }
 #ifdef USE_MPI
-      MPI_Bcast(f,file->nlon*file->nlat*file->var_len,MPI_INT,0,config->comm);
+      MPI_Bcast(f,counts[1]*counts[2]*file->var_len,MPI_INT,0,config->comm);
 #endif
       for(cell=0;cell<config->ngridcell;cell++)
       {
-        if(file->offset)
-          offsets[1]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-        else
-          offsets[1]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-        if(file->is360 && grid[cell].coord.lon<0)
-          offsets[2]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-        else
-          offsets[2]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-        if(checkcoord(offsets+1,cell+config->startgrid,&grid[cell].coord,file))
-        {
-          free(f);
-          return TRUE;
-        }
-
-        if(!grid[cell].skip && f[file->nlon*offsets[1]+offsets[2]]==file->missing_value.i)
+        if(ischeck && !grid[cell].skip && f[file->index[cell]]==file->missing_value.i)
         {
           fprintf(stderr,"ERROR423: Missing value for cell=%d (%s).\n",
                   cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
           free(f);
           return TRUE;
         }
-        data[cell]=f[file->nlon*offsets[1]+offsets[2]];
+        data[cell]=f[file->index[cell]];
       }
       free(f);
       break;
     case LPJ_SHORT:
-      s=newvec(short,file->nlon*file->nlat*file->var_len);
+      s=newvec(short,counts[1]*counts[2]*file->var_len);
       if(s==NULL)
       {
         printallocerr("data");
@@ -113,32 +111,18 @@ Bool readintdata_netcdf(const Climatefile *file, /**< climate data file */
         return TRUE;
       }
 #ifdef USE_MPI
-      MPI_Bcast(s,file->nlon*file->nlat*file->var_len,MPI_SHORT,0,config->comm);
+      MPI_Bcast(s,counts[1]*counts[2]*file->var_len,MPI_SHORT,0,config->comm);
 #endif
       for(cell=0;cell<config->ngridcell;cell++)
       {
-        if(file->offset)
-          offsets[1]=file->offset-(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-        else
-          offsets[1]=(int)((grid[cell].coord.lat-file->lat_min)/file->lat_res+0.5);
-        if(file->is360 && grid[cell].coord.lon<0)
-          offsets[2]=(int)((360+grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-        else
-          offsets[2]=(int)((grid[cell].coord.lon-file->lon_min)/file->lon_res+0.5);
-        if(checkcoord(offsets+1,cell+config->startgrid,&grid[cell].coord,file))
-        {
-          free(s);
-          return TRUE;
-        }
-
-        if(!grid[cell].skip && s[file->nlon*offsets[1]+offsets[2]]==file->missing_value.s)
+        if(ischeck && !grid[cell].skip && s[file->index[cell]]==file->missing_value.s)
         {
           fprintf(stderr,"ERROR423: Missing value for cell=%d (%s).\n",
                   cell+config->startgrid,sprintcoord(line,&grid[cell].coord));
           free(s);
           return TRUE;
         }
-        data[cell]=s[file->nlon*offsets[1]+offsets[2]];
+        data[cell]=s[file->index[cell]];
       }
       free(s);
       break;
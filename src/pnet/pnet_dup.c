@@ -42,6 +42,8 @@ Pnet *pnet_dup(const Pnet *pnet
 #ifdef USE_MPI
   ret->type=pnet->type;
   ret->comm=pnet->comm;
+  ret->graph=MPI_COMM_NULL;
+  ret->srclen=ret->srcdisp=ret->destlen=ret->destdisp=NULL;
 #else
   ret->size=pnet->size;
 #endif
@@ -98,5 +100,25 @@ Pnet *pnet_dup(const Pnet *pnet
     free(ret);
     return NULL;
   }
+  /* copy bounds of all tasks */
+  ret->tasklo=newvec(int,pnet->ntask);
+  ret->taskhi=newvec(int,pnet->ntask);
+  if(ret->tasklo==NULL || ret->taskhi==NULL)
+  {
+    free(ret->tasklo);
+    free(ret->taskhi);
+    free(ret->outdisp);
+    free(ret->indisp);
+    free(ret->outlen);
+    free(ret->inlen);
+    freevec(ret->connect,pnet->lo,pnet->hi);
+    free(ret);
+    return NULL;
+  }
+  for(i=0;i<pnet->ntask;i++)
+  {
+    ret->tasklo[i]=pnet->tasklo[i];
+    ret->taskhi[i]=pnet->taskhi[i];
+  }
   return ret;
 } /* of 'pnet_dup' */
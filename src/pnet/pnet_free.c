@@ -40,6 +40,16 @@ void pnet_free(Pnet *pnet)
     free(pnet->inbuffer);
     free(pnet->outbuffer);
     free(pnet->outindex);
+    free(pnet->tasklo);
+    free(pnet->taskhi);
+#ifdef USE_MPI
+    free(pnet->srclen);
+    free(pnet->srcdisp);
+    free(pnet->destlen);
+    free(pnet->destdisp);
+    if(pnet->graph!=MPI_COMM_NULL)
+      MPI_Comm_free(&pnet->graph);
+#endif
     /* empty connection lists */
     for(i=pnet->lo;i<=pnet->hi;i++)
       emptyintlist(pnet->connect+i);
@@ -35,10 +35,14 @@ Pnet *pnet_init(
 #else
                 int size,          /**< size of grid element */
 #endif
-                int n /**< size of grid */
-               )      /** \return initialized pnet structure or NULL */
+                int n              /**< size of grid */
+#ifdef USE_MPI
+               ,int lo,            /**< lower bound of local subgrid */
+                int hi             /**< upper bound of local subgrid */
+#endif
+               )                   /** \return initialized pnet structure or NULL */
 {
-  int slice,rem,i;
+  int i;
   Pnet *pnet;
   if(n<=0) /* number of grid cells must be greater than zero */
     return NULL;
@@ -57,6 +61,8 @@ Pnet *pnet_init(
   MPI_Comm_rank(comm,&pnet->taskid);
   pnet->type=type;
   pnet->comm=comm;
+  pnet->graph=MPI_COMM_NULL;
+  pnet->srclen=pnet->srcdisp=pnet->destlen=pnet->destdisp=NULL;
 #else
   /* sequential code */
   pnet->ntask=1;
@@ -68,26 +74,46 @@ Pnet *pnet_init(
     return NULL;
   }
 #endif
-  /* calculate lower and upper bound of local subgrid */
-  slice=pnet->n/pnet->ntask;
-  rem=pnet->n % pnet->ntask; /* calculate remainder */
-  pnet->lo=pnet->taskid*slice;
-  pnet->hi=(pnet->taskid+1)*slice-1;
-  /* distribute remainder */
-  if(pnet->taskid<rem)
+  pnet->tasklo=newvec(int,pnet->ntask);
+  if(pnet->tasklo==NULL)
   {
-    pnet->lo+=pnet->taskid;
-    pnet->hi+=pnet->taskid+1;
+    free(pnet);
+    return NULL;
   }
-  else
+  pnet->taskhi=newvec(int,pnet->ntask);
+  if(pnet->taskhi==NULL)
   {
-    pnet->lo+=rem;
-    pnet->hi+=rem;
+    free(pnet->tasklo);
+    free(pnet);
+    return NULL;
   }
+#ifdef USE_MPI
+  /* bounds of local subgrid are set by the distribution of cells on tasks */
+  pnet->lo=lo;
+  pnet->hi=hi;
+  MPI_Allgather(&lo,1,MPI_INT,pnet->tasklo,1,MPI_INT,comm);
+  MPI_Allgather(&hi,1,MPI_INT,pnet->taskhi,1,MPI_INT,comm);
+  /* subgrids must be contiguous and cover the whole grid */
+  for(i=0;i<pnet->ntask;i++)
+    if(pnet->tasklo[i]>pnet->taskhi[i] || pnet->tasklo[i]!=((i==0) ? 0 : pnet->taskhi[i-1]+1))
+      break;
+  if(i<pnet->ntask || pnet->taskhi[pnet->ntask-1]!=n-1)
+  {
+    free(pnet->tasklo);
+    free(pnet->taskhi);
+    free(pnet);
+    return NULL;
+  }
+#else
+  pnet->lo=pnet->tasklo[0]=0;
+  pnet->hi=pnet->taskhi[0]=n-1;
+#endif
   /* allocate memory for connection list array */
   pnet->connect=newvec2(Intlist,pnet->lo,pnet->hi);
   if(pnet->connect==NULL) /* was memory allocation successful? */
   {
+    free(pnet->tasklo);
+    free(pnet->taskhi);
     free(pnet);
     return NULL; /* no, return NULL */
   }
@@ -99,6 +125,8 @@ Pnet *pnet_init(
   if(pnet->outdisp==NULL)
   {
     freevec(pnet->connect,pnet->lo,pnet->hi);
+    free(pnet->tasklo);
+    free(pnet->taskhi);
     free(pnet);
     return NULL;
   }
@@ -107,6 +135,8 @@ Pnet *pnet_init(
   {
     free(pnet->outdisp);
     freevec(pnet->connect,pnet->lo,pnet->hi);
+    free(pnet->tasklo);
+    free(pnet->taskhi);
     free(pnet);
     return NULL;
   }
@@ -116,6 +146,8 @@ Pnet *pnet_init(
     free(pnet->outdisp);
     free(pnet->indisp);
     freevec(pnet->connect,pnet->lo,pnet->hi);
+    free(pnet->tasklo);
+    free(pnet->taskhi);
     free(pnet);
     return NULL;
   }
@@ -126,6 +158,8 @@ Pnet *pnet_init(
     free(pnet->outdisp);
     free(pnet->indisp);
     freevec(pnet->connect,pnet->lo,pnet->hi);
+    free(pnet->tasklo);
+    free(pnet->taskhi);
     free(pnet);
     return NULL;
   }
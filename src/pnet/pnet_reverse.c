@@ -44,41 +44,15 @@ static int compare(const data_t *a,const data_t *b)
 int pnet_reverse(Pnet *pnet /**< Pointer to Pnet structure */
                 )           /** \return error code        */
 {
-  int *lo,*hi;
-  int i,j,size,slice,rem,task,outsize,rc;
+  const int *hi;
+  int i,j,size,task,outsize,rc;
   data_t *in,*out;
 #ifdef USE_MPI
   MPI_Datatype type;
 #endif
   if(pnet==NULL)
     return PNET_NULL_PTR_ERR;
-  slice=pnet->n/pnet->ntask;
-  rem=pnet->n % pnet->ntask;
-  lo=newvec(int,pnet->ntask);
-  if(lo==NULL)
-    return PNET_ALLOC_ERR;
-  hi=newvec(int,pnet->ntask);
-  if(hi==NULL)
-  {
-    free(lo);
-    return PNET_ALLOC_ERR;
-  }
-   /* calculate lower and upper bounds for all tasks */
-  for(i=0;i<pnet->ntask;i++)
-  {
-    lo[i]=i*slice;
-    hi[i]=(i+1)*slice-1;
-    if(i<rem)
-    {
-       lo[i]+=i;
-       hi[i]+=i+1;
-    }
-    else
-    {
-      lo[i]+=rem;
-      hi[i]+=rem;
-    }
-  }
+  hi=pnet->taskhi; /* upper bounds of all tasks */
   for(i=0;i<pnet->ntask;i++)
     pnet->outlen[i]=pnet->inlen[i]=0;
   /* determine total length of connection lists */
@@ -88,8 +62,6 @@ int pnet_reverse(Pnet *pnet /**< Pointer to Pnet structure */
   in=newvec(data_t,size);
   if(in==NULL)
   {
-    free(lo);
-    free(hi);
     return PNET_ALLOC_ERR;
   }
   /* concatenate connection lists to array in */
@@ -156,8 +128,6 @@ int pnet_reverse(Pnet *pnet /**< Pointer to Pnet structure */
   out=newvec(data_t,outsize);
   if(out==NULL)
   {
-    free(lo);
-    free(hi);
     free(in);
     return PNET_ALLOC_ERR;
   }
@@ -193,16 +163,12 @@ int pnet_reverse(Pnet *pnet /**< Pointer to Pnet structure */
     if(rc!=PNET_OK)
     {
       free(in);
-      free(lo);
-      free(hi);
       free(out);
       return rc;
     }
   }
   /* free memory */
   free(in);
-  free(lo);
-  free(hi);
   free(out);
   return PNET_OK;
 } /* of 'pnet_reverse' */
@@ -39,44 +39,66 @@ static int compare(const int *a,const int *b)
   return *a-*b;
 } /* of 'compare' */
 
-int pnet_setup(Pnet *pnet /**< Pointer to Pnet structure */
-              )           /** \return error code        */
-{
-  int *lo,*hi;
-  int i,j,k,*index,*in,size,slice,rem,task,insize;
 #ifdef USE_MPI
-  MPI_Aint lb;
-  MPI_Aint extent;
-#endif
-  if(pnet==NULL)
-    return PNET_NULL_PTR_ERR;
-  slice=pnet->n/pnet->ntask;
-  rem=pnet->n % pnet->ntask;
-  lo=newvec(int,pnet->ntask);
-  if(lo==NULL)
-    return PNET_ALLOC_ERR;
-  hi=newvec(int,pnet->ntask);
-  if(hi==NULL)
+static int setupgraph(Pnet *pnet /**< Pointer to Pnet structure */
+                     )           /** \return error code        */
+{
+  /* Function creates communicator with tasks connected by the network */
+  int k,nsrc,ndest,*src,*dest;
+  src=newvec(int,pnet->ntask);
+  dest=newvec(int,pnet->ntask);
+  pnet->srclen=newvec(int,pnet->ntask);
+  pnet->srcdisp=newvec(int,pnet->ntask);
+  pnet->destlen=newvec(int,pnet->ntask);
+  pnet->destdisp=newvec(int,pnet->ntask);
+  if(src==NULL || dest==NULL || pnet->srclen==NULL || pnet->srcdisp==NULL ||
+     pnet->destlen==NULL || pnet->destdisp==NULL)
   {
-    free(lo);
+    free(src);
+    free(dest);
     return PNET_ALLOC_ERR;
   }
-  /* calculate lower and upper bounds for all tasks */
-  for(i=0;i<pnet->ntask;i++)
+  /* only tasks with nonzero input or output length are neighbours */
+  nsrc=ndest=0;
+  for(k=0;k<pnet->ntask;k++)
   {
-    lo[i]=i*slice;
-    hi[i]=(i+1)*slice-1;
-    if(i<rem)
+    if(pnet->inlen[k])
     {
-       lo[i]+=i;
-       hi[i]+=i+1;
+      src[nsrc]=k;
+      pnet->srclen[nsrc]=pnet->inlen[k];
+      pnet->srcdisp[nsrc++]=pnet->indisp[k];
     }
-    else
+    if(pnet->outlen[k])
     {
-      lo[i]+=rem;
-      hi[i]+=rem;
+      dest[ndest]=k;
+      pnet->destlen[ndest]=pnet->outlen[k];
+      pnet->destdisp[ndest++]=pnet->outdisp[k];
     }
   }
+#if MPI_VERSION>=3
+  /* message sizes are used as edge weights */
+  MPI_Dist_graph_create_adjacent(pnet->comm,nsrc,src,pnet->srclen,
+                                 ndest,dest,pnet->destlen,MPI_INFO_NULL,
+                                 FALSE,&pnet->graph);
+#endif
+  free(src);
+  free(dest);
+  return PNET_OK;
+} /* of 'setupgraph' */
+#endif
+
+int pnet_setup(Pnet *pnet /**< Pointer to Pnet structure */
+              )           /** \return error code        */
+{
+  const int *hi;
+  int i,j,k,*index,*in,size,task,insize;
+#ifdef USE_MPI
+  MPI_Aint lb;
+  MPI_Aint extent;
+#endif
+  if(pnet==NULL)
+    return PNET_NULL_PTR_ERR;
+  hi=pnet->taskhi; /* upper bounds of all tasks */
   for(i=0;i<pnet->ntask;i++)
     pnet->outlen[i]=pnet->inlen[i]=0;
   /* determine total length of connection lists */
@@ -87,8 +109,6 @@ int pnet_setup(Pnet *pnet /**< Pointer to Pnet structure */
   if(in==NULL)
   {
     /* error allocating memory, exit with error code */
-    free(lo);
-    free(hi);
     pnet->outindex=NULL;
     pnet->inbuffer=pnet->outbuffer=NULL;
     return PNET_ALLOC_ERR;
@@ -177,8 +197,6 @@ int pnet_setup(Pnet *pnet /**< Pointer to Pnet structure */
   pnet->outindex=newvec(int,pnet->outsize);
   if(pnet->outindex==NULL)
   {
-    free(lo);
-    free(hi);
     free(in);
     pnet->inbuffer=pnet->outbuffer=NULL;
     return PNET_ALLOC_ERR;
@@ -204,6 +222,14 @@ int pnet_setup(Pnet *pnet /**< Pointer to Pnet structure */
     printf(" %d",pnet->outindex[i]);
   }
   printf("\n");
+#endif
+#ifdef USE_MPI
+  if(setupgraph(pnet))
+  {
+    free(in);
+    pnet->inbuffer=pnet->outbuffer=NULL;
+    return PNET_ALLOC_ERR;
+  }
 #endif
   /* Allocation of input and output buffer */
 #ifdef USE_MPI
@@ -215,7 +241,5 @@ int pnet_setup(Pnet *pnet /**< Pointer to Pnet structure */
   pnet->inbuffer=malloc(pnet->size*insize);
 #endif
   free(in);
-  free(lo);
-  free(hi);
   return (pnet->outbuffer==NULL || pnet->inbuffer==NULL) ? PNET_ALLOC_ERR : PNET_OK;
 } /* of 'pnet_setup' */
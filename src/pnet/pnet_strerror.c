@@ -36,6 +36,7 @@ char *pnet_strerror(int err /**< error code */
                          "Invalid to index",
                          "Invalid from index",
                          "Invalid pointer",
+                         "Invalid bounds",
                          "unknown error"};
-  return errstr[(err<0 || err>PNET_NULL_PTR_ERR) ? 5 : err];
+  return errstr[(err<0 || err>PNET_BOUNDS_ERR) ? 6 : err];
 } /* of 'pnet_strerror' */
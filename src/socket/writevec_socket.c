@@ -0,0 +1,79 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**               w  r  i  t  e  v  e  c  _  s  o  c  k  e  t  .  c                \n**/
+/**                                                                                \n**/
+/**     Function writes several buffers to socket with a single call               \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/uio.h>
+#endif
+#include "types.h"
+#include "channel.h"
+
+#define MAXVEC 16 /* maximum number of buffers written at once */
+
+Bool writevec_socket(Socket *socket,         /**< socket */
+                     const Sockbuffer vec[], /**< buffers to be written */
+                     int n                   /**< number of buffers */
+                    )                        /** \return TRUE on error */
+{
+#ifdef _WIN32
+  int i;
+  for(i=0;i<n;i++)
+    if(write_socket(socket,vec[i].data,vec[i].size))
+      return TRUE;
+  return FALSE;
+#else
+  struct iovec iov[MAXVEC];
+  ssize_t j;
+  int i,first;
+#ifdef USE_TIMING
+  double tstart,tend;
+  tstart=mrun();
+#endif
+  if(n>MAXVEC)
+  {
+    /* write first buffers and continue with remaining ones */
+    if(writevec_socket(socket,vec,n-MAXVEC))
+      return TRUE;
+    vec+=n-MAXVEC;
+    n=MAXVEC;
+  }
+  for(i=0;i<n;i++)
+  {
+    iov[i].iov_base=(void *)vec[i].data;
+    iov[i].iov_len=vec[i].size;
+  }
+  first=0;
+  while(first<n)
+  {
+    j=writev(socket->channel,iov+first,n-first);
+    if(j<0)
+      return TRUE;
+    /* skip buffers written completely and adjust partially written buffer */
+    while(first<n && j>=(ssize_t)iov[first].iov_len)
+      j-=iov[first++].iov_len;
+    if(first<n)
+    {
+      iov[first].iov_base=(char *)iov[first].iov_base+j;
+      iov[first].iov_len-=j;
+    }
+  }
+#ifdef USE_TIMING
+  tend=mrun();
+  timing+=tend-tstart;
+#endif
+  return FALSE;
+#endif
+} /* of 'writevec_socket' */
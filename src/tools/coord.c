@@ -341,6 +341,23 @@ int seekcoord(Coordfile coordfile, /**< open coord file */
                SEEK_SET);
 } /* of 'seekcoord' */
 
+#ifdef USE_MPI
+
+Bool readslicecoord(Coordfile coordfile, /**< open coord file positioned at first cell */
+                    int ncell,           /**< number of cells of task */
+                    MPI_Comm node        /**< communicator of tasks on node */
+                   )                     /** \return TRUE on error */
+{
+  FILE *file;
+  file=freadslice(coordfile->file,(size_t)ncell*2*typesizes[coordfile->datatype],node);
+  if(file==NULL)
+    return TRUE;
+  coordfile->file=file;
+  return FALSE;
+} /* of 'readslicecoord' */
+
+#endif
+
 Real cellarea(const Coord *coord, /**< cell coordinate */
               const Coord *resol  /**< resolution (deg) */
              )                    /** \return area of cell (m^2) */
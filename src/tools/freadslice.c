@@ -0,0 +1,162 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                   f  r  e  a  d  s  l  i  c  e  .  c                           \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function reads the slices of a binary input file of all tasks on a         \n**/
+/**     node by the first task of the node and scatters them. Each task then       \n**/
+/**     reads its cells from a memory stream instead of the file, so the           \n**/
+/**     file system sees only one reader per node. Function readsliceinput         \n**/
+/**     does the same for input data files opened by openinputdata().              \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#ifdef USE_MPI
+
+#define SLICE_OK 0       /* slices read and scattered */
+#define SLICE_ERR 1      /* error reading slices */
+#define SLICE_FILE 2     /* slices too large, file is read directly */
+
+FILE *freadslice(FILE *file,   /**< file positioned at first cell of task */
+                 size_t size,  /**< size of data of task (bytes) */
+                 MPI_Comm node /**< communicator of tasks on node */
+                )              /** \return memory stream, file or NULL on error */
+{
+  /*
+   * On success file is closed and replaced by the memory stream. On error
+   * NULL is returned and file is left open. This function has to be called
+   * by all tasks of node.
+   */
+#ifdef _WIN32
+  return file; /* memory streams not supported, file is read directly */
+#else
+  long long slice[2],*slices,total;
+  int *counts,*offsets;
+  int i,j,rank,ntask,status;
+  char *buffer,*data;
+  FILE *mem;
+  MPI_Comm_rank(node,&rank);
+  MPI_Comm_size(node,&ntask);
+  slice[0]=ftell(file);
+  slice[1]=size;
+  slices=NULL;
+  counts=offsets=NULL;
+  buffer=NULL;
+  status=SLICE_OK;
+  if(rank==0)
+  {
+    slices=newvec(long long,2*ntask);
+    counts=newvec(int,ntask);
+    offsets=newvec(int,ntask);
+    if(slices==NULL || counts==NULL || offsets==NULL)
+    {
+      printallocerr("slices");
+      status=SLICE_ERR;
+    }
+  }
+  MPI_Bcast(&status,1,MPI_INT,0,node);
+  if(status==SLICE_ERR)
+  {
+    free(slices);
+    free(counts);
+    free(offsets);
+    return NULL;
+  }
+  MPI_Gather(slice,2,MPI_LONG_LONG,slices,2,MPI_LONG_LONG,0,node);
+  if(rank==0)
+  {
+    total=0;
+    for(i=0;i<ntask;i++)
+    {
+      if(slices[2*i]<0 || total+slices[2*i+1]>INT_MAX)
+      {
+        /* position unknown or slices too large for MPI_Scatterv() */
+        status=SLICE_FILE;
+        break;
+      }
+      counts[i]=(int)slices[2*i+1];
+      offsets[i]=(int)total;
+      total+=counts[i];
+    }
+    if(status==SLICE_OK)
+    {
+      buffer=malloc(max(total,1));
+      if(buffer==NULL)
+        status=SLICE_FILE;
+    }
+    /* read slices, slices adjacent in file are read with one call */
+    for(i=0;status==SLICE_OK && i<ntask;i=j)
+    {
+      for(j=i+1;j<ntask && slices[2*j]==slices[2*(j-1)]+slices[2*j-1];j++);
+      if(fseek(file,slices[2*i],SEEK_SET) ||
+         fread(buffer+offsets[i],1,offsets[j-1]+counts[j-1]-offsets[i],file)!=(size_t)(offsets[j-1]+counts[j-1]-offsets[i]))
+      {
+        fprintf(stderr,"ERROR282: Cannot read %d bytes at position %lld of input file: %s.\n",
+                offsets[j-1]+counts[j-1]-offsets[i],slices[2*i],strerror(errno));
+        status=SLICE_ERR;
+      }
+    }
+    if(status==SLICE_FILE)
+      fseek(file,slice[0],SEEK_SET);
+  }
+  MPI_Bcast(&status,1,MPI_INT,0,node);
+  if(status!=SLICE_OK)
+  {
+    free(buffer);
+    free(slices);
+    free(counts);
+    free(offsets);
+    return (status==SLICE_FILE) ? file : NULL;
+  }
+  /* size may be zero for tasks without cells */
+  data=malloc(max(size,1));
+  check(data);
+  MPI_Scatterv(buffer,counts,offsets,MPI_BYTE,data,(int)size,MPI_BYTE,0,node);
+  free(buffer);
+  free(slices);
+  free(counts);
+  free(offsets);
+  /* memory stream owns its buffer, which is freed by fclose() */
+  mem=fmemopen(NULL,max(size,1),"w+b");
+  if(mem==NULL || fwrite(data,1,size,mem)!=size)
+  {
+    /* fall back to reading from file */
+    if(mem!=NULL)
+      fclose(mem);
+    free(data);
+    if(rank==0)
+      fseek(file,slice[0],SEEK_SET);
+    return file;
+  }
+  free(data);
+  rewind(mem);
+  fclose(file);
+  return mem;
+#endif
+} /* of 'freadslice' */
+
+Bool readsliceinput(Infile *file,  /**< input file positioned at first cell of task */
+                    int ncell,     /**< number of cells of task */
+                    MPI_Comm node  /**< communicator of tasks on node */
+                   )               /** \return TRUE on error */
+{
+  FILE *mem;
+  if(file->fmt==CDF)
+    return FALSE;
+  mem=freadslice(file->file,(size_t)ncell*typesizes[file->type],node);
+  if(mem==NULL)
+    return TRUE;
+  file->file=mem;
+  return FALSE;
+} /* of 'readsliceinput' */
+
+#endif
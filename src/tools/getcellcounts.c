@@ -0,0 +1,72 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                  g  e  t  c  e  l  l  c  o  u  n  t  s  .  c                   \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function gets number of cells and offsets for each task used in            \n**/
+/**     MPI_Gatherv/MPI_Scatterv. In contrast to getcounts() the actual            \n**/
+/**     distribution of cells is used which may be unequal for a cost-aware        \n**/
+/**     partition. The numbers of cells of all tasks are gathered once by          \n**/
+/**     initcellcounts() after the partition and scaled by getcellcounts().        \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+Bool initcellcounts(Config *config /**< LPJmL configuration */
+                   )              /** \return TRUE on error */
+{
+#ifdef USE_MPI
+  int i;
+  if(config->ntask==1)
+    return FALSE;
+  config->cellcounts=newvec(int,config->ntask);
+  config->celloffsets=newvec(int,config->ntask);
+  if(config->cellcounts==NULL || config->celloffsets==NULL)
+  {
+    printallocerr("cellcounts");
+    free(config->cellcounts);
+    free(config->celloffsets);
+    config->cellcounts=config->celloffsets=NULL;
+    return TRUE;
+  }
+  MPI_Allgather(&config->ngridcell,1,MPI_INT,config->cellcounts,1,MPI_INT,config->comm);
+  config->celloffsets[0]=0;
+  for(i=1;i<config->ntask;i++)
+    config->celloffsets[i]=config->celloffsets[i-1]+config->cellcounts[i-1];
+#endif
+  return FALSE;
+} /* of 'initcellcounts' */
+
+void getcellcounts(int counts[],        /**< number of items for each task */
+                   int offsets[],       /**< offsets of items for each task */
+                   int n,               /**< number of items per cell */
+                   const Config *config /**< LPJmL configuration */
+                  )
+{
+#ifdef USE_MPI
+  int i;
+  if(config->cellcounts==NULL)
+  {
+    /* only one task */
+    counts[0]=config->ngridcell*n;
+    offsets[0]=0;
+    return;
+  }
+  for(i=0;i<config->ntask;i++)
+  {
+    counts[i]=config->cellcounts[i]*n;
+    offsets[i]=config->celloffsets[i]*n;
+  }
+#else
+  counts[0]=config->ngridcell*n;
+  offsets[0]=0;
+#endif
+} /* of 'getcellcounts' */
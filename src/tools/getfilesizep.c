@@ -22,5 +22,18 @@ long long getfilesizep(FILE *file /**< pointer to file */
                                       on error */
 {
   struct stat filestat;
-  return (file==NULL) ? -1 : ((fstat(fileno(file),&filestat)) ? -1 : filestat.st_size);
+  long long pos,size;
+  if(file==NULL)
+    return -1;
+  if(fileno(file)==-1)
+  {
+    /* file without file descriptor, e.g. compressed file opened by openzfile() */
+    pos=ftell(file);
+    if(pos==-1 || fseek(file,0,SEEK_END))
+      return -1;
+    size=ftell(file);
+    fseek(file,pos,SEEK_SET);
+    return size;
+  }
+  return (fstat(fileno(file),&filestat)) ? -1 : filestat.st_size;
 } /* of 'getfilesizep' */
@@ -0,0 +1,198 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                        m  a  p  f  i  l  e  .  c                               \n**/
+/**                                                                                \n**/
+/**     Functions map binary input files into memory and convert mapped            \n**/
+/**     data into real and integer arrays. Pages of the file are shared via        \n**/
+/**     page cache between repeated reads and between tasks on one node.           \n**/
+/**     On systems without mmap() NULL is returned and data are read by            \n**/
+/**     readrealvec() and readintvec().                                            \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+#include "types.h"
+#include "swap.h"
+
+void *mapfile(FILE *file, /**< pointer to open binary file */
+              size_t *len /**< length of mapped file in bytes */
+             )            /** \return pointer to mapped file or NULL */
+{
+#ifdef _WIN32
+  return NULL;
+#else
+  struct stat filestat;
+  void *map;
+  if(fstat(fileno(file),&filestat) || filestat.st_size==0)
+    return NULL;
+  map=mmap(NULL,filestat.st_size,PROT_READ,MAP_SHARED,fileno(file),0);
+  if(map==MAP_FAILED)
+    return NULL;
+  *len=filestat.st_size;
+  return map;
+#endif
+} /* of 'mapfile' */
+
+void unmapfile(void *map, /**< pointer to mapped file or NULL */
+               size_t len /**< length of mapped file in bytes */
+              )
+{
+#ifndef _WIN32
+  if(map!=NULL)
+    munmap(map,len);
+#endif
+} /* of 'unmapfile' */
+
+Bool readrealmap(const void *map, /**< pointer to mapped file */
+                 size_t len,      /**< length of mapped file in bytes */
+                 long long offset,/**< offset of data in file in bytes */
+                 Real data[],     /**< array of reals converted from file */
+                 Real intercept,  /**< intercept for rescaling data */
+                 Real slope,      /**< slope for rescaling data */
+                 size_t n,        /**< size of real array */
+                 Bool swap,       /**< byte order has to be swapped (TRUE/FALSE) */
+                 Type type        /**< type of data in file */
+                )                 /** \return TRUE if data are outside of mapped file */
+{
+  const char *ptr;
+  short s;
+  int i;
+  float f;
+  double d;
+  Num num;
+  size_t j;
+  if(offset<0 || offset+n*typesizes[type]>len)
+    return TRUE;
+  ptr=(const char *)map+offset;
+  /* memcpy is used because data in file need not be aligned */
+  switch(type)
+  {
+    case LPJ_BYTE:
+      for(j=0;j<n;j++)
+        data[j]=intercept+((const Byte *)ptr)[j]*slope;
+      break;
+    case LPJ_SHORT:
+      for(j=0;j<n;j++)
+      {
+        memcpy(&s,ptr+j*sizeof(short),sizeof(short));
+        data[j]=intercept+((swap) ? swapshort(s) : s)*slope;
+      }
+      break;
+    case LPJ_INT:
+      for(j=0;j<n;j++)
+      {
+        memcpy(&i,ptr+j*sizeof(int),sizeof(int));
+        data[j]=intercept+((swap) ? swapint(i) : i)*slope;
+      }
+      break;
+    case LPJ_FLOAT:
+      for(j=0;j<n;j++)
+      {
+        if(swap)
+        {
+          memcpy(&i,ptr+j*sizeof(float),sizeof(float));
+          f=swapfloat(i);
+        }
+        else
+          memcpy(&f,ptr+j*sizeof(float),sizeof(float));
+        data[j]=intercept+f*slope;
+      }
+      break;
+    case LPJ_DOUBLE:
+      for(j=0;j<n;j++)
+      {
+        if(swap)
+        {
+          memcpy(&num,ptr+j*sizeof(double),sizeof(double));
+          d=swapdouble(num);
+        }
+        else
+          memcpy(&d,ptr+j*sizeof(double),sizeof(double));
+        data[j]=intercept+d*slope;
+      }
+      break;
+  } /* of switch */
+  return FALSE;
+} /* of 'readrealmap' */
+
+Bool readintmap(const void *map, /**< pointer to mapped file */
+                size_t len,      /**< length of mapped file in bytes */
+                long long offset,/**< offset of data in file in bytes */
+                int data[],      /**< array of integers converted from file */
+                size_t n,        /**< size of integer array */
+                Bool swap,       /**< byte order has to be swapped (TRUE/FALSE) */
+                Type type        /**< type of data in file */
+               )                 /** \return TRUE if data are outside of mapped file */
+{
+  const char *ptr;
+  short s;
+  int i;
+  float f;
+  double d;
+  Num num;
+  size_t j;
+  if(offset<0 || offset+n*typesizes[type]>len)
+    return TRUE;
+  ptr=(const char *)map+offset;
+  switch(type)
+  {
+    case LPJ_BYTE:
+      for(j=0;j<n;j++)
+        data[j]=((const Byte *)ptr)[j];
+      break;
+    case LPJ_SHORT:
+      for(j=0;j<n;j++)
+      {
+        memcpy(&s,ptr+j*sizeof(short),sizeof(short));
+        data[j]=(swap) ? swapshort(s) : s;
+      }
+      break;
+    case LPJ_INT:
+      for(j=0;j<n;j++)
+      {
+        memcpy(&i,ptr+j*sizeof(int),sizeof(int));
+        data[j]=(swap) ? swapint(i) : i;
+      }
+      break;
+    case LPJ_FLOAT:
+      for(j=0;j<n;j++)
+      {
+        if(swap)
+        {
+          memcpy(&i,ptr+j*sizeof(float),sizeof(float));
+          f=swapfloat(i);
+        }
+        else
+          memcpy(&f,ptr+j*sizeof(float),sizeof(float));
+        data[j]=(int)f;
+      }
+      break;
+    case LPJ_DOUBLE:
+      for(j=0;j<n;j++)
+      {
+        if(swap)
+        {
+          memcpy(&num,ptr+j*sizeof(double),sizeof(double));
+          d=swapdouble(num);
+        }
+        else
+          memcpy(&d,ptr+j*sizeof(double),sizeof(double));
+        data[j]=(int)d;
+      }
+      break;
+  } /* of switch */
+  return FALSE;
+} /* of 'readintmap' */
@@ -0,0 +1,50 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                   m  p  i  _  w  r  i  t  e  _  a  t  .  c                     \n**/
+/**                                                                                \n**/
+/**     C implementation of LPJmL                                                  \n**/
+/**                                                                                \n**/
+/**     Function writes output from all tasks in parallel using MPI-IO.            \n**/
+/**     Each task writes its part at its offset in the file, no data are           \n**/
+/**     gathered on the root task. Counts and offsets are determined once          \n**/
+/**     at opening of the output, so no further communication is needed.          \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#include "lpj.h"
+
+#ifdef USE_MPI
+
+int mpi_write_at(MPI_File fh,         /**< MPI file handle */
+                 MPI_Offset *position,/**< actual position in file, updated */
+                 void *data,          /**< data to be written to disk */
+                 MPI_Datatype type,   /**< MPI datatype of data */
+                 int size,            /**< total number of items of all tasks */
+                 int counts[],        /**< number of items for each task */
+                 int offsets[],       /**< offsets of items for each task */
+                 int rank             /**< MPI rank */
+                )                     /** \return number of items written to disk */
+{
+  int rc;
+  MPI_Aint lb;
+  MPI_Aint extent;
+  MPI_Status status;
+  MPI_Type_get_extent(type,&lb,&extent);
+  rc=MPI_File_write_at_all(fh,*position+(MPI_Offset)offsets[rank]*extent,data,
+                           counts[rank],type,&status);
+  *position+=(MPI_Offset)size*extent;
+  if(rc!=MPI_SUCCESS)
+  {
+    /* error is reported by each failing task like in mpi_write() */
+    fprintf(stderr,"ERROR204: Cannot write output in parallel on task %d.\n",rank);
+    return 0;
+  }
+  return size;
+} /* of 'mpi_write_at' */
+#endif
@@ -11,15 +11,24 @@
 /**************************************************************************************/
 
 #include <stdio.h>
+#include <time.h>
 #include <sys/time.h>
 #include "types.h"
 
 #define uSecScale 1.0e-6 /* Microsecond conversions */
+#define nSecScale 1.0e-9 /* Nanosecond conversions */
 
-double mrun(void) /** \return time in sec with microsecond resolution */
+double mrun(void) /** \return time in sec with nanosecond resolution if monotonic clock is available */
 {
+#ifdef CLOCK_MONOTONIC
+  /* monotonic clock is not affected by changes of the system time */
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return (((double)ts.tv_nsec) * nSecScale) + (double)ts.tv_sec;
+#else
   struct timeval tp;
   struct timezone tzp;
   gettimeofday(&tp,&tzp);
   return  (((double)tp.tv_usec) * uSecScale) + (double)tp.tv_sec;
+#endif
 } /* of 'mrun' */
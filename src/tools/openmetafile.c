@@ -497,7 +497,7 @@ FILE *openmetafile(Header *header,       /**< pointer to file header */
   free(path);
   name=fullname;
   /* open data file */
-  if((file=fopen(name,"rb"))==NULL  && isout)
+  if((file=openzfile(name))==NULL  && isout)
     printfopenerr(name);
   /* check file size of binary file */
   if(isout && file!=NULL)
@@ -5,7 +5,8 @@
 /**     C implementation of LPJmL                                                  \n**/
 /**                                                                                \n**/
 /**     Function opens restart file and seeks to first grid cell as                \n**/
-/**     specified in LPJ configuration                                             \n**/
+/**     specified in LPJ configuration. If buffer is not NULL, cell data of the    \n**/
+/**     task are read with one call and a memory stream is returned.               \n**/
 /**                                                                                \n**/
 /** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
 /** authors, and contributors see AUTHORS file                                     \n**/
@@ -20,14 +21,15 @@
 FILE *openrestart(const char *filename, /**< filename of restart file */
                   Config *config,       /**< LPJ configuration */
                   int ntotpft,          /**< Total number of PFTs */
-                  Bool *swap            /**< Byte order has to be changed */
+                  Bool *swap,           /**< Byte order has to be changed */
+                  char **buffer         /**< buffer for cell data of task or NULL */
                  )                      /** \return file pointer or NULL */
 {
   FILE *file;
   Header header;
   Restartheader restartheader;
   int offset,version,i;
-  long long offsetl;
+  long long offsetl,endl;
   char *type;
   /* Open file */
   file=fopen(filename,"rb");
@@ -191,6 +193,22 @@ FILE *openrestart(const char *filename, /**< filename of restart file */
   }
   /* read index from file */
   freadlong1(&offsetl,*swap,file);
+#ifndef _WIN32
+  if(buffer!=NULL)
+  {
+    /* get end of cell data of this task from index of next cell */
+    if(config->startgrid+config->ngridcell<header.firstcell+header.ncell)
+    {
+      fseek(file,(config->ngridcell-1)*sizeof(long long),SEEK_CUR);
+      freadlong1(&endl,*swap,file);
+    }
+    else
+    {
+      fseek(file,0,SEEK_END);
+      endl=ftell(file);
+    }
+  }
+#endif
   /* skip to index */
   if(fseek(file,offsetl,SEEK_SET))
   {
@@ -198,5 +216,31 @@ FILE *openrestart(const char *filename, /**< filename of restart file */
     fclose(file);
     return NULL;
   }
+#ifdef _WIN32
+  if(buffer!=NULL)
+    *buffer=NULL;
+#else
+  if(buffer!=NULL)
+  {
+    /* read cell data of this task with one call and read cells from memory */
+    *buffer=(endl>offsetl) ? malloc(endl-offsetl) : NULL;
+    if(*buffer==NULL)
+      return file; /* fall back to reading from file */
+    if(fread(*buffer,1,endl-offsetl,file)!=endl-offsetl)
+    {
+      fprintf(stderr,"ERROR156: Cannot read cell data in %s file '%s'.\n",type,filename);
+      free(*buffer);
+      fclose(file);
+      return NULL;
+    }
+    fclose(file);
+    file=fmemopen(*buffer,endl-offsetl,"rb");
+    if(file==NULL)
+    {
+      printallocerr("file");
+      free(*buffer);
+    }
+  }
+#endif
   return file;
 } /* of 'openrestart' */
@@ -21,16 +21,35 @@
 
 struct queue
 {
-  Real *data; /**< data array */
+  Real *data; /**< data array, elements are stored twice */
   int size;   /**< size of queue */
   int first;  /**< index of first element in queue */
+  Bool owner; /**< data array allocated by queue */
 }; /* definition of opaque datatype Queue */
 
+/*
+ * Elements i of the queue are stored at data[i] and data[i+size], so the
+ * queue can be accessed from data[first] without modulo operation. The
+ * data array is padded with QUEUE_BLOCK-1 zeros.
+ */
+
+#define datasize(size) (2*(size)+QUEUE_BLOCK-1)
+
+static Real *newdata(int size)
+{
+  Real *data;
+  int i;
+  data=newvec(Real,datasize(size));
+  if(data!=NULL)
+    for(i=0;i<datasize(size);i++)
+      data[i]=0;
+  return data;
+} /* of 'newdata' */
+
 Queue newqueue(int size /**< size of queue */
               )         /** \return pointer to queue or NULL on error */
 {
   Queue queue;
-  int i;
   /* size of queue must be >0 */
   if(size<1)
     return NULL;
@@ -38,20 +57,50 @@ Queue newqueue(int size /**< size of queue */
   queue=new(struct queue);
   if(queue==NULL)
     return NULL;
-  queue->data=newvec(Real,size);
+  /* initialize queue with zeros */
+  queue->data=newdata(size);
   if(queue->data==NULL)
   {
     free(queue);
     return NULL;
   }
-  /* initialize queue with zeros */
-  for(i=0;i<size;i++)
-    queue->data[i]=0;
   queue->size=size;
   queue->first=size-1;
+  queue->owner=TRUE;
   return queue;
 } /* of 'newqueue' */
 
+Real *packqueues(Queue queue[], /**< array of queues */
+                 int n          /**< size of array */
+                )               /** \return pointer to data of all queues or NULL on error */
+{
+  /*
+   * Function copies the data of all queues into one contiguous array.
+   * Data of each queue start at a multiple of QUEUE_BLOCK. The returned array
+   * has to be freed by the caller after the queues have been freed.
+   */
+  Real *data;
+  int i,j,size;
+  size=0;
+  for(i=0;i<n;i++)
+    size+=padqueuesize(datasize(queue[i]->size));
+  data=newvec(Real,max(size,1));
+  if(data==NULL)
+    return NULL;
+  size=0;
+  for(i=0;i<n;i++)
+  {
+    for(j=0;j<datasize(queue[i]->size);j++)
+      data[size+j]=queue[i]->data[j];
+    if(queue[i]->owner)
+      free(queue[i]->data);
+    queue[i]->data=data+size;
+    queue[i]->owner=FALSE;
+    size+=padqueuesize(datasize(queue[i]->size));
+  }
+  return data;
+} /* of 'packqueues' */
+
 Bool fwritequeue(FILE *file, /**< pointer to binary file */
                  const Queue queue /**< pointer to queue written */
                 )                  /** \return TRUE on error */
@@ -67,7 +116,7 @@ void fprintqueue(FILE *file,       /**< pointer to text file */
 {
   int i;
   for(i=0;i<queue->size;i++)
-    fprintf(file," %g",queue->data[(queue->first+i) % queue->size]);
+    fprintf(file," %g",queue->data[queue->first+i]);
 } /* of 'fprintqueue' */
 
 Queue freadqueue(FILE *file, /**< pointer to binary file */
@@ -75,6 +124,7 @@ Queue freadqueue(FILE *file, /**< pointer to binary file */
                 )            /** \return pointer to queue read or NULL */
 {
   Queue queue;
+  int i;
   queue=new(struct queue);
   if(queue==NULL)
   {
@@ -98,7 +148,7 @@ Queue freadqueue(FILE *file, /**< pointer to binary file */
     free(queue);
     return NULL;
   }
-  queue->data=newvec(Real,queue->size);
+  queue->data=newdata(queue->size);
   if(queue->data==NULL)
   {
     printallocerr("queue");
@@ -111,6 +161,9 @@ Queue freadqueue(FILE *file, /**< pointer to binary file */
     free(queue);
     return NULL;
   }
+  for(i=0;i<queue->size;i++)
+    queue->data[i+queue->size]=queue->data[i];
+  queue->owner=TRUE;
   return queue; 
 } /* of 'freadqueue' */
  
@@ -118,7 +171,7 @@ Real getqueue(const Queue queue, /**< pointer to queue */
               int i              /**< index of requested queue element */
              )                   /** \return first element in queue */
 {
-  return queue->data[(queue->first+i) % queue->size];
+  return queue->data[queue->first+i];
 } /* of 'getqueue' */
 
 int queuesize(const Queue queue /**< pointer to queue */
@@ -134,20 +187,46 @@ void putqueue(Queue queue, /**< pointer to queue */
   /*
    * move index of first element and store val there
    */
-  queue->first=(queue->first-1+queue->size) % queue->size;
-  queue->data[queue->first]=val;
+  queue->first=(queue->first==0) ? queue->size-1 : queue->first-1;
+  queue->data[queue->first]=queue->data[queue->first+queue->size]=val;
 } /* of 'putqueue' */
 
+Real convqueue(const Queue queue, /**< pointer to queue */
+               const Real coeff[] /**< coefficients, padded with zeros to padqueuesize(size) */
+              )                   /** \return sum of queue elements times coefficients */
+{
+  /*
+   * four independent partial sums allow the compiler to vectorize the loop
+   */
+  const Real *data;
+  Real sum[QUEUE_BLOCK];
+  int i,j;
+  for(j=0;j<QUEUE_BLOCK;j++)
+    sum[j]=0;
+  data=queue->data+queue->first;
+  for(i=0;i<queue->size;i+=QUEUE_BLOCK)
+    for(j=0;j<QUEUE_BLOCK;j++)
+      sum[j]+=data[i+j]*coeff[i+j];
+  for(j=1;j<QUEUE_BLOCK;j++)
+    sum[0]+=sum[j];
+  return sum[0];
+} /* of 'convqueue' */
+
 Real sumqueue(const Queue queue /**< pointer to queue */
              )                  /** \return total sum */
 {
-  int i;
-  Real sum;
-  sum=0;
-
-  for(i=0;i<queue->size;i++)
-    sum+=queue->data[i];
-  return sum;
+  Real sum[QUEUE_BLOCK];
+  int i,j;
+  for(j=0;j<QUEUE_BLOCK;j++)
+    sum[j]=0;
+  for(i=0;i+QUEUE_BLOCK<=queue->size;i+=QUEUE_BLOCK)
+    for(j=0;j<QUEUE_BLOCK;j++)
+      sum[j]+=queue->data[i+j];
+  for(;i<queue->size;i++)
+    sum[0]+=queue->data[i];
+  for(j=1;j<QUEUE_BLOCK;j++)
+    sum[0]+=sum[j];
+  return sum[0];
 } /* of 'sumqueue' */
 
 void freequeue(Queue queue /**< pointer to queue */
@@ -155,7 +234,8 @@ void freequeue(Queue queue /**< pointer to queue */
 {
   if(queue!=NULL)
   {
-    free(queue->data);
+    if(queue->owner)
+      free(queue->data);
     free(queue);
   }
 } /* of 'freequeue' */
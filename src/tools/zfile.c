@@ -0,0 +1,492 @@
+/**************************************************************************************/
+/**                                                                                \n**/
+/**                         z  f  i  l  e  .  c                                    \n**/
+/**                                                                                \n**/
+/**     Functions create and open block-compressed binary files. Data are          \n**/
+/**     compressed with zlib while written. Each block holds the header or         \n**/
+/**     one record of the output and can be byte-shuffled before compression.     \n**/
+/**     An index of the blocks is written at the end of the file followed by       \n**/
+/**     a trailer, so that single records can be read without decompressing       \n**/
+/**     the whole file. Files are accessed by stdio via fopencookie(), the         \n**/
+/**     returned FILE pointer can be used by fread(), fwrite() and fseek().        \n**/
+/**     Without -DUSE_ZLIB files are opened uncompressed by fopen().               \n**/
+/**                                                                                \n**/
+/**     File layout:                                                               \n**/
+/**                                                                                \n**/
+/**     block 0 ... block nblock-1                                                 \n**/
+/**     index: (int ulen, int clen) for each block                                 \n**/
+/**     trailer: Ztrailer                                                          \n**/
+/**                                                                                \n**/
+/** (C) Potsdam Institute for Climate Impact Research (PIK), see COPYRIGHT file    \n**/
+/** authors, and contributors see AUTHORS file                                     \n**/
+/** This file is part of LPJmL and licensed under GNU AGPL Version 3               \n**/
+/** or later. See LICENSE file or go to http://www.gnu.org/licenses/               \n**/
+/** Contact: https://github.com/PIK-LPJmL/LPJmL                                    \n**/
+/**                                                                                \n**/
+/**************************************************************************************/
+
+#define _GNU_SOURCE /* for fopencookie() */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+#include "types.h"
+#include "swap.h"
+
+#ifdef USE_ZLIB
+
+#define ZFILE_MAGIC "LPJZBLK"
+#define ZFILE_VERSION 1
+
+typedef struct
+{
+  long long nblock;      /**< number of blocks */
+  long long indexoffset; /**< offset of index in file */
+  long long headersize;  /**< size of unshuffled header block */
+  int typesize;          /**< size of datatype for shuffle, 1: no shuffle */
+  int version;           /**< version of file format */
+  char magic[8];         /**< magic string */
+} Ztrailer;
+
+typedef struct
+{
+  int ulen; /**< uncompressed size of block in bytes */
+  int clen; /**< compressed size of block in bytes */
+} Zindex;
+
+typedef struct
+{
+  FILE *file;         /**< underlying file */
+  int level;          /**< compression level */
+  int typesize;       /**< size of datatype for shuffle, 1: no shuffle */
+  size_t headersize;  /**< size of header block */
+  size_t blocksize;   /**< size of data blocks */
+  size_t len;         /**< number of bytes in buffer */
+  char *buffer;       /**< uncompressed block */
+  char *tmp;          /**< buffer for shuffled data */
+  Bytef *cbuffer;     /**< compressed block */
+  uLong csize;        /**< size of compressed buffer */
+  long long pos;      /**< uncompressed position */
+  Zindex *index;      /**< index of blocks */
+  long long nblock;   /**< number of blocks written */
+  long long maxblock; /**< size of index */
+  Bool iserror;       /**< write error occurred */
+} Zwriter;
+
+typedef struct
+{
+  FILE *file;         /**< underlying file */
+  int typesize;       /**< size of datatype for shuffle, 1: no shuffle */
+  long long headersize; /**< size of header block */
+  long long nblock;   /**< number of blocks */
+  Zindex *index;      /**< index of blocks */
+  long long *uoffset; /**< uncompressed offset of blocks */
+  long long *coffset; /**< compressed offset of blocks */
+  long long size;     /**< uncompressed size of file */
+  long long pos;      /**< current uncompressed position */
+  long long block;    /**< index of block in buffer, -1: none */
+  char *buffer;       /**< uncompressed block */
+  char *tmp;          /**< buffer for shuffled data */
+  Bytef *cbuffer;     /**< compressed block */
+} Zreader;
+
+static void shuffle(char *dst,const char *src,size_t len,int typesize)
+{
+  /* bytes of equal significance are grouped together */
+  size_t i,n;
+  int j;
+  n=len/typesize;
+  for(j=0;j<typesize;j++)
+    for(i=0;i<n;i++)
+      dst[j*n+i]=src[i*typesize+j];
+  memcpy(dst+n*typesize,src+n*typesize,len-n*typesize);
+} /* of 'shuffle' */
+
+static void unshuffle(char *dst,const char *src,size_t len,int typesize)
+{
+  size_t i,n;
+  int j;
+  n=len/typesize;
+  for(j=0;j<typesize;j++)
+    for(i=0;i<n;i++)
+      dst[i*typesize+j]=src[j*n+i];
+  memcpy(dst+n*typesize,src+n*typesize,len-n*typesize);
+} /* of 'unshuffle' */
+
+static Bool writeblock(Zwriter *z)
+{
+  uLongf clen;
+  Zindex *index;
+  const char *src;
+  if(z->len==0)
+    return FALSE;
+  if(z->typesize>1 && (z->nblock>0 || z->headersize==0))
+  {
+    shuffle(z->tmp,z->buffer,z->len,z->typesize);
+    src=z->tmp;
+  }
+  else
+    src=z->buffer;
+  clen=z->csize;
+  if(compress2(z->cbuffer,&clen,(const Bytef *)src,z->len,z->level)!=Z_OK)
+    return TRUE;
+  if(fwrite(z->cbuffer,1,clen,z->file)!=clen)
+    return TRUE;
+  if(z->nblock==z->maxblock)
+  {
+    z->maxblock=(z->maxblock==0) ? 1024 : 2*z->maxblock;
+    index=realloc(z->index,sizeof(Zindex)*z->maxblock);
+    if(index==NULL)
+      return TRUE;
+    z->index=index;
+  }
+  z->index[z->nblock].ulen=(int)z->len;
+  z->index[z->nblock].clen=(int)clen;
+  z->nblock++;
+  z->len=0;
+  return FALSE;
+} /* of 'writeblock' */
+
+static ssize_t zwrite(void *cookie,const char *buf,size_t size)
+{
+  Zwriter *z;
+  size_t n,count,blocksize;
+  z=cookie;
+  count=0;
+  while(count<size)
+  {
+    blocksize=(z->nblock==0 && z->headersize>0) ? z->headersize : z->blocksize;
+    n=blocksize-z->len;
+    if(n>size-count)
+      n=size-count;
+    memcpy(z->buffer+z->len,buf+count,n);
+    z->len+=n;
+    count+=n;
+    if(z->len==blocksize && writeblock(z))
+    {
+      z->iserror=TRUE;
+      errno=EIO;
+      return -1;
+    }
+  }
+  z->pos+=size;
+  return size;
+} /* of 'zwrite' */
+
+static int zwriteseek(void *cookie,off64_t *offset,int whence)
+{
+  Zwriter *z;
+  z=cookie;
+  /* only position query by ftell() is supported */
+  if(whence!=SEEK_CUR || *offset!=0)
+  {
+    errno=ESPIPE;
+    return -1;
+  }
+  *offset=z->pos;
+  return 0;
+} /* of 'zwriteseek' */
+
+static int zwriteclose(void *cookie)
+{
+  Zwriter *z;
+  Ztrailer trailer;
+  Bool rc;
+  z=cookie;
+  rc=z->iserror || writeblock(z);
+  if(!rc)
+  {
+    trailer.indexoffset=ftell(z->file);
+    trailer.nblock=z->nblock;
+    trailer.headersize=z->headersize;
+    trailer.typesize=z->typesize;
+    trailer.version=ZFILE_VERSION;
+    memcpy(trailer.magic,ZFILE_MAGIC,sizeof(trailer.magic));
+    if(z->nblock>0 && fwrite(z->index,sizeof(Zindex),z->nblock,z->file)!=z->nblock)
+      rc=TRUE;
+    else if(fwrite(&trailer,sizeof(trailer),1,z->file)!=1)
+      rc=TRUE;
+  }
+  if(fclose(z->file))
+    rc=TRUE;
+  free(z->buffer);
+  free(z->tmp);
+  free(z->cbuffer);
+  free(z->index);
+  free(z);
+  return (rc) ? -1 : 0;
+} /* of 'zwriteclose' */
+
+static Bool readblock(Zreader *z,long long block)
+{
+  uLongf ulen;
+  char *dst;
+  if(z->block==block)
+    return FALSE;
+  if(fseek(z->file,z->coffset[block],SEEK_SET))
+    return TRUE;
+  if(fread(z->cbuffer,1,z->index[block].clen,z->file)!=z->index[block].clen)
+    return TRUE;
+  dst=(z->typesize>1 && (block>0 || z->headersize==0)) ? z->tmp : z->buffer;
+  ulen=z->index[block].ulen;
+  if(uncompress((Bytef *)dst,&ulen,z->cbuffer,z->index[block].clen)!=Z_OK || ulen!=z->index[block].ulen)
+  {
+    z->block=-1;
+    return TRUE;
+  }
+  if(dst==z->tmp)
+    unshuffle(z->buffer,z->tmp,ulen,z->typesize);
+  z->block=block;
+  return FALSE;
+} /* of 'readblock' */
+
+static long long findblock(const Zreader *z,long long pos)
+{
+  /* binary search for block containing position */
+  long long lo,hi,mid;
+  lo=0;
+  hi=z->nblock-1;
+  while(lo<hi)
+  {
+    mid=(lo+hi+1)/2;
+    if(z->uoffset[mid]<=pos)
+      lo=mid;
+    else
+      hi=mid-1;
+  }
+  return lo;
+} /* of 'findblock' */
+
+static ssize_t zread(void *cookie,char *buf,size_t size)
+{
+  Zreader *z;
+  long long block;
+  size_t n,count;
+  z=cookie;
+  count=0;
+  while(count<size && z->pos<z->size)
+  {
+    block=findblock(z,z->pos);
+    if(readblock(z,block))
+    {
+      errno=EIO;
+      return (count>0) ? (ssize_t)count : -1;
+    }
+    n=z->uoffset[block]+z->index[block].ulen-z->pos;
+    if(n>size-count)
+      n=size-count;
+    memcpy(buf+count,z->buffer+(z->pos-z->uoffset[block]),n);
+    count+=n;
+    z->pos+=n;
+  }
+  return count;
+} /* of 'zread' */
+
+static int zreadseek(void *cookie,off64_t *offset,int whence)
+{
+  Zreader *z;
+  long long pos;
+  z=cookie;
+  switch(whence)
+  {
+    case SEEK_SET:
+      pos=*offset;
+      break;
+    case SEEK_CUR:
+      pos=z->pos+*offset;
+      break;
+    case SEEK_END:
+      pos=z->size+*offset;
+      break;
+    default:
+      errno=EINVAL;
+      return -1;
+  }
+  if(pos<0)
+  {
+    errno=EINVAL;
+    return -1;
+  }
+  z->pos=pos;
+  *offset=pos;
+  return 0;
+} /* of 'zreadseek' */
+
+static int zreadclose(void *cookie)
+{
+  Zreader *z;
+  int rc;
+  z=cookie;
+  rc=fclose(z->file);
+  free(z->index);
+  free(z->uoffset);
+  free(z->coffset);
+  free(z->buffer);
+  free(z->tmp);
+  free(z->cbuffer);
+  free(z);
+  return rc;
+} /* of 'zreadclose' */
+
+#endif
+
+FILE *createzfile(const char *filename, /**< filename */
+                  size_t headersize,    /**< size of header in bytes, written in separate block */
+                  size_t blocksize,     /**< size of one record in bytes */
+                  int typesize,         /**< size of datatype for byte shuffle (1: no shuffle) */
+                  int level             /**< compression level (1-9, 0: no compression) */
+                 )                      /** \return file pointer or NULL on error */
+{
+#ifdef USE_ZLIB
+  cookie_io_functions_t io={NULL,zwrite,zwriteseek,zwriteclose};
+  Zwriter *z;
+  size_t maxsize;
+  FILE *file;
+  if(level==0 || blocksize==0)
+    return fopen(filename,"wb");
+  z=calloc(1,sizeof(Zwriter));
+  if(z==NULL)
+    return NULL;
+  z->file=fopen(filename,"wb");
+  if(z->file==NULL)
+  {
+    free(z);
+    return NULL;
+  }
+  z->level=level;
+  z->typesize=(typesize<1) ? 1 : typesize;
+  z->headersize=headersize;
+  z->blocksize=blocksize;
+  maxsize=(headersize>blocksize) ? headersize : blocksize;
+  z->csize=compressBound(maxsize);
+  z->buffer=malloc(maxsize);
+  z->tmp=malloc(maxsize);
+  z->cbuffer=malloc(z->csize);
+  if(z->buffer==NULL || z->tmp==NULL || z->cbuffer==NULL)
+  {
+    fclose(z->file);
+    free(z->buffer);
+    free(z->tmp);
+    free(z->cbuffer);
+    free(z);
+    return NULL;
+  }
+  file=fopencookie(z,"wb",io);
+  if(file==NULL)
+  {
+    fclose(z->file);
+    free(z->buffer);
+    free(z->tmp);
+    free(z->cbuffer);
+    free(z);
+  }
+  return file;
+#else
+  return fopen(filename,"wb");
+#endif
+} /* of 'createzfile' */
+
+FILE *openzfile(const char *filename /**< filename */
+               )                     /** \return file pointer or NULL on error */
+{
+  FILE *file;
+#ifdef USE_ZLIB
+  cookie_io_functions_t io={zread,NULL,zreadseek,zreadclose};
+  Ztrailer trailer;
+  Zreader *z;
+  Bool swap;
+  long long i;
+  int maxsize;
+  unsigned char magic[2];
+  file=fopen(filename,"rb");
+  if(file==NULL)
+    return NULL;
+  /* first block starts with a zlib header: deflate method and header
+     divisible by 31, otherwise file is returned unchanged without
+     probing for the trailer */
+  if(fread(magic,1,2,file)!=2 || (magic[0] & 0xf)!=Z_DEFLATED || ((magic[0]<<8)+magic[1]) % 31)
+  {
+    rewind(file);
+    return file;
+  }
+  /* check for trailer of compressed file, otherwise file is returned unchanged */
+  if(fseek(file,-(long)sizeof(trailer),SEEK_END) ||
+     fread(&trailer,sizeof(trailer),1,file)!=1 ||
+     strncmp(trailer.magic,ZFILE_MAGIC,sizeof(trailer.magic)))
+  {
+    rewind(file);
+    return file;
+  }
+  swap=(trailer.version!=ZFILE_VERSION);
+  if(swap)
+  {
+    trailer.version=swapint(trailer.version);
+    trailer.typesize=swapint(trailer.typesize);
+    trailer.nblock=swaplong(trailer.nblock);
+    trailer.indexoffset=swaplong(trailer.indexoffset);
+    trailer.headersize=swaplong(trailer.headersize);
+  }
+  if(trailer.version!=ZFILE_VERSION || trailer.nblock<0 || trailer.typesize<1)
+  {
+    fclose(file);
+    errno=EINVAL;
+    return NULL;
+  }
+  z=calloc(1,sizeof(Zreader));
+  if(z==NULL)
+  {
+    fclose(file);
+    return NULL;
+  }
+  z->file=file;
+  z->typesize=trailer.typesize;
+  z->headersize=trailer.headersize;
+  z->nblock=trailer.nblock;
+  z->block=-1;
+  z->index=malloc(sizeof(Zindex)*(trailer.nblock+1));
+  z->uoffset=malloc(sizeof(long long)*(trailer.nblock+1));
+  z->coffset=malloc(sizeof(long long)*(trailer.nblock+1));
+  if(z->index==NULL || z->uoffset==NULL || z->coffset==NULL ||
+     fseek(file,trailer.indexoffset,SEEK_SET) ||
+     fread(z->index,sizeof(Zindex),trailer.nblock,file)!=trailer.nblock)
+  {
+    zreadclose(z);
+    errno=EINVAL;
+    return NULL;
+  }
+  maxsize=1;
+  z->uoffset[0]=z->coffset[0]=0;
+  for(i=0;i<z->nblock;i++)
+  {
+    if(swap)
+    {
+      z->index[i].ulen=swapint(z->index[i].ulen);
+      z->index[i].clen=swapint(z->index[i].clen);
+    }
+    if(z->index[i].ulen>maxsize)
+      maxsize=z->index[i].ulen;
+    z->uoffset[i+1]=z->uoffset[i]+z->index[i].ulen;
+    z->coffset[i+1]=z->coffset[i]+z->index[i].clen;
+  }
+  z->size=z->uoffset[z->nblock];
+  z->buffer=malloc(maxsize);
+  z->tmp=malloc(maxsize);
+  z->cbuffer=malloc(compressBound(maxsize));
+  if(z->buffer==NULL || z->tmp==NULL || z->cbuffer==NULL)
+  {
+    zreadclose(z);
+    return NULL;
+  }
+  file=fopencookie(z,"rb",io);
+  if(file==NULL)
+    zreadclose(z);
+  return file;
+#else
+  file=fopen(filename,"rb");
+  return file;
+#endif
+} /* of 'openzfile' */
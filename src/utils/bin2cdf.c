@@ -1022,7 +1022,7 @@ int main(int argc,char **argv)
   }
   else
   {
-    file=fopen(argv[iarg+2],"rb");
+    file=openzfile(argv[iarg+2]);
     if(file==NULL)
     {
       fprintf(stderr,"Error opening '%s': %s.\n",argv[iarg+2],strerror(errno));
@@ -153,7 +153,7 @@ int main(int argc,char **argv)
   }
   if(!ismeta)
   {
-    file=fopen(argv[iarg],"rb");
+    file=openzfile(argv[iarg]);
     if(file==NULL)
     {
       fprintf(stderr,"Error opening '%s': %s.\n",argv[iarg],strerror(errno));
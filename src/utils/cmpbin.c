@@ -130,13 +130,13 @@ int main(int argc,char **argv)
   }
   else
   {
-    file1=fopen(argv[iarg],"rb");
+    file1=openzfile(argv[iarg]);
     if(file1==NULL)
     {
       fprintf(stderr,"Error opening '%s': %s\n",argv[iarg],strerror(errno));
       return EXIT_FAILURE;
     }
-    file2=fopen(argv[iarg+1],"rb");
+    file2=openzfile(argv[iarg+1]);
     if(file2==NULL)
     {
       fprintf(stderr,"Error opening '%s': %s\n",argv[iarg+1],strerror(errno));
@@ -22,26 +22,145 @@
 #define LANDUSE_NBANDS 64
 #define FERTILIZER_NBANDS 32
 
-static Bool readsocket(Socket *socket,int day,int sizes[],int count[],Type type[])
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <stdatomic.h>
+#endif
+
+static Shmheader *shm=NULL; /* shared memory segment created by LPJmL or NULL */
+static int coupler_version; /* protocol version sent by LPJmL */
+
+static Bool receive_token(Socket *socket,Token *token,int *index)
+{
+  /* receive token and map shared memory if PUT_SHM token was sent by LPJmL */
+  char *name;
+  int fd,status;
+  if(receive_token_coupler(socket,token,index,coupler_version))
+    return TRUE;
+  if(*token!=PUT_SHM)
+    return FALSE;
+  name=readstring_socket(socket);
+  if(name==NULL)
+    return TRUE;
+  status=COUPLER_ERR;
+#ifndef _WIN32
+  fd=shm_open(name,O_RDWR,S_IRUSR | S_IWUSR);
+  if(fd!=-1)
+  {
+    shm=mmap(NULL,SHM_HEADER_SIZE+*index,PROT_READ | PROT_WRITE,MAP_SHARED,fd,0);
+    close(fd);
+    if(shm==MAP_FAILED)
+      shm=NULL;
+    else
+    {
+      status=COUPLER_OK;
+      printf("Sending input via shared memory '%s' of %d bytes.\n",name,*index);
+    }
+  }
+#endif
+  free(name);
+  writeint_socket(socket,&status,1);
+  return receive_token_coupler(socket,token,index,coupler_version);
+} /* of 'receive_token' */
+
+static void writedata(Socket *socket,const float *data,int n)
+{
+  /* send data via shared memory if available, only offset is sent via socket */
+  int offset;
+  if(shm==NULL)
+  {
+    writefloat_socket(socket,data,n);
+    return;
+  }
+  offset=(shm->tail+7)/8*8;
+  if(offset+n*(int)sizeof(float)>shm->size)
+    offset=0;
+  memcpy((char *)shm+SHM_HEADER_SIZE+offset,data,n*sizeof(float));
+#ifndef _WIN32
+  atomic_thread_fence(memory_order_seq_cst);
+#endif
+  writeint_socket(socket,&offset,1);
+} /* of 'writedata' */
+
+static Bool readbatch(Socket *socket,int day,int n,int sizes[],int count[])
+{
+  int year,step;
+  int i,j,k;
+  int *index,*size;
+  float *data;
+  readint_socket(socket,&year,1);
+  readint_socket(socket,&step,1); /* batched output requires version 5 */
+  /* read index table of frame */
+  index=newvec(int,n);
+  check(index);
+  size=newvec(int,n);
+  check(size);
+  readint_socket(socket,index,n);
+  readint_socket(socket,size,n);
+  for(i=0;i<n;i++)
+  {
+    if(index[i]<0 || index[i]>=NOUT || count[index[i]]<0)
+    {
+      fprintf(stderr,"Invalid index %d of output in frame.\n",index[i]);
+      free(index);
+      free(size);
+      return TRUE;
+    }
+    if(size[i]!=count[index[i]]*sizes[index[i]])
+    {
+      fprintf(stderr,"Invalid size %d of output %d in frame, must be %d.\n",
+              size[i],index[i],count[index[i]]*sizes[index[i]]);
+      free(index);
+      free(size);
+      return TRUE;
+    }
+  }
+  /* read data of all outputs */
+  for(i=0;i<n;i++)
+  {
+    data=newvec(float,sizes[index[i]]);
+    check(data);
+    for(j=0;j<count[index[i]];j++)
+    {
+      readfloat_socket(socket,data,sizes[index[i]]);
+      printf("%d/%d %d[%d]:",day,year,index[i],j);
+      for(k=0;k<sizes[index[i]];k++)
+        printf(" %g",data[k]);
+      printf("\n");
+    }
+    free(data);
+  }
+  free(index);
+  free(size);
+  return FALSE;
+} /* of 'readbatch' */
+
+static Bool readsocket(Socket *socket,int day,int *n,int sizes[],int count[],Type type[])
 {
   Token token;
   int index;
-  int year;
-#if COUPLER_VERSION == 4
-  int step;
-#endif
+  int year,step;
   int j,k;
   float *data;
   short *sdata;
-  if(receive_token_coupler(socket,&token,&index))
+  if(receive_token(socket,&token,&index))
     return TRUE;
   if(token==END_DATA)
     return TRUE;
+  if(token==PUT_DATA_BATCH)
+  {
+    /* frame with several outputs received */
+    *n=index;
+    return readbatch(socket,day,index,sizes,count);
+  }
   if(token!=PUT_DATA)
   {
     fprintf(stderr,"Token for output data=%s is not PUT_DATA.\n",token_names[token]);
     return TRUE;
   }
+  *n=1;
   if(index<0 || index>=NOUT)
   {
     fprintf(stderr,"Invalid index %d of output, must be [0,%d],\n",index,NOUT-1);
@@ -53,9 +172,8 @@ static Bool readsocket(Socket *socket,int day,int sizes[],int count[],Type type[
     return TRUE;
   }
   readint_socket(socket,&year,1);
-#if COUPLER_VERSION == 4
-  readint_socket(socket,&step,1);
-#endif
+  if(coupler_version>=4)
+    readint_socket(socket,&step,1);
   if(sizes[index]==0)
   {
     data=newvec(float,count[index]);
@@ -105,26 +223,26 @@ static Bool readyeardata(Socket *socket,int nday_out,int nmonth_out,int n_out,in
 {
   int month;
   int day,dayofyear;
-  int i;
+  int i,n;
   dayofyear=1;
   for(month=0;month<12;month++)
   {
     /* read daily data */
     for(day=0;day<ndaymonth[month];day++)
     {
-      for(i=0;i<nday_out;i++)
-        if(readsocket(socket,dayofyear,sizes,counts,type))
+      for(i=0;i<nday_out;i+=n)
+        if(readsocket(socket,dayofyear,&n,sizes,counts,type))
           return TRUE;
       dayofyear++;
     }
     /* read monthly data */
-    for(i=0;i<nmonth_out;i++)
-      if(readsocket(socket,dayofyear-1,sizes,counts,type))
+    for(i=0;i<nmonth_out;i+=n)
+      if(readsocket(socket,dayofyear-1,&n,sizes,counts,type))
         return TRUE;
   }
   /* read annual data */
-  for(i=0;i<n_out-nday_out-nmonth_out;i++)
-    if(readsocket(socket,NDAYYEAR,sizes,counts,type))
+  for(i=0;i<n_out-nday_out-nmonth_out;i+=n)
+    if(readsocket(socket,NDAYYEAR,&n,sizes,counts,type))
       return TRUE;
   return FALSE;
 } /* of 'readyeardata' */
@@ -146,11 +264,9 @@ int main(int argc,char **argv)
   Type type[NOUT];
   int sizes_in[N_IN];
   Type type_in[N_IN];
-#if COUPLER_VERSION == 4
   Type datatype;
   int ncell_in;
   int status;
-#endif
   int port;
   int nmonth_out;
   int nday_out;
@@ -239,30 +355,32 @@ int main(int argc,char **argv)
   else
     printf("Waiting for LPJmL model...\n");
   /* Establish the connection */
-  socket=connect_coupler(port,wait);
+  socket=connect_coupler(port,wait,&coupler_version);
   if(socket==NULL)
     return EXIT_FAILURE;
-#if COUPLER_VERSION == 4
-  if(receive_token_coupler(socket,&token,&index))
-  {
-    close_socket(socket);
-    return EXIT_FAILURE;
-  }
-  if(token!=PUT_INIT_DATA)
+  printf("Coupler version: %d\n",coupler_version);
+  if(coupler_version>=4)
   {
-    fprintf(stderr,"Unexpected token %s received, must be PUT_INIT_DATA.\n",
-            token_names[token]);
-    close_socket(socket);
-    return EXIT_FAILURE;
+    if(receive_token(socket,&token,&index))
+    {
+      close_socket(socket);
+      return EXIT_FAILURE;
+    }
+    if(token!=PUT_INIT_DATA)
+    {
+      fprintf(stderr,"Unexpected token %s received, must be PUT_INIT_DATA.\n",
+              token_names[token]);
+      close_socket(socket);
+      return EXIT_FAILURE;
+    }
+    readint_socket(socket,(int *)&datatype,1);
+    readint_socket(socket,&firstgrid,1);
+    readint_socket(socket,&ncell_in,1);
+    printf("Index of first cell: %d\n",firstgrid);
+    printf("Total number of cells: %d\n",ncell_in);
   }
-  readint_socket(socket,(int *)&datatype,1);
-  readint_socket(socket,&firstgrid,1);
-  readint_socket(socket,&ncell_in,1);
-  printf("Index of first cell: %d\n",firstgrid);
-  printf("Total number of cells: %d\n",ncell_in);
-#else
-  firstgrid=0;
-#endif
+  else
+    firstgrid=0;
   readint_socket(socket,&ncell,1);
   printf("Number of cells: %d\n",ncell);
   readint_socket(socket,&n_in,1);
@@ -274,7 +392,7 @@ int main(int argc,char **argv)
   landuse=fertilizer=NULL;
   for(i=0;i<n_in;i++)
   {
-    if(receive_token_coupler(socket,&token,&index))
+    if(receive_token(socket,&token,&index))
     {
       close_socket(socket);
       return EXIT_FAILURE;
@@ -293,11 +411,10 @@ int main(int argc,char **argv)
       return EXIT_FAILURE;
     }
     readint_socket(socket,(int *)(type_in+index),1);
-#if COUPLER_VERSION == 4
-    readint_socket(socket,sizes_in+index,1);
-#else
-    sizes_in[index]=ncell;
-#endif
+    if(coupler_version>=4)
+      readint_socket(socket,sizes_in+index,1);
+    else
+      sizes_in[index]=ncell;
     switch(index)
     {
       case LANDUSE_DATA:
@@ -353,7 +470,7 @@ int main(int argc,char **argv)
   n_err=0;
   for(i=0;i<n_out;i++)
   {
-    if(receive_token_coupler(socket,&token,&index))
+    if(receive_token(socket,&token,&index))
     {
       close_socket(socket);
       return EXIT_FAILURE;
@@ -373,9 +490,8 @@ int main(int argc,char **argv)
     if(index<0 || index>=NOUT)
     {
       fprintf(stderr,"Invalid index %d of output, must be in [0,%d].\n",index,NOUT-1);
-#if COUPLER_VERSION == 4
-      readint_socket(socket,&index,1);
-#endif
+      if(coupler_version>=4)
+        readint_socket(socket,&index,1);
       readint_socket(socket,&index,1);
       readint_socket(socket,&index,1);
       readint_socket(socket,&index,1);
@@ -384,15 +500,13 @@ int main(int argc,char **argv)
       n_err++;
       continue;
     }
-#if COUPLER_VERSION == 4
-    /* get number of cells per year for output */
-    readint_socket(socket,sizes+index,1);
-#else
-    if(index==GLOBALFLUX)
+    if(coupler_version>=4)
+      /* get number of cells per year for output */
+      readint_socket(socket,sizes+index,1);
+    else if(index==GLOBALFLUX)
       sizes[index]=0;
     else
       sizes[index]=ncell;
-#endif
     /* get number of steps per year for output */
     readint_socket(socket,nstep+index,1);
     /* get number of bands for output */
@@ -422,7 +536,7 @@ int main(int argc,char **argv)
       }
     writeint_socket(socket,&index,1);
   }
-  if(receive_token_coupler(socket,&token,&index))
+  if(receive_token(socket,&token,&index))
   {
     close_socket(socket);
     return EXIT_FAILURE;
@@ -457,7 +571,7 @@ int main(int argc,char **argv)
   fcoords=NULL;
   for(i=0;i<n_out_1;i++)
   {
-    if(receive_token_coupler(socket,&token,&index))
+    if(receive_token(socket,&token,&index))
     {
       close_socket(socket);
       return EXIT_FAILURE;
@@ -508,7 +622,7 @@ int main(int argc,char **argv)
     /* send input to LPJmL */
     for(i=0;i<n_in;i++)
     {
-      if(receive_token_coupler(socket,&token,&index))
+      if(receive_token(socket,&token,&index))
       {
         close_socket(socket);
         return EXIT_FAILURE;
@@ -525,13 +639,13 @@ int main(int argc,char **argv)
       if(index<0 || index>=N_IN)
       {
         fprintf(stderr,"Invalid index %d of input.\n",index);
-#if COUPLER_VERSION == 4
+        if(coupler_version<4)
+        {
+          close_socket(socket);
+          return EXIT_FAILURE;
+        }
         status=COUPLER_ERR;
         writeint_socket(socket,&status,1);
-#else
-        close_socket(socket);
-        return EXIT_FAILURE;
-#endif
       }
       else
       switch(index)
@@ -545,20 +659,21 @@ int main(int argc,char **argv)
           if(readfloatvec(file,landuse,header.scalar,sizes_in[index]*header.nbands,swap,header.datatype))
           {
             fprintf(stderr,"Error reading landuse file '%s': %s.\n",filename,strerror(errno));
-#if COUPLER_VERSION == 4
+            if(coupler_version<4)
+            {
+              close_socket(socket);
+              return EXIT_FAILURE;
+            }
             status=COUPLER_ERR;
             writeint_socket(socket,&status,1);
-#else
-            close_socket(socket);
-            return EXIT_FAILURE;
-#endif
           }
           else
           {
-#if COUPLER_VERSION == 4
-            status=COUPLER_OK;
-            writeint_socket(socket,&status,1);
-#endif
+            if(coupler_version>=4)
+            {
+              status=COUPLER_OK;
+              writeint_socket(socket,&status,1);
+            }
 #ifdef DEBUG
             for(i=0;i<sizes_in[index];i++)
             {
@@ -568,35 +683,37 @@ int main(int argc,char **argv)
               printf("\n");
             }
 #endif
-            writefloat_socket(socket,landuse,sizes_in[index]*header.nbands);
+            writedata(socket,landuse,sizes_in[index]*header.nbands);
           }
           break;
         case FERTILIZER_DATA:
           for(j=0;j<sizes_in[index]*FERTILIZER_NBANDS;j++)
             fertilizer[j]=1;
-#if COUPLER_VERSION == 4
-          status=COUPLER_OK;
-          writeint_socket(socket,&status,1);
-#endif
-          writefloat_socket(socket,fertilizer,sizes_in[index]*FERTILIZER_NBANDS);
+          if(coupler_version>=4)
+          {
+            status=COUPLER_OK;
+            writeint_socket(socket,&status,1);
+          }
+          writedata(socket,fertilizer,sizes_in[index]*FERTILIZER_NBANDS);
           break;
         case CO2_DATA:
           co2=288.0;
-#if COUPLER_VERSION == 4
-          status=COUPLER_OK;
-          writeint_socket(socket,&status,1);
-#endif
+          if(coupler_version>=4)
+          {
+            status=COUPLER_OK;
+            writeint_socket(socket,&status,1);
+          }
           writefloat_socket(socket,&co2,1);
           break;
         default:
           fprintf(stderr,"Unsupported index %d of input.\n",index);
-#if COUPLER_VERSION == 4
+          if(coupler_version<4)
+          {
+            close_socket(socket);
+            return EXIT_FAILURE;
+          }
           status=COUPLER_ERR;
           writeint_socket(socket,&status,1);
-#else
-          close_socket(socket);
-          return EXIT_FAILURE;
-#endif
       }
     }
     if(token==END_DATA) /* Did we receive end token? */
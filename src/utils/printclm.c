@@ -72,7 +72,7 @@ static void printclm(const char *filename,int output,int nbands,int version,
     unit=NULL;
     standard_name=NULL;
     long_name=NULL;
-    file=fopen(filename,"rb");
+    file=openzfile(filename);
     if(file==NULL)
     {
       fprintf(stderr,"Error opening '%s': %s.\n",filename,strerror(errno));